@@ -0,0 +1,165 @@
+# - Find Zstd (zstd.h, zdict.h, libzstd.a, libzstd.so, libzstd.lib, libzstd.dll)
+# This module defines
+#  Zstd_INCLUDE_DIR, directory containing headers
+#  Zstd_LIBRARY_DIR, directory containing zstd libraries
+#  Zstd_SHARED_LIBS, path to libzstd.so/libzstd.lib
+#  Zstd_STATIC_LIBS, path to libzstd.a/libzstd_static.lib
+#  Zstd_SHARED_LIB_RESOURCES, shared libraries required to use Zstd, i.e. libzstd.so/libzstd.dll
+#  Zstd_FOUND, whether zstd has been found
+
+if ("${ZSTD_ROOT}" STREQUAL "")
+  set(ZSTD_ROOT "$ENV{ZSTD_ROOT}")
+  if (NOT "${ZSTD_ROOT}" STREQUAL "")
+    string(REPLACE "\"" "" ZSTD_ROOT ${ZSTD_ROOT})
+  endif()
+endif()
+
+if (NOT "${ZSTD_ROOT}" STREQUAL "")
+  set(ZSTD_SEARCH_HEADER_PATHS
+    ${ZSTD_ROOT}
+    ${ZSTD_ROOT}/include
+    ${ZSTD_ROOT}/lib
+  )
+
+  set(ZSTD_SEARCH_LIB_PATHS
+    ${ZSTD_ROOT}
+    ${ZSTD_ROOT}/lib
+    ${ZSTD_ROOT}/build/cmake/lib
+  )
+elseif (NOT MSVC)
+  set(ZSTD_SEARCH_HEADER_PATHS
+      "/usr/include"
+      "/usr/include/x86_64-linux-gnu"
+  )
+
+  set(ZSTD_SEARCH_LIB_PATHS
+      "/lib"
+      "/lib/x86_64-linux-gnu"
+      "/usr/lib"
+      "/usr/lib/x86_64-linux-gnu"
+  )
+endif()
+
+find_path(Zstd_INCLUDE_DIR_ZSTD
+  zstd.h
+  PATHS ${ZSTD_SEARCH_HEADER_PATHS}
+  NO_DEFAULT_PATH # make sure we don't accidentally pick up a different version
+)
+find_path(Zstd_INCLUDE_DIR_ZDICT
+  zdict.h
+  PATHS ${ZSTD_SEARCH_HEADER_PATHS}
+  NO_DEFAULT_PATH # make sure we don't accidentally pick up a different version
+)
+
+include(Utils)
+
+# set options for: shared
+if (MSVC)
+  set(Zstd_LIBRARY_PREFIX "")
+  set(Zstd_LIBRARY_SUFFIX ".lib")
+elseif(APPLE)
+  set(Zstd_LIBRARY_PREFIX "lib")
+  set(Zstd_LIBRARY_SUFFIX ".dylib")
+else()
+  set(Zstd_LIBRARY_PREFIX "lib")
+  set(Zstd_LIBRARY_SUFFIX ".so")
+endif()
+set_find_library_options("${Zstd_LIBRARY_PREFIX}" "${Zstd_LIBRARY_SUFFIX}")
+
+# find library
+find_library(Zstd_SHARED_LIB
+  NAMES zstd
+  PATHS ${ZSTD_SEARCH_LIB_PATHS}
+  NO_DEFAULT_PATH
+)
+
+# restore initial options
+restore_find_library_options()
+
+
+# set options for: static
+if (MSVC)
+  set(Zstd_LIBRARY_PREFIX "")
+  set(Zstd_LIBRARY_SUFFIX ".lib")
+else()
+  set(Zstd_LIBRARY_PREFIX "lib")
+  set(Zstd_LIBRARY_SUFFIX ".a")
+endif()
+set_find_library_options("${Zstd_LIBRARY_PREFIX}" "${Zstd_LIBRARY_SUFFIX}")
+
+# find library
+find_library(Zstd_STATIC_LIB
+  NAMES zstd zstd_static
+  PATHS ${ZSTD_SEARCH_LIB_PATHS}
+  NO_DEFAULT_PATH
+)
+
+# restore initial options
+restore_find_library_options()
+
+
+if (Zstd_INCLUDE_DIR_ZSTD AND Zstd_INCLUDE_DIR_ZDICT AND Zstd_SHARED_LIB AND Zstd_STATIC_LIB)
+  set(Zstd_FOUND TRUE)
+  list(APPEND Zstd_INCLUDE_DIR ${Zstd_INCLUDE_DIR_ZSTD} ${Zstd_INCLUDE_DIR_ZDICT})
+  list(REMOVE_DUPLICATES Zstd_INCLUDE_DIR)
+  list(APPEND Zstd_SHARED_LIBS ${Zstd_SHARED_LIB})
+  list(APPEND Zstd_STATIC_LIBS ${Zstd_STATIC_LIB})
+
+  set(Zstd_LIBRARY_DIR
+    "${ZSTD_SEARCH_LIB_PATHS}"
+    CACHE PATH
+    "Directory containing zstd libraries"
+    FORCE
+  )
+
+  # build a list of shared libraries (staticRT)
+  foreach(ELEMENT ${Zstd_SHARED_LIBS})
+    get_filename_component(ELEMENT_FILENAME ${ELEMENT} NAME)
+    string(REGEX MATCH "^(.*)\\.(lib|so|dylib)$" ELEMENT_MATCHES ${ELEMENT_FILENAME})
+
+    if(NOT ELEMENT_MATCHES)
+      continue()
+    endif()
+
+    get_filename_component(ELEMENT_DIRECTORY ${ELEMENT} DIRECTORY)
+    file(GLOB ELEMENT_LIB
+      "${ELEMENT_DIRECTORY}/${CMAKE_MATCH_1}.dll"
+      "${ELEMENT_DIRECTORY}/${CMAKE_MATCH_1}.so*"
+      "${ELEMENT_DIRECTORY}/${CMAKE_MATCH_1}.*.dylib"
+    )
+
+    if(ELEMENT_LIB)
+      list(APPEND Zstd_SHARED_LIB_RESOURCES ${ELEMENT_LIB})
+    endif()
+  endforeach()
+else ()
+  set(Zstd_FOUND FALSE)
+endif()
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(Zstd
+  DEFAULT_MSG
+  Zstd_INCLUDE_DIR
+  Zstd_SHARED_LIBS
+  Zstd_STATIC_LIBS
+  Zstd_INCLUDE_DIR_ZSTD
+  Zstd_INCLUDE_DIR_ZDICT
+  Zstd_SHARED_LIB
+  Zstd_STATIC_LIB
+)
+message("Zstd_INCLUDE_DIR: " ${Zstd_INCLUDE_DIR})
+message("Zstd_LIBRARY_DIR: " ${Zstd_LIBRARY_DIR})
+message("Zstd_SHARED_LIBS: " ${Zstd_SHARED_LIBS})
+message("Zstd_STATIC_LIBS: " ${Zstd_STATIC_LIBS})
+message("Zstd_SHARED_LIB_RESOURCES: " ${Zstd_SHARED_LIB_RESOURCES})
+
+mark_as_advanced(
+  Zstd_INCLUDE_DIR
+  Zstd_LIBRARY_DIR
+  Zstd_SHARED_LIBS
+  Zstd_STATIC_LIBS
+  Zstd_INCLUDE_DIR_ZSTD
+  Zstd_INCLUDE_DIR_ZDICT
+  Zstd_SHARED_LIB
+  Zstd_STATIC_LIB
+)
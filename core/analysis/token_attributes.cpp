@@ -53,6 +53,7 @@ REGISTER_ATTRIBUTE(term_attribute);
 REGISTER_ATTRIBUTE(payload);
 REGISTER_ATTRIBUTE(document);
 REGISTER_ATTRIBUTE(frequency);
+REGISTER_ATTRIBUTE(frequency_bound);
 REGISTER_ATTRIBUTE(iresearch::granularity_prefix);
 
 // -----------------------------------------------------------------------------
@@ -97,8 +98,12 @@ bool norm::reset(const sub_reader& reader, field_id column, const document& doc)
 }
 
 float_t norm::read() const {
+  return read(doc_->value);
+}
+
+float_t norm::read(doc_id_t doc) const {
   assert(column_it_);
-  if (doc_->value != column_it_->seek(doc_->value)) {
+  if (doc != column_it_->seek(doc)) {
     return DEFAULT();
   }
   assert(payload_);
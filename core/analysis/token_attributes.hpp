@@ -110,6 +110,39 @@ struct IRESEARCH_API frequency final : attribute {
   uint32_t value{0};
 }; // frequency
 
+//////////////////////////////////////////////////////////////////////////////
+/// @class frequency_bound
+/// @brief upper bound of the term frequency within a block of documents,
+///        allows to estimate max score of the block without decoding it
+//////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API frequency_bound : public attribute {
+ public:
+  // DO NOT CHANGE NAME
+  static constexpr string_ref type_name() noexcept { return "frequency_bound"; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns upper bound of the term frequency over the whole posting list
+  //////////////////////////////////////////////////////////////////////////////
+  uint32_t max() const noexcept { return max_; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns upper bound of the term frequency within the current block,
+  ///          equals to 'max()' until the first call to 'shallow_seek(...)'
+  //////////////////////////////////////////////////////////////////////////////
+  uint32_t value() const noexcept { return value_; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief moves to the block containing 'target' without moving the
+  ///        underlying doc_iterator, subsequent targets must not decrease
+  /// @returns last document of the block, 'eof' for the trailing block
+  //////////////////////////////////////////////////////////////////////////////
+  virtual doc_id_t shallow_seek(doc_id_t target) = 0;
+
+ protected:
+  uint32_t max_{0};
+  uint32_t value_{0};
+}; // frequency_bound
+
 //////////////////////////////////////////////////////////////////////////////
 /// @class granularity_prefix
 /// @brief indexed tokens are prefixed with one byte indicating granularity
@@ -145,6 +178,13 @@ struct IRESEARCH_API norm final : attribute {
 
   bool reset(const sub_reader& segment, field_id column, const document& doc);
   float_t read() const;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief read norm value of the specified document, documents must be
+  ///        requested in ascending order, same as for 'read()'
+  //////////////////////////////////////////////////////////////////////////////
+  float_t read(doc_id_t doc) const;
+
   bool empty() const noexcept;
 
   void clear() noexcept;
@@ -24,6 +24,7 @@
 #include "token_streams.hpp"
 #include "utils/bit_utils.hpp"
 #include "utils/string_utils.hpp"
+#include "utils/utf8_utils.hpp"
 
 NS_ROOT
 
@@ -80,6 +81,83 @@ bool string_token_stream::next() noexcept {
   return !in_use;
 }
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                suffix_token_stream implementation
+// -----------------------------------------------------------------------------
+
+bool suffix_token_stream::next() noexcept {
+  const auto* end = value_.end();
+
+  if (begin_ == end) {
+    return false;
+  }
+
+  // all suffixes of a value share the position of the value itself
+  inc_.value = uint32_t(begin_ == value_.begin());
+  term_.value = bytes_ref(begin_, size_t(end - begin_));
+  begin_ = utf8_utils::next(begin_, end);
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                               shingle_token_stream implementation
+// -----------------------------------------------------------------------------
+
+/*static*/ bstring shingle_token_stream::shingle(
+    const bytes_ref& lhs, const bytes_ref& rhs) {
+  bstring shingle;
+  shingle.reserve(lhs.size() + 1 + rhs.size());
+  shingle.append(lhs.c_str(), lhs.size());
+  shingle += SEPARATOR;
+  shingle.append(rhs.c_str(), rhs.size());
+
+  return shingle;
+}
+
+bool shingle_token_stream::reset(token_stream& stream) noexcept {
+  stream_term_ = irs::get<term_attribute>(stream);
+  stream_inc_ = irs::get<increment>(stream);
+  stream_ = stream_term_ ? &stream : nullptr;
+  prev_inc_ = 0;
+  has_prev_ = false;
+
+  return nullptr != stream_;
+}
+
+bool shingle_token_stream::next() {
+  if (!stream_) {
+    return false;
+  }
+
+  while (stream_->next()) {
+    const uint32_t inc = stream_inc_ ? stream_inc_->value : 1;
+    const auto& term = stream_term_->value;
+
+    if (has_prev_ && 1 == inc) {
+      term_buf_.assign(prev_.c_str(), prev_.size());
+      term_buf_ += SEPARATOR;
+      term_buf_.append(term.c_str(), term.size());
+
+      term_.value = term_buf_;
+      inc_.value = prev_inc_;
+      prev_.assign(term.c_str(), term.size());
+      prev_inc_ = 1; // next shingle starts at the current token
+
+      return true;
+    }
+
+    // either the first token or there is a gap before the current one
+    prev_.assign(term.c_str(), term.size());
+    prev_inc_ += inc;
+    has_prev_ = true;
+  }
+
+  stream_ = nullptr;
+
+  return false;
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                       numeric_term implementation
 // -----------------------------------------------------------------------------
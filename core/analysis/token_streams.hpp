@@ -110,6 +110,75 @@ class IRESEARCH_API string_token_stream final
   bool in_use_;
 }; // string_token_stream 
 
+//////////////////////////////////////////////////////////////////////////////
+/// @class suffix_token_stream
+/// @brief token_stream implementation producing all suffixes of a UTF-8
+///        encoded string (including the string itself) at the same position,
+///        a field indexed this way allows to evaluate wildcard patterns with
+///        a leading '%' via the term dictionary, e.g. '%.log' turns into a
+///        term query '.log' and '%foo%' into a prefix query 'foo'
+//////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API suffix_token_stream final
+    : public basic_token_stream,
+      private util::noncopyable {
+ public:
+  virtual bool next() noexcept override;
+
+  void reset(const bytes_ref& value) noexcept {
+    value_ = value;
+    begin_ = value.begin();
+  }
+
+  void reset(const string_ref& value) noexcept {
+    reset(ref_cast<byte_type>(value));
+  }
+
+ private:
+  bytes_ref value_;
+  const byte_type* begin_{}; // beginning of the next suffix
+}; // suffix_token_stream
+
+//////////////////////////////////////////////////////////////////////////////
+/// @class shingle_token_stream
+/// @brief token_stream implementation producing bigram shingles of a wrapped
+///        stream, i.e. terms of every two adjacent tokens joined by SEPARATOR,
+///        each shingle is placed at the position of its first token, a field
+///        indexed this way allows to evaluate a phrase via (usually much
+///        rarer) shingles instead of its terms, see by_phrase_options
+/// @note tokens separated by a position gap (e.g. a removed stopword) don't
+///       form a shingle
+//////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API shingle_token_stream final
+    : public basic_token_stream,
+      private util::noncopyable {
+ public:
+  // never appears in UTF-8 encoded text
+  static constexpr byte_type SEPARATOR = 0xFF;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns shingle composed of the specified terms
+  //////////////////////////////////////////////////////////////////////////////
+  static bstring shingle(const bytes_ref& lhs, const bytes_ref& rhs);
+
+  virtual bool next() override;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief produce shingles of the specified 'stream', the stream must be
+  ///        reset beforehand and outlive an iteration over shingles
+  /// @returns false if 'stream' doesn't provide a term attribute
+  //////////////////////////////////////////////////////////////////////////////
+  bool reset(token_stream& stream) noexcept;
+
+ private:
+  token_stream* stream_{};
+  const term_attribute* stream_term_{};
+  const increment* stream_inc_{};
+  bstring term_buf_; // the last produced shingle
+  bstring prev_; // the last token of a wrapped stream
+  uint32_t prev_inc_{}; // distance from the last produced shingle to 'prev_'
+  bool has_prev_{};
+}; // shingle_token_stream
+
 //////////////////////////////////////////////////////////////////////////////
 /// @class numeric_token_stream
 /// @brief token_stream implementation for numeric field. based on precision
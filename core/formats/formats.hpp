@@ -29,6 +29,7 @@
 
 #include "index/index_meta.hpp"
 #include "index/column_info.hpp"
+#include "index/document_mask.hpp"
 #include "index/iterators.hpp"
 
 #include "utils/io_utils.hpp"
@@ -47,7 +48,6 @@ struct reader_state;
 struct index_output;
 struct data_input;
 struct index_input;
-typedef std::unordered_set<doc_id_t> document_mask;
 struct postings_writer;
 typedef std::vector<doc_id_t> doc_map;
 
@@ -186,7 +186,7 @@ struct IRESEARCH_API term_reader: public attribute_provider {
   virtual seek_term_iterator::ptr iterator() const = 0;
 
   // returns an intersection of a specified automaton and term reader
-  virtual seek_term_iterator::ptr iterator(automaton_table_matcher& matcher) const = 0;
+  virtual seek_term_iterator::ptr iterator(const automaton_table_matcher& matcher) const = 0;
 
   // returns field metadata
   virtual const field_meta& meta() const = 0;
@@ -305,6 +305,23 @@ struct IRESEARCH_API columnstore_reader {
     // may be accessed via the 'payload' attribute
     virtual doc_iterator::ptr iterator() const = 0;
 
+    // returns the column iterator omitting blocks of documents which values
+    // are known to be outside of [min, max] in lexicographical order,
+    // 'bytes_ref::NIL' denotes an unbounded side of the range
+    // note that the iterator may still return documents with values
+    // outside of the range, i.e. values have to be checked by a caller
+    virtual doc_iterator::ptr iterator(
+        const bytes_ref& /*min*/,
+        const bytes_ref& /*max*/) const {
+      return iterator();
+    }
+
+    // returns min/max values stored in a column,
+    // 'bytes_ref::NIL' in case if bounds aren't tracked for a column
+    virtual std::pair<bytes_ref, bytes_ref> bounds() const noexcept {
+      return { bytes_ref::NIL, bytes_ref::NIL };
+    }
+
     virtual bool visit(const columnstore_reader::values_visitor_f& reader) const = 0;
 
     virtual size_t size() const = 0;
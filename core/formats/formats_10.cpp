@@ -56,9 +56,11 @@
 #include "utils/lz4compression.hpp"
 #include "utils/encryption.hpp"
 #include "utils/frozen_attributes.hpp"
+#include "utils/hash_utils.hpp"
 #include "utils/compression.hpp"
 #include "utils/directory_utils.hpp"
 #include "utils/log.hpp"
+#include "utils/lru_cache.hpp"
 #include "utils/memory.hpp"
 #include "utils/memory_pool.hpp"
 #include "utils/noncopyable.hpp"
@@ -208,7 +210,7 @@ inline void prepare_output(
   format_utils::write_header(*out, format, version);
 }
 
-inline void prepare_input(
+inline int32_t prepare_input(
     std::string& str,
     index_input::ptr& in,
     IOAdvice advice,
@@ -228,7 +230,7 @@ inline void prepare_input(
     ));
   }
 
-  format_utils::check_header(*in, format, min_ver, max_ver);
+  return format_utils::check_header(*in, format, min_ver, max_ver);
 }
 
 // ----------------------------------------------------------------------------
@@ -249,7 +251,9 @@ inline void prepare_input(
 class postings_writer_base : public irs::postings_writer {
  public:
   static const int32_t TERMS_FORMAT_MIN = 0;
-  static const int32_t TERMS_FORMAT_MAX = TERMS_FORMAT_MIN;
+  // max in-document frequency of a term is stored in term metadata
+  static const int32_t TERMS_FORMAT_MAX_FREQ = TERMS_FORMAT_MIN + 1;
+  static const int32_t TERMS_FORMAT_MAX = TERMS_FORMAT_MAX_FREQ;
 
   static constexpr int32_t FORMAT_MIN = 0;
   // positions are stored one based (if first osition is 1 first offset is 0)
@@ -268,7 +272,14 @@ class postings_writer_base : public irs::postings_writer {
   static constexpr int32_t FORMAT_POSITIONS_ZEROBASED = FORMAT_SSE_POSITIONS_ONEBASED + 1;
   // positions are stored zero based, sse used
   static constexpr int32_t FORMAT_SSE_POSITIONS_ZEROBASED = FORMAT_POSITIONS_ZEROBASED + 1;
-  static constexpr int32_t FORMAT_MAX = FORMAT_SSE_POSITIONS_ZEROBASED;
+
+  // positions are stored zero based,
+  // skip data contains max in-document frequency of the skipped documents
+  // which allows to evaluate max score of a block without decoding it
+  static constexpr int32_t FORMAT_BLOCK_MAX = FORMAT_SSE_POSITIONS_ZEROBASED + 1;
+  // block max, sse used
+  static constexpr int32_t FORMAT_SSE_BLOCK_MAX = FORMAT_BLOCK_MAX + 1;
+  static constexpr int32_t FORMAT_MAX = FORMAT_SSE_BLOCK_MAX;
 
   static const uint32_t MAX_SKIP_LEVELS = 10;
   static const uint32_t BLOCK_SIZE = 128;
@@ -288,7 +299,8 @@ class postings_writer_base : public irs::postings_writer {
       postings_format_version_(postings_format_version),
       terms_format_version_(terms_format_version),
       pos_min_(postings_format_version_ >= FORMAT_POSITIONS_ZEROBASED ?   // first position offsets now is format dependent
-               pos_limits::invalid(): pos_limits::min()) {
+               pos_limits::invalid(): pos_limits::min()),
+      block_max_(postings_format_version_ >= FORMAT_BLOCK_MAX) {
     assert(postings_format_version >= FORMAT_MIN && postings_format_version <= FORMAT_MAX);
     assert(terms_format_version >= TERMS_FORMAT_MIN && terms_format_version <= TERMS_FORMAT_MAX);
   }
@@ -362,6 +374,7 @@ class postings_writer_base : public irs::postings_writer {
     }
 
     doc_id_t skip_doc[MAX_SKIP_LEVELS]{};
+    uint32_t skip_freq[MAX_SKIP_LEVELS]{}; // max frequency since last skip
     doc_id_t deltas[BLOCK_SIZE]{}; // document deltas
     uint32_t freqs[BLOCK_SIZE]{};
     doc_id_t* delta{ deltas };
@@ -453,6 +466,7 @@ class postings_writer_base : public irs::postings_writer {
   const int32_t postings_format_version_;
   const int32_t terms_format_version_;
   uint32_t pos_min_; // initial base value for writing positions offsets
+  bool block_max_; // store max frequencies along with skip data
 };
 
 MSVC2015_ONLY(__pragma(warning(push)))
@@ -532,6 +546,12 @@ void postings_writer_base::encode(
   if (meta.freq != integer_traits<uint32_t>::const_max) {
     assert(meta.freq >= meta.docs_count);
     out.write_vint(meta.freq - meta.docs_count);
+
+    if (terms_format_version_ >= TERMS_FORMAT_MAX_FREQ && meta.docs_count > 1) {
+      // for singleton documents max frequency is equal to term frequency
+      assert(meta.max_freq && meta.max_freq <= meta.freq);
+      out.write_vint(meta.max_freq);
+    }
   }
 
   out.write_vlong(meta.doc_start - last_state_.doc_start);
@@ -577,6 +597,11 @@ void postings_writer_base::write_skip(size_t level, index_output& out) {
   doc_.skip_doc[level] = doc_.block_last;
   doc_.skip_ptr[level] = doc_ptr;
 
+  if (block_max_ && features_.freq()) {
+    out.write_vint(doc_.skip_freq[level]);
+    doc_.skip_freq[level] = 0;
+  }
+
   if (features_.position()) {
     assert(pos_);
 
@@ -605,6 +630,7 @@ void postings_writer_base::write_skip(size_t level, index_output& out) {
 void postings_writer_base::begin_term() {
   doc_.start = doc_out_->file_pointer();
   std::fill_n(doc_.skip_ptr, MAX_SKIP_LEVELS, doc_.start);
+  std::fill_n(doc_.skip_freq, MAX_SKIP_LEVELS, 0);
   if (features_.position()) {
     assert(pos_ && pos_out_);
     pos_->start = pos_out_->file_pointer();
@@ -625,6 +651,14 @@ void postings_writer_base::end_doc() {
   if (doc_.full()) {
     doc_.block_last = doc_.last;
     doc_.end = doc_out_->file_pointer();
+
+    if (block_max_ && features_.freq()) {
+      // accumulate block max frequency for every skip level
+      const uint32_t max_freq = *std::max_element(std::begin(doc_.freqs), std::end(doc_.freqs));
+      for (auto& skip_freq : doc_.skip_freq) {
+        skip_freq = std::max(skip_freq, max_freq);
+      }
+    }
     if (features_.position()) {
       assert(pos_ && pos_out_);
       pos_->end = pos_out_->file_pointer();
@@ -850,7 +884,9 @@ template<typename FormatTraits, bool VolatileAttributes>
 class postings_writer final: public postings_writer_base {
  public:
   explicit postings_writer(int32_t version)
-    : postings_writer_base(version, TERMS_FORMAT_MAX) {
+    : postings_writer_base(version, version >= FORMAT_BLOCK_MAX
+                                      ? TERMS_FORMAT_MAX_FREQ
+                                      : TERMS_FORMAT_MIN) {
   }
 
   virtual irs::postings_writer::state write(irs::doc_iterator& docs) override;
@@ -920,6 +956,7 @@ irs::postings_writer::state postings_writer<FormatTraits, VolatileAttributes>::w
     ++meta->docs_count;
     if (freq_) {
       meta->freq += freq_->value;
+      meta->max_freq = std::max(meta->max_freq, freq_->value);
     }
 
     end_doc();
@@ -943,6 +980,7 @@ struct skip_state {
   size_t pend_pos{}; // positions to skip before new document block
   doc_id_t doc{ doc_limits::invalid() }; // last document in a previous block
   uint32_t pay_pos{}; // payload size to skip before in new document block
+  uint32_t max_freq{}; // max frequency within a skipped range (block max formats only)
 }; // skip_state
 
 struct skip_context : skip_state {
@@ -1562,18 +1600,22 @@ struct position<IteratorTraits, false> : attribute {
 ///////////////////////////////////////////////////////////////////////////////
 template<typename IteratorTraits>
 class doc_iterator final
-    : public frozen_attributes<5, irs::doc_iterator> {
+    : public frozen_attributes<8, irs::doc_iterator> {
  public:
   doc_iterator() noexcept
     : attributes{{
         { type<document>::id(), &doc_ },
         { type<cost>::id(), &cost_    },
         { type<score>::id(), &scr_    },
+        { type<score_upper_bound>::id(), IteratorTraits::frequency() ? &scr_bound_ : nullptr },
+        { type<score_block>::id(), IteratorTraits::frequency() ? &scr_block_ : nullptr },
         { type<frequency>::id(),     IteratorTraits::frequency() ? &freq_ : nullptr  },
+        { type<frequency_bound>::id(), IteratorTraits::frequency() ? &freq_bound_ : nullptr },
         { type<irs::position>::id(), IteratorTraits::position()  ? &pos_  : nullptr  },
       }},
       skip_levels_(1),
-      skip_(postings_writer_base::BLOCK_SIZE, postings_writer_base::SKIP_N) {
+      skip_(postings_writer_base::BLOCK_SIZE, postings_writer_base::SKIP_N),
+      freq_bound_(*this) {
     assert(
       std::all_of(docs_, docs_ + postings_writer_base::BLOCK_SIZE,
                   [](doc_id_t doc) { return doc == doc_limits::invalid(); })
@@ -1585,8 +1627,10 @@ class doc_iterator final
       const attribute_provider& attrs,
       const index_input* doc_in,
       [[maybe_unused]] const index_input* pos_in,
-      [[maybe_unused]] const index_input* pay_in) {
+      [[maybe_unused]] const index_input* pay_in,
+      bool block_max) {
     features_ = field; // set field features
+    block_max_ = block_max && features_.freq();
 
     assert(!IteratorTraits::frequency() || IteratorTraits::frequency() == features_.freq());
     assert(!IteratorTraits::position() || IteratorTraits::position() == features_.position());
@@ -1625,10 +1669,28 @@ class doc_iterator final
 
     cost_.value(term_state_.docs_count); // estimate iterator
 
+    // read blocks of long posting lists ahead of decoding
+    prefetch_end_ = 0;
+    prefetch_size_ = 0;
+    if (term_state_.docs_count >= PREFETCH_MIN_DOCS) {
+      const size_t num_blocks = term_state_.docs_count / postings_writer_base::BLOCK_SIZE;
+      const size_t block_size = term_state_.e_skip_start / num_blocks; // average
+      prefetch_size_ = std::max(PREFETCH_BLOCKS*block_size, PREFETCH_MIN_SIZE);
+      docs_end_ = term_state_.doc_start + term_state_.e_skip_start;
+    }
+
     if constexpr (IteratorTraits::frequency()) {
       assert(irs::get<frequency>(attrs));
       term_freq_ = irs::get<frequency>(attrs)->value;
 
+      if (block_max_ && term_state_.max_freq) {
+        freq_bound_.prepare(term_state_.max_freq);
+      } else {
+        // no frequency bounds stored, e.g. old format
+        *ref(irs::type<frequency_bound>::id()) = nullptr;
+        *ref(irs::type<score_upper_bound>::id()) = nullptr;
+      }
+
       if constexpr (IteratorTraits::position()) {
         doc_state state;
         state.pos_in = pos_in;
@@ -1755,8 +1817,47 @@ class doc_iterator final
 #endif
 
  private:
+  ////////////////////////////////////////////////////////////////////////////
+  /// @class block_bound
+  /// @brief evaluates frequency bounds using skip data of the posting list,
+  ///        skip list is traversed independently of the one used by 'seek'
+  ////////////////////////////////////////////////////////////////////////////
+  class block_bound final : public frequency_bound {
+   public:
+    explicit block_bound(doc_iterator& it) noexcept
+      : it_(&it),
+        skip_(postings_writer_base::BLOCK_SIZE, postings_writer_base::SKIP_N) {
+    }
+
+    void prepare(uint32_t max_freq) noexcept {
+      max_ = value_ = max_freq;
+    }
+
+    virtual doc_id_t shallow_seek(doc_id_t target) override;
+
+   private:
+    doc_iterator* it_;
+    std::vector<skip_state> skip_levels_;
+    skip_reader skip_;
+    doc_id_t end_{ doc_limits::invalid() }; // last document in current block
+  }; // block_bound
+
   void seek_to_block(doc_id_t target);
 
+  index_input::ptr open_skip_input() const {
+    auto skip_in = doc_in_->dup();
+
+    if (!skip_in) {
+      IR_FRMT_ERROR("Failed to duplicate input in: %s", __FUNCTION__);
+
+      throw io_error("Failed to duplicate document input");
+    }
+
+    skip_in->seek(term_state_.doc_start + term_state_.e_skip_start);
+
+    return skip_in;
+  }
+
   // returns current position in the document block 'docs_'
   size_t relative_pos() noexcept {
     assert(begin_ >= docs_);
@@ -1767,6 +1868,10 @@ class doc_iterator final
     state.doc = in.read_vint();
     state.doc_ptr += in.read_vlong();
 
+    if (block_max_) {
+      state.max_freq = in.read_vint();
+    }
+
     if (features_.position()) {
       state.pend_pos = in.read_vint();
       state.pos_ptr += in.read_vlong();
@@ -1801,11 +1906,29 @@ class doc_iterator final
     }
   }
 
+  // request the next range of the postings once
+  // a half of the previously requested one is consumed
+  void prefetch() noexcept {
+    assert(prefetch_size_);
+    const size_t ptr = doc_in_->file_pointer();
+
+    if (ptr + prefetch_size_/2 < prefetch_end_ || ptr >= docs_end_) {
+      return;
+    }
+
+    prefetch_end_ = std::min(ptr + prefetch_size_, docs_end_);
+    doc_in_->prefetch(ptr, prefetch_end_ - ptr);
+  }
+
   void refill() {
     // should never call refill for singleton documents
     assert(1 != term_state_.docs_count);
     const auto left = term_state_.docs_count - cur_pos_;
 
+    if (prefetch_size_) {
+      prefetch();
+    }
+
     if (left >= postings_writer_base::BLOCK_SIZE) {
       // read doc deltas
       IteratorTraits::read_block(
@@ -1837,8 +1960,17 @@ class doc_iterator final
     doc_freq_ = doc_freqs_;
   }
 
+  // minimum number of documents in a posting list to read it ahead
+  static constexpr uint32_t PREFETCH_MIN_DOCS = 8*postings_writer_base::BLOCK_SIZE;
+  // number of blocks to read ahead
+  static constexpr size_t PREFETCH_BLOCKS = 32;
+  // minimum size of a range to read ahead, in bytes
+  static constexpr size_t PREFETCH_MIN_SIZE = 32768;
+
   irs::cost cost_;
   irs::score scr_;
+  score_upper_bound scr_bound_;
+  score_block scr_block_;
   std::vector<skip_state> skip_levels_;
   skip_reader skip_;
   skip_context* skip_ctx_; // pointer to used skip context, will be used by skip reader
@@ -1853,11 +1985,68 @@ class doc_iterator final
   document doc_;
   frequency freq_;
   index_input::ptr doc_in_;
+  size_t docs_end_{}; // end of the document postings in 'doc_in_'
+  size_t prefetch_end_{}; // end of the range requested by 'prefetch()'
+  size_t prefetch_size_{}; // 0 if the posting list isn't read ahead
   version10::term_meta term_state_;
   features features_; // field features
   position<IteratorTraits> pos_;
+  block_bound freq_bound_;
+  bool block_max_{}; // skip data contains max frequencies
 }; // doc_iterator
 
+template<typename IteratorTraits>
+doc_id_t doc_iterator<IteratorTraits>::block_bound::shallow_seek(doc_id_t target) {
+  if (target <= end_) {
+    // still within the current block
+    return end_;
+  }
+
+  auto& it = *it_;
+
+  if (it.term_state_.docs_count <= postings_writer_base::BLOCK_SIZE) {
+    // single block without skip data
+    return end_ = doc_limits::eof();
+  }
+
+  // init skip reader in lazy fashion
+  if (!skip_) {
+    skip_.prepare(
+      it.open_skip_input(),
+      [this](size_t level, index_input& in) {
+        auto& next = skip_levels_[level];
+
+        if (in.eof()) {
+          // stream exhausted
+          return (next.doc = doc_limits::eof());
+        }
+
+        // document and frequency values aren't delta encoded
+        return it_->read_skip(next, in);
+    });
+
+    skip_levels_.resize(skip_.num_levels());
+  }
+
+  if (skip_levels_.empty()) {
+    return end_ = doc_limits::eof();
+  }
+
+  skip_.seek(target);
+
+  // level 0 points to the block containing 'target'
+  const auto& level = skip_levels_.front();
+
+  if (doc_limits::eof(level.doc)) {
+    // trailing block isn't covered by skip data
+    value_ = max_;
+  } else {
+    value_ = level.max_freq;
+  }
+
+  return end_ = level.doc;
+}
+
 template<typename IteratorTraits>
 void doc_iterator<IteratorTraits>::seek_to_block(doc_id_t target) {
   // check whether it make sense to use skip-list
@@ -1867,18 +2056,8 @@ void doc_iterator<IteratorTraits>::seek_to_block(doc_id_t target) {
 
     // init skip writer in lazy fashion
     if (!skip_) {
-      auto skip_in = doc_in_->dup();
-
-      if (!skip_in) {
-        IR_FRMT_ERROR("Failed to duplicate input in: %s", __FUNCTION__);
-
-        throw io_error("Failed to duplicate document input");
-      }
-
-      skip_in->seek(term_state_.doc_start + term_state_.e_skip_start);
-
       skip_.prepare(
-        std::move(skip_in),
+        open_skip_input(),
         [this](size_t level, index_input& in) {
           skip_state& last = *skip_ctx_;
           auto& last_level = skip_ctx_->level;
@@ -2394,8 +2573,19 @@ class document_mask_writer final: public irs::document_mask_writer {
   static const string_ref FORMAT_EXT;
   static const string_ref FORMAT_NAME;
 
-  static const int32_t FORMAT_MIN = 0;
-  static const int32_t FORMAT_MAX = FORMAT_MIN;
+  static constexpr int32_t FORMAT_MIN = 0;
+  static constexpr int32_t FORMAT_BITSET = 1; // dense/sparse bitset encoding
+  static constexpr int32_t FORMAT_MAX = FORMAT_BITSET;
+
+  // block of a dense mask is written as a sequence of bitset words
+  static constexpr byte_type MASK_DENSE = 0;
+  // block of a sparse mask is written as a sequence of doc deltas
+  static constexpr byte_type MASK_SPARSE = 1;
+
+  explicit document_mask_writer(int32_t version) noexcept
+    : version_(version) {
+    assert(version >= FORMAT_MIN && version <= FORMAT_MAX);
+  }
 
   virtual ~document_mask_writer() = default;
 
@@ -2408,6 +2598,11 @@ class document_mask_writer final: public irs::document_mask_writer {
     const segment_meta& meta,
     const document_mask& docs_mask
   ) override;
+
+ private:
+  void write_bitset(index_output& out, const document_mask& docs_mask);
+
+  int32_t version_;
 }; // document_mask_writer
 
 template<>
@@ -2444,16 +2639,63 @@ void document_mask_writer::write(
   assert(docs_mask.size() <= integer_traits<uint32_t>::const_max);
   const auto count = static_cast<uint32_t>(docs_mask.size());
 
-  format_utils::write_header(*out, FORMAT_NAME, FORMAT_MAX);
+  format_utils::write_header(*out, FORMAT_NAME, version_);
   out->write_vint(count);
 
-  for (auto mask : docs_mask) {
-    out->write_vint(mask);
+  if (version_ >= FORMAT_BITSET) {
+    write_bitset(*out, docs_mask);
+  } else {
+    for (auto mask : docs_mask) {
+      out->write_vint(mask);
+    }
   }
 
   format_utils::write_footer(*out);
 }
 
+void document_mask_writer::write_bitset(
+    index_output& out,
+    const document_mask& docs_mask) {
+  if (docs_mask.empty()) {
+    return;
+  }
+
+  // trailing empty words aren't stored
+  auto words = docs_mask.words();
+  const auto* data = docs_mask.data();
+  while (!data[words - 1]) {
+    --words;
+  }
+
+  // choose the most compact representation
+  uint64_t sparse_size = 0;
+  doc_id_t prev = 0;
+  for (const auto doc : docs_mask) {
+    sparse_size += bytes_io<uint32_t>::vsize(doc - prev);
+    prev = doc;
+  }
+
+  const uint64_t dense_size = words * sizeof(uint64_t);
+
+  out.write_vlong(words);
+
+  if (dense_size < sparse_size) {
+    out.write_byte(MASK_DENSE);
+
+    for (const auto* end = data + words; data != end; ++data) {
+      out.write_long(static_cast<int64_t>(*data));
+    }
+  } else {
+    out.write_byte(MASK_SPARSE);
+
+    prev = 0;
+    for (const auto doc : docs_mask) {
+      out.write_vint(doc - prev);
+      prev = doc;
+    }
+  }
+}
+
 // ----------------------------------------------------------------------------
 // --SECTION--                                             document_mask_reader
 // ----------------------------------------------------------------------------
@@ -2503,22 +2745,68 @@ bool document_mask_reader::read(
 
   const auto checksum = format_utils::checksum(*in);
 
-  format_utils::check_header(
+  const auto version = format_utils::check_header(
     *in,
     document_mask_writer::FORMAT_NAME,
     document_mask_writer::FORMAT_MIN,
     document_mask_writer::FORMAT_MAX
   );
 
-  auto count = in->read_vint();
+  const auto count = in->read_vint();
 
-  while (count--) {
-    static_assert(
-      sizeof(doc_id_t) == sizeof(decltype(in->read_vint())),
-      "sizeof(doc_id) != sizeof(decltype(id))"
-    );
+  static_assert(
+    sizeof(doc_id_t) == sizeof(decltype(in->read_vint())),
+    "sizeof(doc_id) != sizeof(decltype(id))"
+  );
+
+  if (version < document_mask_writer::FORMAT_BITSET) {
+    for (auto left = count; left; --left) {
+      docs_mask.insert(in->read_vint());
+    }
+  } else if (count) {
+    const auto words = in->read_vlong();
+    const auto type = in->read_byte();
+
+    if (!words || words > bitset::word(doc_limits::eof()) + 1) {
+      throw index_error(string_utils::to_string(
+        "while reading document mask, error: invalid number of words '" IR_UINT64_T_SPECIFIER "'",
+        words
+      ));
+    }
+
+    docs_mask.reserve(doc_id_t(bitset::bit_offset(words) - 1));
 
-    docs_mask.insert(in->read_vint());
+    switch (type) {
+      case document_mask_writer::MASK_DENSE: {
+        for (size_t word = 0; word < words; ++word) {
+          auto value = static_cast<uint64_t>(in->read_long());
+          const auto offset = bitset::bit_offset(word);
+
+          for (; value; value &= value - 1) {
+            docs_mask.insert(doc_id_t(offset + math::math_traits<uint64_t>::ctz(value)));
+          }
+        }
+      } break;
+      case document_mask_writer::MASK_SPARSE: {
+        doc_id_t doc = 0;
+        for (auto left = count; left; --left) {
+          doc += in->read_vint();
+          docs_mask.insert(doc);
+        }
+      } break;
+      default:
+        throw index_error(string_utils::to_string(
+          "while reading document mask, error: invalid mask type '%d'",
+          int(type)
+        ));
+    }
+
+    if (count != docs_mask.size()) {
+      throw index_error(string_utils::to_string(
+        "while reading document mask, error: invalid count '%u', read '" IR_SIZE_T_SPECIFIER "'",
+        count, docs_mask.size()
+      ));
+    }
   }
 
   format_utils::check_footer(*in, checksum);
@@ -2770,11 +3058,22 @@ bool meta_reader::read(column_meta& column) {
 // |Last block #1 key|Block #1 offset| <-- Columnstore blocks index
 // |Last block #2 key|Block #2 offset|
 // ...
+// |Column min value|Column max value|
+// |Block #0 min value|Block #0 max value| <-- Columnstore blocks bounds
+// |Block #1 min value|Block #1 max value|     (since 'FORMAT_BLOCK_BOUNDS')
+// ...
 // |Footer|
 
 const uint32_t INDEX_BLOCK_SIZE = 1024;
 const size_t MAX_DATA_BLOCK_SIZE = 8192;
 
+// upper limit for a data block size configured via 'column_info'
+const size_t DATA_BLOCK_SIZE_LIMIT = 16*1024*1024;
+
+// max size of a value tracked in block bounds,
+// bounds aren't stored for columns with larger values
+const size_t MAX_BOUND_SIZE = 64;
+
 /// @brief Column flags
 /// @note by default we treat columns as a variable length sparse columns
 enum ColumnProperty : uint32_t {
@@ -3036,7 +3335,8 @@ class index_block {
 class writer final : public irs::columnstore_writer {
  public:
   static const int32_t FORMAT_MIN = 0;
-  static const int32_t FORMAT_MAX = 1;
+  static const int32_t FORMAT_BLOCK_BOUNDS = 2; // min/max values per block
+  static const int32_t FORMAT_MAX = FORMAT_BLOCK_BOUNDS;
 
   static const string_ref FORMAT_NAME;
   static const string_ref FORMAT_EXT;
@@ -3062,13 +3362,16 @@ class writer final : public irs::columnstore_writer {
    public:
     explicit column(writer& ctx, const irs::type_info& type,
                     const compression::compressor::ptr& compressor,
-                    encryption::stream* cipher)
+                    encryption::stream* cipher,
+                    size_t block_size)
       : ctx_(&ctx),
         comp_type_(type),
         comp_(compressor),
         cipher_(cipher),
         blocks_index_(*ctx.alloc_),
-        block_buf_(2*MAX_DATA_BLOCK_SIZE, 0) {
+        block_buf_(2*MAX_DATA_BLOCK_SIZE, 0),
+        block_size_(block_size),
+        track_bounds_(ctx.version_ >= FORMAT_BLOCK_BOUNDS) {
       assert(comp_); // ensured by `push_column'
       block_buf_.clear(); // reset size to '0'
     }
@@ -3081,9 +3384,12 @@ class writer final : public irs::columnstore_writer {
         return;
       }
 
-      // flush block if we've overcome MAX_DATA_BLOCK_SIZE size
+      // value of the previous document is complete
+      update_bounds();
+
+      // flush block if we've overcome 'block_size_'
       // or reached the end of the index block
-      if (block_buf_.size() >= MAX_DATA_BLOCK_SIZE || block_index_.full()) {
+      if (block_buf_.size() >= block_size_ || block_index_.full()) {
         flush_block();
       }
 
@@ -3113,6 +3419,17 @@ class writer final : public irs::columnstore_writer {
       out.write_vint(avg_block_count_); // avg number of elements per block
       out.write_vint(column_index_.total()); // total number of index blocks
       blocks_index_.file >> out; // column blocks index
+
+      if (ctx_->version_ >= FORMAT_BLOCK_BOUNDS) {
+        out.write_byte(byte_type(track_bounds_));
+
+        if (track_bounds_) {
+          out.write_vint(column_index_.total()); // number of blocks bounds
+          write_string(out, min_value_);
+          write_string(out, max_value_);
+          out.write_bytes(bounds_.c_str(), bounds_.size()); // blocks bounds
+        }
+      }
     }
 
     void flush() {
@@ -3122,6 +3439,7 @@ class writer final : public irs::columnstore_writer {
       avg_block_size_ = length_ / blocks_count;
 
       // commit and flush remain blocks
+      update_bounds();
       flush_block();
 
       // finish column blocks index
@@ -3155,6 +3473,34 @@ class writer final : public irs::columnstore_writer {
     }
 
    private:
+    // accounts value of the last document of the current block in bounds
+    void update_bounds() {
+      if (!track_bounds_ || block_index_.empty()) {
+        return;
+      }
+
+      const auto offset = block_index_.max_offset();
+      assert(offset <= block_buf_.size());
+      const bytes_ref value(block_buf_.c_str() + offset, block_buf_.size() - offset);
+
+      if (value.size() > MAX_BOUND_SIZE) {
+        // bounds of long values are useless, don't track them at all
+        track_bounds_ = false;
+        bounds_ = bstring();
+        return;
+      }
+
+      if (1 == block_index_.size()) {
+        // first value in a block
+        block_min_.assign(value.c_str(), value.size());
+        block_max_.assign(value.c_str(), value.size());
+      } else if (value < block_min_) {
+        block_min_.assign(value.c_str(), value.size());
+      } else if (bytes_ref(block_max_) < value) {
+        block_max_.assign(value.c_str(), value.size());
+      }
+    }
+
     void flush_block() {
       if (block_index_.empty()) {
         // nothing to flush
@@ -3197,6 +3543,25 @@ class writer final : public irs::columnstore_writer {
 
       length_ += block_buf_.size();
 
+      if (track_bounds_) {
+        bytes_output bounds(bounds_);
+        write_string(bounds, block_min_);
+        write_string(bounds, block_max_);
+
+        if (1 == column_index_.total()) {
+          // first block in a column
+          min_value_ = block_min_;
+          max_value_ = block_max_;
+        } else {
+          if (bytes_ref(block_min_) < min_value_) {
+            min_value_ = block_min_;
+          }
+          if (bytes_ref(max_value_) < block_max_) {
+            max_value_ = block_max_;
+          }
+        }
+      }
+
       // refresh blocks properties
       blocks_props_ &= block_props;
       // reset buffer stream after flush
@@ -3218,6 +3583,13 @@ class writer final : public irs::columnstore_writer {
     index_block<INDEX_BLOCK_SIZE> column_index_; // column block index (per block key/offset)
     memory_output blocks_index_; // blocks index
     bstring block_buf_; // data buffer
+    size_t block_size_; // size of the data buffer triggering block flush
+    bstring bounds_; // min/max values of flushed blocks
+    bstring block_min_; // min value in the current block
+    bstring block_max_; // max value in the current block
+    bstring min_value_; // min value among flushed blocks
+    bstring max_value_; // max value among flushed blocks
+    bool track_bounds_; // whether column value bounds are tracked
     doc_id_t max_{ doc_limits::invalid() }; // max key (among flushed blocks)
     ColumnProperty blocks_props_{ CP_DENSE | CP_FIXED | CP_MASK }; // aggregated column blocks properties
     ColumnProperty column_props_{ CP_DENSE }; // aggregated column block index properties
@@ -3301,8 +3673,12 @@ columnstore_writer::column_t writer::push_column(const column_info& info) {
     compressor = noop_compressor::make();
   }
 
+  const auto block_size = info.block_size()
+    ? std::min(info.block_size(), DATA_BLOCK_SIZE_LIMIT)
+    : MAX_DATA_BLOCK_SIZE;
+
   const auto id = columns_.size();
-  columns_.emplace_back(*this, info.compression(), compressor, cipher);
+  columns_.emplace_back(*this, info.compression(), compressor, cipher, block_size);
   auto& column = columns_.back();
 
   return std::make_pair(id, [&column] (doc_id_t doc) -> column_output& {
@@ -3575,6 +3951,11 @@ class sparse_block : util::noncopyable {
     return visitor(begin->key, value);
   }
 
+  // @returns amount of memory occupied by a block
+  size_t memory() const noexcept {
+    return sizeof(*this) + data_.capacity();
+  }
+
  private:
   // TODO: use single memory block for both index & data
 
@@ -3752,6 +4133,11 @@ class dense_block : util::noncopyable {
     return visitor(key, value);
   }
 
+  // @returns amount of memory occupied by a block
+  size_t memory() const noexcept {
+    return sizeof(*this) + data_.capacity();
+  }
+
  private:
   // TODO: use single memory block for both index & data
 
@@ -3921,6 +4307,11 @@ class dense_fixed_offset_block : util::noncopyable {
     return visitor(key, value);
   }
 
+  // @returns amount of memory occupied by a block
+  size_t memory() const noexcept {
+    return sizeof(*this) + data_.capacity();
+  }
+
  private:
   doc_id_t base_key_{}; // base key
   uint32_t base_offset_{}; // base offset
@@ -4033,6 +4424,11 @@ class sparse_mask_block : util::noncopyable {
     return true;
   }
 
+  // @returns amount of memory occupied by a block
+  size_t memory() const noexcept {
+    return sizeof(*this);
+  }
+
  private:
   // all blocks except the tail one are going to be fully filled,
   // so we store keys in a fixed length array since we could
@@ -4148,6 +4544,11 @@ class dense_mask_block {
     return true;
   }
 
+  // @returns amount of memory occupied by a block
+  size_t memory() const noexcept {
+    return sizeof(*this);
+  }
+
  private:
   doc_id_t min_;
   doc_id_t max_;
@@ -4232,9 +4633,13 @@ typedef read_context<> read_context_t;
 class context_provider: private util::noncopyable {
  public:
   context_provider(size_t max_pool_size)
-    : pool_(std::max(size_t(1), max_pool_size)) {
+    : pool_(std::max(size_t(1), max_pool_size)),
+      id_(next_id()) {
   }
 
+  // @returns process-wide unique identifier of a provider
+  uint64_t id() const noexcept { return id_; }
+
   void prepare(index_input::ptr&& stream, encryption::stream::ptr&& cipher) noexcept {
     assert(stream);
 
@@ -4247,15 +4652,59 @@ class context_provider: private util::noncopyable {
   }
 
  private:
+  static uint64_t next_id() noexcept {
+    static std::atomic<uint64_t> ID{};
+    return ++ID;
+  }
+
   mutable bounded_object_pool<read_context_t> pool_;
   encryption::stream::ptr cipher_;
   index_input::ptr stream_;
+  const uint64_t id_;
 }; // context_provider
 
-// in case of success caches block pointed
-// instance, nullptr otherwise
+////////////////////////////////////////////////////////////////////////////////
+/// @brief process-wide cache of decompressed blocks shared by all columnstore
+///        readers, a block is identified by the reader it belongs to and its
+///        offset in a columnstore file (which is unique among all columns)
+////////////////////////////////////////////////////////////////////////////////
+struct block_key {
+  bool operator==(const block_key& rhs) const noexcept {
+    return reader == rhs.reader && offset == rhs.offset;
+  }
+
+  uint64_t reader;
+  uint64_t offset;
+}; // block_key
+
+struct block_key_hash {
+  size_t operator()(const block_key& key) const noexcept {
+    return irs::hash_combine(std::hash<uint64_t>()(key.reader), key.offset);
+  }
+}; // block_key_hash
+
+typedef sharded_lru_cache<
+  block_key,
+  std::shared_ptr<const void>,
+  block_key_hash
+> shared_block_cache_t;
+
+shared_block_cache_t& shared_block_cache() {
+  static shared_block_cache_t CACHE; // disabled by default
+  return CACHE;
+}
+
+// @returns non-owning pointer to a block cached by a particular reader
+template<typename Block>
+std::shared_ptr<const Block> make_unmanaged(const Block* block) noexcept {
+  return std::shared_ptr<const Block>(std::shared_ptr<const Block>(), block);
+}
+
+// loads block pointed by 'ref', caches loaded block in the shared
+// block cache if it's enabled, or in a reader's context otherwise,
+// returned pointer keeps block alive even after its eviction
 template<typename BlockRef>
-const typename BlockRef::block_t& load_block(
+std::shared_ptr<const typename BlockRef::block_t> load_block(
     const context_provider& ctxs,
     compression::decompressor* decomp,
     bool decrypt,
@@ -4264,48 +4713,82 @@ const typename BlockRef::block_t& load_block(
 
   const auto* cached = ref.pblock.load();
 
-  if (!cached) {
-    auto ctx = ctxs.get_context();
-    assert(ctx);
+  if (cached) {
+    // block has already been cached by a reader
+    return make_unmanaged(cached);
+  }
 
-    // load block
-    const auto& block = ctx->template emplace_back<block_t>(ref.offset, decomp, decrypt);
+  auto& cache = shared_block_cache();
 
-    // mark block as loaded
-    if (ref.pblock.compare_exchange_strong(cached, &block)) {
-      cached = &block;
-    } else {
-      // already cached by another thread
-      ctx->template pop_back<block_t>();
+  if (cache.capacity()) {
+    const block_key key{ ctxs.id(), ref.offset };
+    std::shared_ptr<const void> entry;
+
+    if (cache.get(key, entry)) {
+      return std::static_pointer_cast<const block_t>(entry);
     }
+
+    auto block = memory::make_shared<block_t>();
+
+    {
+      auto ctx = ctxs.get_context();
+      assert(ctx);
+
+      ctx->load(*block, decomp, decrypt, ref.offset);
+    }
+
+    cache.put(key, block, block->memory());
+
+    return block;
   }
 
-  return *cached;
+  auto ctx = ctxs.get_context();
+  assert(ctx);
+
+  // load block
+  const auto& block = ctx->template emplace_back<block_t>(ref.offset, decomp, decrypt);
+
+  // mark block as loaded
+  if (ref.pblock.compare_exchange_strong(cached, &block)) {
+    cached = &block;
+  } else {
+    // already cached by another thread
+    ctx->template pop_back<block_t>();
+  }
+
+  return make_unmanaged(cached);
 }
 
-// in case of success caches block pointed
-// by 'ref' in the specified 'block' and
-// retuns a pointer to cached instance,
-// nullptr otherwise
+// in case if block pointed by 'ref' isn't cached
+// loads it into the specified 'block' and
+// returns a reference to either cached or loaded
+// instance, doesn't populate any cache
 template<typename BlockRef>
 const typename BlockRef::block_t& load_block(
     const context_provider& ctxs,
     compression::decompressor* decomp,
     bool decrypt,
     const BlockRef& ref,
-    typename BlockRef::block_t& block) {
+    typename BlockRef::block_t& block,
+    std::shared_ptr<const void>& holder) {
   const auto* cached = ref.pblock.load();
 
-  if (!cached) {
-    auto ctx = ctxs.get_context();
-    assert(ctx);
+  if (cached) {
+    return *cached;
+  }
 
-    ctx->load(block, decomp, decrypt, ref.offset);
+  auto& cache = shared_block_cache();
 
-    cached = &block;
+  if (cache.capacity() && cache.get(block_key{ ctxs.id(), ref.offset }, holder)) {
+    return *static_cast<const typename BlockRef::block_t*>(holder.get());
   }
 
-  return *cached;
+  auto ctx = ctxs.get_context();
+  assert(ctx);
+
+  ctx->load(block, decomp, decrypt, ref.offset);
+
+  return block;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -4335,6 +4818,32 @@ class column
     decomp_ = decomp;
   }
 
+  void read_bounds(data_input& in) {
+    if (!in.read_byte()) {
+      // bounds aren't tracked for a column
+      return;
+    }
+
+    const size_t blocks_count = in.read_vint();
+    std::vector<bstring> bounds(2*(blocks_count + 1)); // +1 for column bounds
+
+    for (auto& bound : bounds) {
+      bound = read_string<bstring>(in);
+    }
+
+    if (blocks_count) {
+      bounds_ = std::move(bounds);
+    }
+  }
+
+  virtual std::pair<bytes_ref, bytes_ref> bounds() const noexcept override {
+    if (bounds_.empty()) {
+      return { bytes_ref::NIL, bytes_ref::NIL };
+    }
+
+    return { bounds_[0], bounds_[1] };
+  }
+
   bool encrypted() const noexcept { return encrypted_; }
   doc_id_t max() const noexcept { return max_; }
   virtual size_t size() const noexcept override { return count_; }
@@ -4344,11 +4853,46 @@ class column
   ColumnProperty props() const noexcept { return props_; }
   compression::decompressor* decompressor() const noexcept { return decomp_.get(); }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief marks in 'blocks' the first 'blocks_count' blocks which values
+  ///        may fall into [min, max]
+  /// @returns number of marked blocks or 'blocks_count' if bounds aren't
+  ///          tracked for a column
+  //////////////////////////////////////////////////////////////////////////////
+  size_t select_blocks(
+      const bytes_ref& min,
+      const bytes_ref& max,
+      size_t blocks_count,
+      bitset& blocks) const {
+    if (bounds_.size() != 2*(blocks_count + 1)) {
+      // no bounds, every block may contain matching values
+      return blocks_count;
+    }
+
+    blocks.reset(blocks_count);
+
+    size_t selected = 0;
+    for (size_t i = 0; i < blocks_count; ++i) {
+      const bytes_ref block_min = bounds_[2*(i + 1)];
+      const bytes_ref block_max = bounds_[2*(i + 1) + 1];
+
+      if ((!min.null() && block_max < min) || (!max.null() && max < block_min)) {
+        continue; // block values are outside of the range
+      }
+
+      blocks.set(i);
+      ++selected;
+    }
+
+    return selected;
+  }
+
  protected:
   // same as size() but returns uint32_t to avoid type convertions
   uint32_t count() const noexcept { return count_; }
 
  private:
+  std::vector<bstring> bounds_; // column bounds followed by blocks bounds
   compression::decompressor::ptr decomp_;
   doc_id_t max_{ doc_limits::eof() };
   uint32_t count_{};
@@ -4366,6 +4910,39 @@ class column_iterator final
   typedef typename Column::block_t block_t;
   typedef typename block_t::iterator block_iterator_t;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns iterator over blocks [begin, end) of a 'column' which values
+  ///          may fall into [min, max]
+  //////////////////////////////////////////////////////////////////////////////
+  static irs::doc_iterator::ptr make(
+      const column_t& column,
+      const typename column_t::block_ref* begin,
+      const typename column_t::block_ref* end,
+      const bytes_ref& min,
+      const bytes_ref& max) {
+    if (column.empty()) {
+      return irs::doc_iterator::empty();
+    }
+
+    const size_t blocks_count = std::distance(begin, end);
+    bitset blocks;
+    const auto selected = column.select_blocks(min, max, blocks_count, blocks);
+
+    if (!selected) {
+      return irs::doc_iterator::empty();
+    }
+
+    if (selected == blocks_count) {
+      return memory::make_managed<column_iterator>(column, begin, end);
+    }
+
+    // assume documents are evenly distributed among blocks
+    const auto cost = math::div_ceil64(column.size()*selected, blocks_count);
+
+    return memory::make_managed<column_iterator>(
+      column, begin, end, std::move(blocks), cost);
+  }
+
   explicit column_iterator(
       const column_t& column,
       const typename column_t::block_ref* begin,
@@ -4383,6 +4960,22 @@ class column_iterator final
       column_(&column) {
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief iterator over blocks [begin, end) marked in 'blocks'
+  //////////////////////////////////////////////////////////////////////////////
+  column_iterator(
+      const column_t& column,
+      const typename column_t::block_ref* begin,
+      const typename column_t::block_ref* end,
+      bitset&& blocks,
+      cost::cost_t cost)
+    : column_iterator(column, begin, end) {
+    assert(blocks.size() == size_t(std::distance(begin, end)));
+    blocks_ = std::move(blocks);
+    blocks_begin_ = begin;
+    cost_.value(cost);
+  }
+
   virtual doc_id_t value() const noexcept override {
     return doc_.value;
   }
@@ -4419,6 +5012,13 @@ class column_iterator final
   typedef typename column_t::refs_t refs_t;
 
   bool next_block() {
+    if (blocks_.size()) {
+      // skip blocks which values are outside of the requested range
+      while (begin_ != end_ && !blocks_.test(size_t(begin_ - blocks_begin_))) {
+        ++begin_;
+      }
+    }
+
     if (begin_ == end_) {
       // reached the end of the column
       block_.seal();
@@ -4430,10 +5030,12 @@ class column_iterator final
     }
 
     try {
-      const auto& cached = load_block(*column_->ctxs_, column_->decompressor(), column_->encrypted(), *begin_);
+      auto cached = load_block(*column_->ctxs_, column_->decompressor(), column_->encrypted(), *begin_);
+      assert(cached);
 
-      if (block_ != cached) {
-        block_.reset(cached, payload_);
+      if (block_ != *cached) {
+        block_.reset(*cached, payload_);
+        cached_ = std::move(cached);
       }
     } catch (...) {
       // unable to load block, seal the iterator
@@ -4450,6 +5052,7 @@ class column_iterator final
     return true;
   }
 
+  std::shared_ptr<const block_t> cached_; // keeps current block alive
   block_iterator_t block_;
   irs::payload payload_;
   irs::document doc_;
@@ -4458,9 +5061,12 @@ class column_iterator final
   const typename column_t::block_ref* begin_;
   const typename column_t::block_ref* seek_origin_;
   const typename column_t::block_ref* end_;
+  const typename column_t::block_ref* blocks_begin_{};
   const column_t* column_;
+  bitset blocks_; // blocks to iterate over, empty - all blocks
 }; // column_iterator
 
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                           Columns
 // -----------------------------------------------------------------------------
@@ -4471,8 +5077,11 @@ if (column.empty()) {
     return columnstore_reader::empty_reader();
   }
 
-  return [&column](doc_id_t key, bytes_ref& value) {
-    return column.value(key, value);
+  // keeps block referenced by the last returned value alive
+  std::shared_ptr<const void> holder;
+
+  return [&column, holder](doc_id_t key, bytes_ref& value) mutable {
+    return column.value(key, value, holder);
   };
 }
 
@@ -4550,7 +5159,7 @@ class sparse_column final : public column {
     refs_ = std::move(refs);
   }
 
-  bool value(doc_id_t key, bytes_ref& value) const {
+  bool value(doc_id_t key, bytes_ref& value, std::shared_ptr<const void>& holder) const {
     // find the right block
     const auto rbegin = refs_.rbegin(); // upper bound
     const auto rend = refs_.rend();
@@ -4564,17 +5173,21 @@ class sparse_column final : public column {
       return false;
     }
 
-    const auto& cached = load_block(*ctxs_, decompressor(), encrypted(), *it);
+    auto cached = load_block(*ctxs_, decompressor(), encrypted(), *it);
+    assert(cached);
 
-    return cached.value(key, value);
+    const bool found = cached->value(key, value);
+    holder = std::move(cached);
+    return found;
   }
 
   virtual bool visit(
       const columnstore_reader::values_visitor_f& visitor
   ) const override {
     block_t block; // don't cache new blocks
+    std::shared_ptr<const void> holder;
     for (auto begin = refs_.begin(), end = refs_.end()-1; begin != end; ++begin) { // -1 for upper bound
-      const auto& cached = load_block(*ctxs_, decompressor(), encrypted(), *begin, block);
+      const auto& cached = load_block(*ctxs_, decompressor(), encrypted(), *begin, block, holder);
 
       if (!cached.visit(visitor)) {
         return false;
@@ -4596,6 +5209,16 @@ class sparse_column final : public column {
       refs_.data() + refs_.size() - 1); // -1 for upper bound
   }
 
+  virtual irs::doc_iterator::ptr iterator(
+      const bytes_ref& min,
+      const bytes_ref& max) const override {
+    return column_iterator<column_t>::make(
+      *this,
+      refs_.data(),
+      refs_.data() + refs_.size() - 1, // -1 for upper bound
+      min, max);
+  }
+
   virtual columnstore_reader::values_reader_f values() const override {
     return column_values<column_t>(*this);
   }
@@ -4734,7 +5357,7 @@ class dense_fixed_offset_column final : public column {
     min_ = this->max() - this->count() + 1;
   }
 
-  bool value(doc_id_t key, bytes_ref& value) const {
+  bool value(doc_id_t key, bytes_ref& value, std::shared_ptr<const void>& holder) const {
     const auto base_key = key - min_;
 
     if (base_key >= this->count()) {
@@ -4746,15 +5369,19 @@ class dense_fixed_offset_column final : public column {
 
     auto& ref = const_cast<block_ref&>(refs_[block_idx]);
 
-    const auto& cached = load_block(*ctxs_, decompressor(), encrypted(), ref);
+    auto cached = load_block(*ctxs_, decompressor(), encrypted(), ref);
+    assert(cached);
 
-    return cached.value(key, value);
+    const bool found = cached->value(key, value);
+    holder = std::move(cached);
+    return found;
   }
 
   virtual bool visit(const columnstore_reader::values_visitor_f& visitor) const override {
     block_t block; // don't cache new blocks
+    std::shared_ptr<const void> holder;
     for (auto& ref : refs_) {
-      const auto& cached = load_block(*ctxs_, decompressor(), encrypted(), ref, block);
+      const auto& cached = load_block(*ctxs_, decompressor(), encrypted(), ref, block, holder);
 
       if (!cached.visit(visitor)) {
         return false;
@@ -4777,6 +5404,16 @@ class dense_fixed_offset_column final : public column {
       refs_.data() + refs_.size());
   }
 
+  virtual irs::doc_iterator::ptr iterator(
+      const bytes_ref& min,
+      const bytes_ref& max) const override {
+    return column_iterator<column_t>::make(
+      *this,
+      refs_.data(),
+      refs_.data() + refs_.size(),
+      min, max);
+  }
+
   virtual columnstore_reader::values_reader_f values() const override {
     return column_values<column_t>(*this);
   }
@@ -4897,7 +5534,7 @@ class dense_fixed_offset_column<dense_mask_block> final : public column {
     min_ = this->max() - this->count();
   }
 
-  bool value(doc_id_t key, bytes_ref& value) const noexcept {
+  bool value(doc_id_t key, bytes_ref& value, std::shared_ptr<const void>& /*holder*/) const noexcept {
     value = bytes_ref::NIL;
     return key > min_ && key <= this->max();
   }
@@ -5157,6 +5794,10 @@ bool reader::prepare(const directory& dir, const segment_meta& meta) {
 
     try {
       column->read(*stream, buf, decomp);
+
+      if (version >= writer::FORMAT_BLOCK_BOUNDS) {
+        column->read_bounds(*stream);
+      }
     } catch (...) {
       IR_FRMT_ERROR("Failed to load column id=" IR_SIZE_T_SPECIFIER, i);
 
@@ -5203,6 +5844,8 @@ class postings_reader_base : public irs::postings_reader {
   index_input::ptr doc_in_;
   index_input::ptr pos_in_;
   index_input::ptr pay_in_;
+  int32_t postings_version_{};
+  int32_t terms_version_{};
 }; // postings_reader
 
 void postings_reader_base::prepare(
@@ -5212,7 +5855,7 @@ void postings_reader_base::prepare(
   std::string buf;
 
   // prepare document input
-  prepare_input(
+  postings_version_ = prepare_input(
     buf, doc_in_, irs::IOAdvice::RANDOM, state,
     postings_writer_base::DOC_EXT,
     postings_writer_base::DOC_FORMAT_NAME,
@@ -5264,7 +5907,7 @@ void postings_reader_base::prepare(
   }
 
   // check postings format
-  format_utils::check_header(in,
+  terms_version_ = format_utils::check_header(in,
     postings_writer_base::TERMS_FORMAT_NAME,
     postings_writer_base::TERMS_FORMAT_MIN,
     postings_writer_base::TERMS_FORMAT_MAX
@@ -5295,8 +5938,15 @@ size_t postings_reader_base::decode(
   const auto* p = in;
 
   term_meta.docs_count = vread<uint32_t>(p);
+  term_meta.max_freq = 0;
   if (term_freq) {
     term_freq->value = term_meta.docs_count + vread<uint32_t>(p);
+
+    if (terms_version_ >= postings_writer_base::TERMS_FORMAT_MAX_FREQ) {
+      term_meta.max_freq = term_meta.docs_count > 1
+        ? vread<uint32_t>(p)
+        : term_freq->value;
+    }
   }
 
   term_meta.doc_start += vread<uint64_t>(p);
@@ -5343,7 +5993,8 @@ class postings_reader final: public postings_reader_base {
       const attribute_provider& attrs,
       const ::features& features) {
     auto it = memory::make_managed<doc_iterator<IteratorTraits>>();
-    it->prepare(features, attrs, doc_in_.get(), pos_in_.get(), pay_in_.get());
+    it->prepare(features, attrs, doc_in_.get(), pos_in_.get(), pay_in_.get(),
+                postings_version_ >= postings_writer_base::FORMAT_BLOCK_MAX);
 
     return it;
   }
@@ -5417,7 +6068,7 @@ class format10 : public irs::version10::format {
   virtual segment_meta_writer::ptr get_segment_meta_writer() const override;
   virtual segment_meta_reader::ptr get_segment_meta_reader() const override final;
 
-  virtual document_mask_writer::ptr get_document_mask_writer() const override final;
+  virtual document_mask_writer::ptr get_document_mask_writer() const override;
   virtual document_mask_reader::ptr get_document_mask_reader() const override final;
 
   virtual field_writer::ptr get_field_writer(bool volatile_state) const override;
@@ -5466,7 +6117,7 @@ segment_meta_reader::ptr format10::get_segment_meta_reader() const {
 
 document_mask_writer::ptr format10::get_document_mask_writer() const {
   // can reuse stateless writer
-  static ::document_mask_writer INSTANCE;
+  static ::document_mask_writer INSTANCE(::document_mask_writer::FORMAT_MIN);
 
   return memory::to_managed<irs::document_mask_writer, false>(&INSTANCE);
 }
@@ -5547,7 +6198,7 @@ class format11 : public format10 {
 
   virtual index_meta_writer::ptr get_index_meta_writer() const override final;
 
-  virtual field_writer::ptr get_field_writer(bool volatile_state) const override final;
+  virtual field_writer::ptr get_field_writer(bool volatile_state) const override;
 
   virtual segment_meta_writer::ptr get_segment_meta_writer() const override final;
 
@@ -5568,7 +6219,7 @@ field_writer::ptr format11::get_field_writer(bool volatile_state) const {
   return memory::make_unique<burst_trie::field_writer>(
     get_postings_writer(volatile_state),
     volatile_state,
-    int32_t(burst_trie::field_writer::FORMAT_MAX));
+    int32_t(burst_trie::field_writer::FORMAT_MIN + 1));
 }
 
 segment_meta_writer::ptr format11::get_segment_meta_writer() const {
@@ -5607,7 +6258,7 @@ class format12 : public format11 {
 
   format12() noexcept : format11(irs::type<format12>::get()) { }
 
-  virtual columnstore_writer::ptr get_columnstore_writer() const override final;
+  virtual columnstore_writer::ptr get_columnstore_writer() const override;
 
  protected:
   explicit format12(const irs::type_info& type) noexcept
@@ -5617,7 +6268,7 @@ class format12 : public format11 {
 
 columnstore_writer::ptr format12::get_columnstore_writer() const {
   return memory::make_unique<columns::writer>(
-    int32_t(columns::writer::FORMAT_MAX)
+    int32_t(columns::writer::FORMAT_MIN + 1)
   );
 }
 
@@ -5677,6 +6328,70 @@ irs::postings_reader::ptr format13::get_postings_reader() const {
 
 REGISTER_FORMAT_MODULE(::format13, MODULE_NAME);
 
+// ----------------------------------------------------------------------------
+// --SECTION--                                                         format14
+// ----------------------------------------------------------------------------
+
+class format14 : public format13 {
+ public:
+  static constexpr string_ref type_name() noexcept {
+    return "1_4";
+  }
+
+  DECLARE_FACTORY();
+
+  format14() noexcept : format13(irs::type<format14>::get()) { }
+
+  virtual columnstore_writer::ptr get_columnstore_writer() const override final;
+  virtual document_mask_writer::ptr get_document_mask_writer() const override final;
+  virtual field_writer::ptr get_field_writer(bool volatile_state) const override final;
+  virtual irs::postings_writer::ptr get_postings_writer(bool volatile_state) const override;
+
+ protected:
+  explicit format14(const irs::type_info& type) noexcept
+    : format13(type) {
+  }
+}; // format14
+
+columnstore_writer::ptr format14::get_columnstore_writer() const {
+  return memory::make_unique<columns::writer>(
+    int32_t(columns::writer::FORMAT_BLOCK_BOUNDS)
+  );
+}
+
+document_mask_writer::ptr format14::get_document_mask_writer() const {
+  // can reuse stateless writer
+  static ::document_mask_writer INSTANCE(::document_mask_writer::FORMAT_BITSET);
+
+  return memory::to_managed<irs::document_mask_writer, false>(&INSTANCE);
+}
+
+field_writer::ptr format14::get_field_writer(bool volatile_state) const {
+  return memory::make_unique<burst_trie::field_writer>(
+    get_postings_writer(volatile_state),
+    volatile_state,
+    int32_t(burst_trie::field_writer::FORMAT_FST_SIZE));
+}
+
+irs::postings_writer::ptr format14::get_postings_writer(bool volatile_state) const {
+  constexpr const auto VERSION = postings_writer_base::FORMAT_BLOCK_MAX;
+
+  if (volatile_state) {
+    return memory::make_unique<::postings_writer<format_traits, true>>(VERSION);
+  }
+
+  return memory::make_unique<::postings_writer<format_traits, false>>(VERSION);
+}
+
+/*static*/ irs::format::ptr format14::make() {
+  static const ::format14 INSTANCE;
+
+  // aliasing constructor
+  return irs::format::ptr(irs::format::ptr(), &INSTANCE);
+}
+
+REGISTER_FORMAT_MODULE(::format14, MODULE_NAME);
+
 // ----------------------------------------------------------------------------
 // --SECTION--                                                      format12sse
 // ----------------------------------------------------------------------------
@@ -5780,6 +6495,47 @@ irs::postings_reader::ptr format13simd::get_postings_reader() const {
 
 REGISTER_FORMAT_MODULE(::format13simd, MODULE_NAME);
 
+// ----------------------------------------------------------------------------
+// --SECTION--                                                      format14sse
+// ----------------------------------------------------------------------------
+
+class format14simd final : public format14 {
+ public:
+  static constexpr string_ref type_name() noexcept {
+    return "1_4simd";
+  }
+
+  DECLARE_FACTORY();
+
+  format14simd() noexcept : format14(irs::type<format14simd>::get()) { }
+
+  virtual irs::postings_writer::ptr get_postings_writer(bool volatile_state) const override;
+  virtual irs::postings_reader::ptr get_postings_reader() const override;
+}; // format14simd
+
+irs::postings_writer::ptr format14simd::get_postings_writer(bool volatile_state) const {
+  constexpr const auto VERSION = postings_writer_base::FORMAT_SSE_BLOCK_MAX;
+
+  if (volatile_state) {
+    return memory::make_unique<::postings_writer<format_traits_simd, true>>(VERSION);
+  }
+
+  return memory::make_unique<::postings_writer<format_traits_simd, false>>(VERSION);
+}
+
+irs::postings_reader::ptr format14simd::get_postings_reader() const {
+  return memory::make_unique<::postings_reader<format_traits_simd, false>>();
+}
+
+/*static*/ irs::format::ptr format14simd::make() {
+  static const ::format14simd INSTANCE;
+
+  // aliasing constructor
+  return irs::format::ptr(irs::format::ptr(), &INSTANCE);
+}
+
+REGISTER_FORMAT_MODULE(::format14simd, MODULE_NAME);
+
 #endif // IRESEARCH_SSE2
 
 NS_END
@@ -5793,9 +6549,11 @@ void init() {
   REGISTER_FORMAT(::format11);
   REGISTER_FORMAT(::format12);
   REGISTER_FORMAT(::format13);
+  REGISTER_FORMAT(::format14);
 #ifdef IRESEARCH_SSE2
   REGISTER_FORMAT(::format12simd);
   REGISTER_FORMAT(::format13simd);
+  REGISTER_FORMAT(::format14simd);
 #endif // IRESEARCH_SSE2
 #endif
 }
@@ -5808,6 +6566,31 @@ format::format(const irs::type_info& type) noexcept
   : irs::format(type) {
 }
 
+// ----------------------------------------------------------------------------
+// --SECTION--                                                columnstore cache
+// ----------------------------------------------------------------------------
+
+void columnstore_cache_capacity(size_t capacity) {
+  ::columns::shared_block_cache().capacity(capacity);
+}
+
+size_t columnstore_cache_capacity() {
+  return ::columns::shared_block_cache().capacity();
+}
+
+columnstore_cache_stats get_columnstore_cache_stats() {
+  const auto stats = ::columns::shared_block_cache().get_stats();
+
+  columnstore_cache_stats result;
+  result.capacity = stats.capacity;
+  result.size = stats.charge;
+  result.blocks = stats.count;
+  result.hits = stats.hits;
+  result.misses = stats.misses;
+
+  return result;
+}
+
 NS_END // version10
 
 // use base irs::position type for ancestors
@@ -30,6 +30,37 @@ NS_BEGIN(version10)
 
 void init();
 
+//////////////////////////////////////////////////////////////////////////////
+/// @struct columnstore_cache_stats
+/// @brief statistics of the process-wide cache of decompressed columnstore
+///        blocks shared by all columnstore readers
+//////////////////////////////////////////////////////////////////////////////
+struct columnstore_cache_stats {
+  size_t capacity{}; // max size of cached blocks in bytes
+  size_t size{}; // size of cached blocks in bytes
+  size_t blocks{}; // number of cached blocks
+  uint64_t hits{};
+  uint64_t misses{};
+};
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief sets max size (in bytes) of decompressed columnstore blocks cached
+///        across all columnstore readers, blocks are evicted in LRU order
+/// @note 0 disables the shared cache (default), then every columnstore reader
+///       keeps all blocks it has ever read until it's closed
+//////////////////////////////////////////////////////////////////////////////
+IRESEARCH_PLUGIN void columnstore_cache_capacity(size_t capacity);
+
+//////////////////////////////////////////////////////////////////////////////
+/// @returns max size (in bytes) of the shared columnstore cache
+//////////////////////////////////////////////////////////////////////////////
+IRESEARCH_PLUGIN size_t columnstore_cache_capacity();
+
+//////////////////////////////////////////////////////////////////////////////
+/// @returns current statistics of the shared columnstore cache
+//////////////////////////////////////////////////////////////////////////////
+IRESEARCH_PLUGIN columnstore_cache_stats get_columnstore_cache_stats();
+
 //////////////////////////////////////////////////////////////////////////////
 /// @class format
 //////////////////////////////////////////////////////////////////////////////
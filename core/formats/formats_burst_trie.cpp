@@ -615,9 +615,9 @@ class term_iterator_base
     return owner_->field_;
   }
 
-  fst_t& fst() const noexcept {
-    assert(owner_ && owner_->fst_);
-    return *owner_->fst_;
+  fst_t& fst() const {
+    assert(owner_);
+    return owner_->fst();
   }
 
   const term_reader* owner_;
@@ -762,7 +762,7 @@ class term_iterator final : public term_iterator_base {
 class automaton_term_iterator final : public term_iterator_base {
  public:
   explicit automaton_term_iterator(const term_reader& owner,
-                                   automaton_table_matcher& matcher)
+                                   const automaton_table_matcher& matcher)
     : term_iterator_base(owner, &payload_),
       acceptor_(&matcher.GetFst()),
       matcher_(&matcher) {
@@ -903,7 +903,7 @@ class automaton_term_iterator final : public term_iterator_base {
   }
 
   const automaton* acceptor_;
-  automaton_table_matcher* matcher_;
+  const automaton_table_matcher* matcher_;
   block_stack_t block_stack_;
   block_iterator* cur_block_{};
   automaton::Weight::PayloadType payload_value_;
@@ -959,23 +959,19 @@ bool automaton_term_iterator::next() {
 
       assert(*begin == arc->ilabel || fst::fsa::kRho == arc->ilabel);
       state = arc->nextstate;
-
-#ifdef IRESEARCH_DEBUG
-      matcher_->SetState(cur_block_->acceptor_state());
-      assert(matcher_->Find(*begin));
-      assert(matcher_->Value().nextstate == state);
-#endif
+      assert(matcher_->Transition(cur_block_->acceptor_state(), *begin) == state);
 
       ++begin; // already match first suffix label
 
-      for (matcher_->SetState(state); begin < end; ++begin) {
-        if (!matcher_->Find(*begin)) {
+      // use plain table lookups rather than SetState(...)/Find(...)
+      // since that's the innermost loop of the intersection
+      for (; begin < end; ++begin) {
+        state = matcher_->Transition(state, *begin);
+
+        if (fst::kNoStateId == state) {
           // suffix doesn't match
           return;
         }
-
-        state = matcher_->Value().nextstate;
-        matcher_->SetState(state);
       }
     }
 
@@ -1697,7 +1693,8 @@ term_reader::term_reader(term_reader&& rhs) noexcept
     doc_freq_(rhs.doc_freq_),
     term_freq_(rhs.term_freq_),
     field_(std::move(rhs.field_)),
-    fst_(std::move(rhs.fst_)),
+    fst_(rhs.fst_.exchange(nullptr)),
+    fst_offset_(rhs.fst_offset_),
     owner_(rhs.owner_) {
   min_term_ref_ = min_term_;
   max_term_ref_ = max_term_;
@@ -1707,7 +1704,7 @@ term_reader::term_reader(term_reader&& rhs) noexcept
   rhs.doc_count_ = 0;
   rhs.doc_freq_ = 0;
   rhs.term_freq_ = 0;
-  rhs.fst_ = nullptr;
+  rhs.fst_offset_ = 0;
   rhs.owner_ = nullptr;
 }
 
@@ -1715,14 +1712,15 @@ seek_term_iterator::ptr term_reader::iterator() const {
   return memory::make_managed<detail::term_iterator>(*this);
 }
 
-seek_term_iterator::ptr term_reader::iterator(automaton_table_matcher& matcher) const {
+seek_term_iterator::ptr term_reader::iterator(const automaton_table_matcher& matcher) const {
   return memory::make_managed<detail::automaton_term_iterator>(*this, matcher);
 }
 
 void term_reader::prepare(
-    std::istream& in, 
+    std::istream& in,
     const feature_map_t& feature_map,
-    field_reader& owner) {
+    field_reader& owner,
+    int32_t version) {
   // read field metadata
   index_input& meta_in = *static_cast<input_buf*>(in.rdbuf());
   field_.name = read_string<std::string>(meta_in);
@@ -1743,20 +1741,78 @@ void term_reader::prepare(
     pfreq_ = &freq_;
   }
 
+  owner_ = &owner;
+
+  if (version >= field_writer::FORMAT_FST_SIZE) {
+    // skip FST, it's loaded on first access
+    const uint64_t fst_size = meta_in.read_vlong();
+    fst_offset_ = meta_in.file_pointer();
+    meta_in.seek(fst_offset_ + fst_size);
+    return;
+  }
+
   // read FST
-  fst_ = fst_t::Read(in, fst_read_options());
+  auto* fst = fst_t::Read(in, fst_read_options());
 
-  if (!fst_) {
+  if (!fst) {
     throw irs::index_error(string_utils::to_string(
       "failed to read term index for field '%s'",
       field_.name.c_str()));
   }
 
-  owner_ = &owner;
+  fst_.store(fst, std::memory_order_relaxed);
+}
+
+term_reader::fst_t& term_reader::fst() const {
+  auto* fst = fst_.load(std::memory_order_acquire);
+
+  if (!fst) {
+    fst = load_fst();
+  }
+
+  assert(fst);
+  return *fst;
+}
+
+term_reader::fst_t* term_reader::load_fst() const {
+  assert(owner_);
+  SCOPED_LOCK(owner_->index_in_mutex_);
+
+  // FST might have been loaded by another thread
+  auto* fst = fst_.load(std::memory_order_relaxed);
+
+  if (fst) {
+    return fst;
+  }
+
+  auto& index_in = owner_->index_in_;
+
+  if (!index_in) {
+    throw irs::index_error(string_utils::to_string(
+      "term index input is not available for field '%s'",
+      field_.name.c_str()));
+  }
+
+  index_in->seek(fst_offset_);
+
+  input_buf isb(index_in.get());
+  std::istream input(&isb); // wrap stream to be OpenFST compliant
+
+  fst = fst_t::Read(input, fst_read_options());
+
+  if (!fst) {
+    throw irs::index_error(string_utils::to_string(
+      "failed to read term index for field '%s'",
+      field_.name.c_str()));
+  }
+
+  fst_.store(fst, std::memory_order_release);
+
+  return fst;
 }
 
 term_reader::~term_reader() {
-  delete fst_;
+  delete fst_.load(std::memory_order_relaxed);
 }
 
 attribute* term_reader::get_mutable(type_info::type_id type) noexcept {
@@ -1770,7 +1826,7 @@ attribute* term_reader::get_mutable(type_info::type_id type) noexcept {
 class term_reader_visitor {
  public:
   explicit term_reader_visitor(const term_reader& field)
-    : fst_(field.fst_),
+    : fst_(&field.fst()),
       terms_in_(field.owner_->terms_in_->reopen()),
       terms_in_cipher_(field.owner_->terms_in_cipher_.get()) {
   }
@@ -2150,6 +2206,7 @@ field_writer::field_writer(
     uint32_t max_block_size /* = DEFAULT_MAX_BLOCK_SIZE */)
   : suffix_(memory_allocator::global()),
     stats_(memory_allocator::global()),
+    fst_out_(memory_allocator::global()),
     pw_(std::move(pw)),
     fst_buf_(new detail::fst_buffer()),
     prefixes_(DEFAULT_SIZE, 0),
@@ -2364,9 +2421,27 @@ void field_writer::end_field(
   }
 
   // write FST
-  output_buf isb(index_out_.get()); // wrap stream to be OpenFST compliant
-  std::ostream os(&isb);
-  fst.Write(os, fst_write_options());
+  if (version_ >= FORMAT_FST_SIZE) {
+    // prefix FST with its size to be able to skip it while reading
+    fst_out_.stream.reset();
+
+    {
+      output_buf isb(&fst_out_.stream); // wrap stream to be OpenFST compliant
+      std::ostream os(&isb);
+      fst.Write(os, fst_write_options());
+    }
+
+    fst_out_.stream.flush();
+    index_out_->write_vlong(fst_out_.stream.file_pointer());
+    fst_out_.file.visit([this](const irs::byte_type* b, size_t len) {
+      index_out_->write_bytes(b, len);
+      return true;
+    });
+  } else {
+    output_buf isb(index_out_.get()); // wrap stream to be OpenFST compliant
+    std::ostream os(&isb);
+    fst.Write(os, fst_write_options());
+  }
 
   stack_.clear();
   ++fields_count_;
@@ -2483,7 +2558,7 @@ void field_reader::prepare(
     fields_.emplace_back();
     auto& field = fields_.back();
 
-    field.prepare(input, feature_map, *this);
+    field.prepare(input, feature_map, *this, term_index_version);
 
     const auto& name = field.meta().name;
     const auto res = name_to_field_.emplace(
@@ -2511,6 +2586,12 @@ void field_reader::prepare(
       meta.name.c_str()));
   }
 
+  if (term_index_version >= field_writer::FORMAT_FST_SIZE) {
+    // retain term index input for loading FSTs on demand
+    index_in_cipher_ = std::move(index_in_cipher);
+    index_in_ = std::move(index_in);
+  }
+
   //-----------------------------------------------------------------
   // prepare terms input
   //-----------------------------------------------------------------
@@ -23,7 +23,9 @@
 #ifndef IRESEARCH_FORMAT_BURST_TRIE_H
 #define IRESEARCH_FORMAT_BURST_TRIE_H
 
+#include <atomic>
 #include <list>
+#include <mutex>
 
 #include "formats.hpp"
 #include "formats_10_attributes.hpp"
@@ -244,10 +246,14 @@ class term_reader : public irs::term_reader,
   term_reader(term_reader&& rhs) noexcept;
   virtual ~term_reader();
 
-  void prepare(std::istream& in, const feature_map_t& features, field_reader& owner);
+  void prepare(
+    std::istream& in,
+    const feature_map_t& features,
+    field_reader& owner,
+    int32_t version);
 
   virtual seek_term_iterator::ptr iterator() const override;
-  virtual seek_term_iterator::ptr iterator(automaton_table_matcher& matcher) const override;
+  virtual seek_term_iterator::ptr iterator(const automaton_table_matcher& matcher) const override;
   virtual const field_meta& meta() const noexcept override { return field_; }
   virtual size_t size() const noexcept override { return terms_count_; }
   virtual uint64_t docs_count() const noexcept override { return doc_count_; }
@@ -260,6 +266,13 @@ class term_reader : public irs::term_reader,
   friend class term_iterator_base;
   friend class term_reader_visitor;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns term index of the field, the index is loaded on first access
+  ///          in case it wasn't read while preparing the reader
+  //////////////////////////////////////////////////////////////////////////////
+  fst_t& fst() const;
+  fst_t* load_fst() const;
+
   bstring min_term_;
   bstring max_term_;
   bytes_ref min_term_ref_;
@@ -271,7 +284,8 @@ class term_reader : public irs::term_reader,
   frequency freq_; // total term freq
   frequency* pfreq_{};
   field_meta field_;
-  fst_t* fst_{}; // TODO: use compact fst here!!!
+  mutable std::atomic<fst_t*> fst_{}; // TODO: use compact fst here!!!
+  uint64_t fst_offset_{}; // offset of the term index in the index input
   field_reader* owner_;
 }; // term_reader
 
@@ -291,7 +305,12 @@ NS_END // detail
 class field_writer final : public irs::field_writer {
  public:
   static const int32_t FORMAT_MIN = 0;
-  static const int32_t FORMAT_MAX = 1;
+
+  // term index of each field is prefixed with its size, that allows
+  // to load term indices of fields lazily
+  static const int32_t FORMAT_FST_SIZE = 2;
+
+  static const int32_t FORMAT_MAX = FORMAT_FST_SIZE;
 
   static const uint32_t DEFAULT_MIN_BLOCK_SIZE = 25;
   static const uint32_t DEFAULT_MAX_BLOCK_SIZE = 48;
@@ -361,6 +380,7 @@ class field_writer final : public irs::field_writer {
   std::unordered_map<type_info::type_id, size_t> feature_map_;
   memory_output suffix_; // term suffix column
   memory_output stats_; // term stats column
+  memory_output fst_out_; // serialized term index of a field
   encryption::stream::ptr terms_out_cipher_;
   index_output::ptr terms_out_; // output stream for terms
   encryption::stream::ptr index_out_cipher_;
@@ -398,6 +418,7 @@ class field_reader final : public irs::field_reader {
 
  private:
   friend class detail::term_iterator_base;
+  friend class detail::term_reader;
   friend class detail::term_reader_visitor;
 
   std::vector<detail::term_reader> fields_;
@@ -406,6 +427,9 @@ class field_reader final : public irs::field_reader {
   irs::postings_reader::ptr pr_;
   encryption::stream::ptr terms_in_cipher_;
   index_input::ptr terms_in_;
+  encryption::stream::ptr index_in_cipher_;
+  index_input::ptr index_in_; // term index input used for lazy loading
+  std::mutex index_in_mutex_; // guards 'index_in_'
 }; // field_reader
 
 NS_END // burst_trie
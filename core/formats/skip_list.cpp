@@ -351,6 +351,8 @@ void skip_reader::load_level(levels_t& levels, index_input::ptr&& stream, size_t
 void skip_reader::prepare(index_input::ptr&& in, const read_f& read /* = nop */) {
   assert(in && read);
 
+  const auto skip_start = in->file_pointer();
+
   // read number of levels in a skip-list
   size_t max_levels = in->read_vint();
 
@@ -374,6 +376,10 @@ void skip_reader::prepare(index_input::ptr&& in, const read_f& read /* = nop */)
     load_level(levels, std::move(in), skip_0_);
     levels.back().child = UNDEFINED;
 
+    // levels are stored contiguously and traversed
+    // from the top, so request all of them at once
+    levels.back().stream->prefetch(skip_start, levels.back().end - skip_start);
+
     levels_ = std::move(levels);
   }
 
@@ -219,6 +219,9 @@ class IRESEARCH_API skip_reader: util::noncopyable {
     bool eof() const override;
     void seek(size_t pos) override;
     int64_t checksum(size_t offset) const override;
+    void prefetch(size_t offset, size_t size) noexcept override {
+      stream->prefetch(begin + offset, size);
+    }
 
     index_input::ptr stream; // level data stream
     uint64_t begin; // where current level starts
@@ -37,20 +37,31 @@ class column_info {
  public:
   column_info(const type_info& compression,
               const compression::options& options,
-              bool encryption) noexcept
+              bool encryption,
+              size_t block_size = 0) noexcept
     : compression_(compression),
       options_(options),
-      encryption_(encryption) {
+      encryption_(encryption),
+      block_size_(block_size) {
   }
 
   const type_info& compression() const noexcept { return compression_; }
   const compression::options& options() const noexcept { return options_; }
   bool encryption() const noexcept { return encryption_; }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns size of a data block the column is compressed by,
+  ///          0 stands for the columnstore default
+  /// @note larger blocks compress better at the cost of reading and
+  ///       decompressing more data on every random access
+  //////////////////////////////////////////////////////////////////////////////
+  size_t block_size() const noexcept { return block_size_; }
+
  private:
   const type_info compression_;
   const compression::options options_;
   bool encryption_;
+  size_t block_size_;
 }; // column_info
 
 typedef std::function<column_info(const string_ref)> column_info_provider_t;
@@ -0,0 +1,203 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "consolidation_scheduler.hpp"
+
+#include <algorithm>
+
+#include "utils/log.hpp"
+#include "utils/thread_utils.hpp"
+
+NS_ROOT
+
+consolidation_scheduler::consolidation_scheduler(
+    index_writer::ptr writer,
+    options&& opts)
+  : writer_(std::move(writer)),
+    opts_(std::move(opts)),
+    states_(opts_.policies.size(), policy_state::DUE), // evaluate on start
+    limiter_(opts_.max_write_bytes_per_sec),
+    pool_(std::max(size_t(1), opts_.max_merges),
+          std::max(size_t(1), opts_.max_merges)) {
+  assert(writer_);
+  opts_.max_merges = std::max(size_t(1), opts_.max_merges);
+  scheduler_ = std::thread(&consolidation_scheduler::run, this);
+}
+
+consolidation_scheduler::~consolidation_scheduler() {
+  try {
+    stop();
+  } catch (...) {
+    IR_LOG_EXCEPTION();
+  }
+}
+
+consolidation_scheduler::stats consolidation_scheduler::metrics() const {
+  stats result;
+
+  {
+    SCOPED_LOCK(mutex_);
+    result.pending = std::count(states_.begin(), states_.end(), policy_state::DUE);
+    result.active = active_;
+    result.merges = merges_;
+    result.failures = failures_;
+  }
+
+  result.bytes_written = limiter_.bytes();
+  result.throttled = limiter_.throttled();
+
+  return result;
+}
+
+void consolidation_scheduler::stop() {
+  {
+    SCOPED_LOCK(mutex_);
+    stop_ = true; // set under lock to avoid missing the notification
+  }
+
+  cond_.notify_all();
+  limiter_.bytes_per_sec(0); // wake up throttled merges, they're aborted by progress
+
+  if (scheduler_.joinable()) {
+    scheduler_.join();
+  }
+
+  pool_.stop(true); // wait for running merges, skip not started ones
+
+  SCOPED_LOCK(mutex_);
+  active_ = 0;
+  std::fill(states_.begin(), states_.end(), policy_state::IDLE);
+}
+
+void consolidation_scheduler::trigger() {
+  {
+    SCOPED_LOCK(mutex_);
+    triggered_ = true;
+  }
+
+  cond_.notify_all();
+}
+
+void consolidation_scheduler::merge(size_t i) {
+  assert(i < opts_.policies.size());
+  auto& policy = opts_.policies[i];
+  bool found = false; // policy selected segments which have to be merged
+  bool merged = false;
+
+  auto tracking_policy = [&policy, &found](
+      std::set<const segment_meta*>& candidates,
+      const index_meta& meta,
+      const index_writer::consolidating_segments_t& consolidating_segments) {
+    policy(candidates, meta, consolidating_segments);
+
+    // a single segment without deletes is not merged by index_writer
+    found = candidates.size() > 1
+      || (1 == candidates.size()
+          && *candidates.begin()
+          && (*candidates.begin())->live_docs_count != (*candidates.begin())->docs_count);
+
+    // segments which are already being consolidated are rejected by
+    // index_writer, treat as no work rather than a failure
+    for (auto* candidate : candidates) {
+      if (consolidating_segments.end() != consolidating_segments.find(candidate)) {
+        found = false;
+        break;
+      }
+    }
+  };
+
+  auto progress = [this]() noexcept {
+    return !stop_.load(std::memory_order_relaxed);
+  };
+
+  try {
+    merged = writer_->consolidate(tracking_policy, opts_.codec, progress, &limiter_);
+  } catch (...) {
+    IR_FRMT_ERROR("Caught exception while consolidating segments by policy '" IR_SIZE_T_SPECIFIER "'", i);
+    IR_LOG_EXCEPTION();
+  }
+
+  {
+    SCOPED_LOCK(mutex_);
+    assert(active_);
+    --active_;
+
+    if (found) {
+      merged ? ++merges_ : ++failures_;
+    }
+
+    // policy may select more segments right away after a successful merge
+    states_[i] = found && merged && !stop_ ? policy_state::DUE : policy_state::IDLE;
+  }
+
+  cond_.notify_all();
+}
+
+void consolidation_scheduler::run() {
+  using clock_t = std::chrono::steady_clock;
+
+  auto next = clock_t::now() + opts_.interval; // next evaluation of idle policies
+  size_t offset = 0; // first policy to consider, rotated for fairness
+
+  SCOPED_LOCK_NAMED(mutex_, lock);
+
+  while (!stop_) {
+    const size_t count = states_.size();
+
+    for (size_t j = 0; j < count && active_ < opts_.max_merges; ++j) {
+      const size_t i = (offset + j) % count;
+
+      if (policy_state::DUE != states_[i]) {
+        continue;
+      }
+
+      states_[i] = policy_state::ACTIVE;
+      ++active_;
+
+      if (!pool_.run([this, i]() { merge(i); })) {
+        states_[i] = policy_state::DUE;
+        --active_;
+        break;
+      }
+
+      offset = i + 1;
+    }
+
+    // woken up either by a finished merge, trigger(), stop() or a timeout
+    cond_.wait_until(lock, next);
+
+    const auto now = clock_t::now();
+
+    if (triggered_ || now >= next) {
+      triggered_ = false;
+      next = now + opts_.interval;
+
+      for (auto& state : states_) {
+        if (policy_state::IDLE == state) {
+          state = policy_state::DUE;
+        }
+      }
+    }
+  }
+}
+
+NS_END
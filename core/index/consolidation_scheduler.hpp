@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_CONSOLIDATION_SCHEDULER_H
+#define IRESEARCH_CONSOLIDATION_SCHEDULER_H
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "index_writer.hpp"
+#include "utils/async_utils.hpp"
+#include "utils/noncopyable.hpp"
+
+NS_ROOT
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class consolidation_scheduler
+/// @brief periodically evaluates consolidation policies of an index_writer and
+///        runs resulting merges in background on a bounded thread pool with
+///        an optional limit on the aggregate write bandwidth
+/// @note consolidated segments become visible after the next commit of the
+///       writer, the scheduler never commits on its own
+////////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API consolidation_scheduler : private util::noncopyable {
+ public:
+  struct options {
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief policies evaluated by the scheduler, each policy is evaluated
+    ///        by at most one merge at a time
+    ////////////////////////////////////////////////////////////////////////////
+    std::vector<index_writer::consolidation_policy_t> policies;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief format used for consolidated segments
+    ///        nullptr == use index_writer's codec
+    ////////////////////////////////////////////////////////////////////////////
+    format::ptr codec;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief delay between consecutive evaluations of idle policies
+    ////////////////////////////////////////////////////////////////////////////
+    std::chrono::milliseconds interval{1000};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief max number of merges running concurrently, 0 == 1
+    ////////////////////////////////////////////////////////////////////////////
+    size_t max_merges{1};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief max number of bytes per second written by all running merges
+    ///        0 == unlimited
+    ////////////////////////////////////////////////////////////////////////////
+    uint64_t max_write_bytes_per_sec{0};
+
+    options() {} // GCC5 requires non-default definition
+  };
+
+  struct stats {
+    size_t pending{}; // number of policies due for evaluation waiting for a free slot
+    size_t active{}; // number of running merges
+    size_t merges{}; // number of successfully finished merges
+    size_t failures{}; // number of failed or aborted merges
+    uint64_t bytes_written{}; // total number of bytes written by merges
+    std::chrono::microseconds throttled{}; // total time merges were delayed for
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief starts background evaluation of the specified policies
+  //////////////////////////////////////////////////////////////////////////////
+  consolidation_scheduler(index_writer::ptr writer, options&& opts);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief aborts running merges and waits for them to finish
+  //////////////////////////////////////////////////////////////////////////////
+  ~consolidation_scheduler();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns current state of the scheduler
+  //////////////////////////////////////////////////////////////////////////////
+  stats metrics() const;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief change the limit on the aggregate write bandwidth,
+  ///        0 == unlimited
+  //////////////////////////////////////////////////////////////////////////////
+  void max_write_bytes_per_sec(uint64_t value) noexcept {
+    limiter_.bytes_per_sec(value);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief stop scheduling new merges, aborts running merges and waits for
+  ///        them to finish
+  //////////////////////////////////////////////////////////////////////////////
+  void stop();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief evaluate all idle policies without waiting for the next interval
+  //////////////////////////////////////////////////////////////////////////////
+  void trigger();
+
+ private:
+  enum class policy_state { IDLE, DUE, ACTIVE };
+
+  void merge(size_t policy);
+  void run();
+
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  index_writer::ptr writer_;
+  options opts_;
+  std::vector<policy_state> states_; // state of each policy in 'opts_'
+  async_utils::rate_limiter limiter_;
+  mutable std::mutex mutex_;
+  std::condition_variable cond_;
+  size_t active_{}; // number of running merges
+  size_t merges_{};
+  size_t failures_{};
+  bool triggered_{};
+  std::atomic<bool> stop_{false};
+  async_utils::thread_pool pool_; // executor for merges
+  std::thread scheduler_; // thread evaluating policies
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // consolidation_scheduler
+
+NS_END
+
+#endif // IRESEARCH_CONSOLIDATION_SCHEDULER_H
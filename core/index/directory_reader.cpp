@@ -21,10 +21,14 @@
 /// @author Vasiliy Nabatchikov
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <numeric>
+
 #include "composite_reader_impl.hpp"
+#include "utils/async_utils.hpp"
 #include "utils/directory_utils.hpp"
 #include "utils/singleton.hpp"
 #include "utils/string_utils.hpp"
+#include "utils/thread_utils.hpp"
 #include "utils/type_limits.hpp"
 
 #include "directory_reader.hpp"
@@ -149,6 +153,231 @@ irs::index_file_refs::ref_t load_newest_index_meta(
 }
 MSVC_ONLY(__pragma(warning(pop)))
 
+// size of a chunk used for reading files ahead
+constexpr size_t WARMUP_BUFFER_SIZE = 65536;
+
+// -----------------------------------------------------------------------------
+// @returns kind of the specified segment file, relies on file extensions
+//          used by 1.x formats
+// -----------------------------------------------------------------------------
+irs::WarmupFiles file_kind(const std::string& filename) noexcept {
+  static const std::pair<irs::string_ref, irs::WarmupFiles> KINDS[] {
+    { "tm", irs::WarmupFiles::TERM_INDEX },
+    { "ti", irs::WarmupFiles::TERM_INDEX },
+    { "doc", irs::WarmupFiles::POSTINGS },
+    { "pos", irs::WarmupFiles::POSTINGS },
+    { "pay", irs::WarmupFiles::POSTINGS },
+    { "cs", irs::WarmupFiles::COLUMNSTORE },
+    { "cm", irs::WarmupFiles::COLUMNSTORE }
+  };
+
+  const auto pos = filename.find_last_of('.');
+
+  if (std::string::npos == pos) {
+    return irs::WarmupFiles::NONE;
+  }
+
+  const irs::string_ref ext(filename.c_str() + pos + 1, filename.size() - pos - 1);
+
+  for (auto& kind : KINDS) {
+    if (kind.first == ext) {
+      return kind.second;
+    }
+  }
+
+  return irs::WarmupFiles::NONE;
+}
+
+// -----------------------------------------------------------------------------
+// reads ahead a specified portion of a file
+// -----------------------------------------------------------------------------
+bool read_ahead(
+    const irs::directory& dir,
+    const std::string& filename,
+    uint32_t percentage,
+    irs::bstring& buf,
+    irs::warmup_stats& stats) {
+  auto in = dir.open(filename, irs::IOAdvice::SEQUENTIAL);
+
+  if (!in) {
+    IR_FRMT_WARN("Failed to open file '%s' for warmup", filename.c_str());
+    return false;
+  }
+
+  const auto length = uint64_t(in->length()) * std::min(percentage, 100U) / 100;
+
+  // let the directory preload data asynchronously (e.g. madvise, fadvise),
+  // then touch the data so that it's resident once warmup is finished
+  in->prefetch(0, length);
+
+  for (auto left = length; left; ) {
+    const auto size = std::min(left, uint64_t(buf.size()));
+    const auto read = in->read_bytes(&buf[0], size);
+
+    if (!read) {
+      break;
+    }
+
+    left -= read;
+    stats.bytes += read;
+  }
+
+  ++stats.files;
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+// warms up a single segment according to the specified options
+// -----------------------------------------------------------------------------
+void warmup_segment(
+    const irs::directory& dir,
+    const irs::segment_meta& meta,
+    const irs::sub_reader& segment,
+    const irs::warmup_options& options,
+    irs::warmup_stats& stats) {
+  if (irs::WarmupFiles::NONE != options.files && options.percentage) {
+    irs::bstring buf(WARMUP_BUFFER_SIZE, 0);
+
+    for (auto& file : meta.files) {
+      if (irs::WarmupFiles::NONE != (options.files & file_kind(file))) {
+        read_ahead(dir, file, options.percentage, buf, stats);
+      }
+    }
+  }
+
+  for (auto& name : options.fields) {
+    const auto* field = segment.field(name);
+
+    if (!field) {
+      continue;
+    }
+
+    for (auto terms = field->iterator(); terms->next(); ) {
+      ++stats.terms;
+    }
+  }
+
+  for (auto& name : options.columns) {
+    const auto* column_meta = segment.column(name);
+
+    if (!column_meta) {
+      continue;
+    }
+
+    const auto* column = segment.column_reader(column_meta->id);
+
+    if (!column) {
+      continue;
+    }
+
+    // iterating over a column loads its blocks into columnstore caches
+    for (auto it = column->iterator(); it->next(); ) {
+      ++stats.values;
+    }
+  }
+
+  ++stats.segments;
+}
+
+// -----------------------------------------------------------------------------
+// state shared between warmup tasks of a single reader
+// -----------------------------------------------------------------------------
+struct warmup_state {
+  std::mutex mutex;
+  irs::warmup_stats stats;
+  size_t pending;
+};
+
+// -----------------------------------------------------------------------------
+// warms up specified segments of a reader either in a calling thread or
+// on a pool provided by 'options'
+// -----------------------------------------------------------------------------
+irs::warmup_stats warmup(
+    const irs::directory& dir,
+    const irs::directory_meta& meta,
+    const std::shared_ptr<const irs::index_reader>& reader,
+    const std::vector<size_t>& segments,
+    const std::shared_ptr<const irs::warmup_options>& options) {
+  assert(reader && options);
+
+  auto warmup_one = [&dir, &meta](
+      const irs::index_reader& reader,
+      size_t i,
+      const irs::warmup_options& options,
+      irs::warmup_stats& stats) noexcept {
+    try {
+      warmup_segment(dir, meta.meta.segment(i).meta, reader[i], options, stats);
+    } catch (...) {
+      // warmup is best effort, reader is still usable
+      IR_FRMT_ERROR("Failed to warmup segment '%s'",
+                    meta.meta.segment(i).meta.name.c_str());
+      IR_LOG_EXCEPTION();
+    }
+  };
+
+  if (!options->pool) {
+    irs::warmup_stats stats;
+
+    for (auto i : segments) {
+      warmup_one(*reader, i, *options, stats);
+    }
+
+    if (options->done) {
+      options->done(stats);
+    }
+
+    return stats;
+  }
+
+  if (segments.empty()) {
+    if (options->done) {
+      options->done(irs::warmup_stats());
+    }
+
+    return {};
+  }
+
+  auto state = std::make_shared<warmup_state>();
+  state->pending = segments.size();
+
+  auto finish = [state, options](const irs::warmup_stats& stats) {
+    {
+      SCOPED_LOCK(state->mutex);
+      state->stats.segments += stats.segments;
+      state->stats.files += stats.files;
+      state->stats.bytes += stats.bytes;
+      state->stats.terms += stats.terms;
+      state->stats.values += stats.values;
+
+      if (--state->pending) {
+        return;
+      }
+    }
+
+    if (options->done) {
+      options->done(state->stats);
+    }
+  };
+
+  for (auto i : segments) {
+    // reader keeps its metadata alive
+    const bool scheduled = options->pool->run([warmup_one, reader, i, options, finish]() {
+      irs::warmup_stats stats;
+      warmup_one(*reader, i, *options, stats);
+      finish(stats);
+    });
+
+    if (!scheduled) {
+      IR_FRMT_WARN("Failed to schedule warmup of segment '%s'",
+                   meta.meta.segment(i).meta.name.c_str());
+      finish(irs::warmup_stats());
+    }
+  }
+
+  return {};
+}
+
 NS_END
 
 NS_ROOT
@@ -166,13 +395,19 @@ class directory_reader_impl :
 
   const directory_meta& meta() const noexcept { return meta_; }
 
+  const std::shared_ptr<const warmup_options>& warmup() const noexcept {
+    return warmup_;
+  }
+
   // open a new directory reader
   // if codec == nullptr then use the latest file for all known codecs
   // if cached != nullptr then try to reuse its segments
+  // if warmup != nullptr then warmup newly opened segments
   static index_reader::ptr open(
     const directory& dir,
     const format* codec = nullptr,
-    const index_reader::ptr& cached = nullptr
+    const index_reader::ptr& cached = nullptr,
+    std::shared_ptr<const warmup_options> warmup = nullptr
   );
 
  private:
@@ -185,12 +420,14 @@ class directory_reader_impl :
     directory_meta&& meta,
     readers_t&& readers,
     uint64_t docs_count,
-    uint64_t docs_max
+    uint64_t docs_max,
+    const std::shared_ptr<const warmup_options>& warmup
   );
 
   const directory& dir_;
   reader_file_refs_t file_refs_;
   directory_meta meta_;
+  std::shared_ptr<const warmup_options> warmup_; // applied to new segments
 }; // directory_reader_impl
 
 directory_reader::directory_reader(impl_ptr&& impl) noexcept
@@ -231,6 +468,15 @@ const directory_meta& directory_reader::meta() const {
   return directory_reader_impl::open(dir, codec.get());
 }
 
+/*static*/ directory_reader directory_reader::open(
+    const directory& dir,
+    format::ptr codec,
+    warmup_options warmup) {
+  return directory_reader_impl::open(
+    dir, codec.get(), nullptr,
+    memory::make_shared<const warmup_options>(std::move(warmup)));
+}
+
 directory_reader directory_reader::reopen(
     format::ptr codec /*= nullptr*/) const {
   // make a copy
@@ -243,10 +489,28 @@ directory_reader directory_reader::reopen(
 #endif
 
   return directory_reader_impl::open(
-    reader_impl.dir(), codec.get(), impl
+    reader_impl.dir(), codec.get(), impl, reader_impl.warmup()
   );
 }
 
+warmup_stats directory_reader::warmup(const warmup_options& options) const {
+  // make a copy
+  impl_ptr impl = atomic_utils::atomic_load(&impl_);
+
+#ifdef IRESEARCH_DEBUG
+  auto& reader_impl = dynamic_cast<const directory_reader_impl&>(*impl);
+#else
+  auto& reader_impl = static_cast<const directory_reader_impl&>(*impl);
+#endif
+
+  std::vector<size_t> segments(reader_impl.size());
+  std::iota(segments.begin(), segments.end(), 0);
+
+  return ::warmup(
+    reader_impl.dir(), reader_impl.meta(), impl, segments,
+    memory::make_shared<const warmup_options>(options));
+}
+
 // -------------------------------------------------------------------
 // directory_reader_impl
 // -------------------------------------------------------------------
@@ -257,17 +521,20 @@ directory_reader_impl::directory_reader_impl(
     directory_meta&& meta,
     readers_t&& readers,
     uint64_t docs_count,
-    uint64_t docs_max)
+    uint64_t docs_max,
+    const std::shared_ptr<const warmup_options>& warmup)
   : composite_reader(std::move(readers), docs_count, docs_max),
     dir_(dir),
     file_refs_(std::move(file_refs)),
-    meta_(std::move(meta)) {
+    meta_(std::move(meta)),
+    warmup_(warmup) {
 }
 
 /*static*/ index_reader::ptr directory_reader_impl::open(
     const directory& dir,
     const format* codec /*= nullptr*/,
-    const index_reader::ptr& cached /*= nullptr*/) {
+    const index_reader::ptr& cached /*= nullptr*/,
+    std::shared_ptr<const warmup_options> warmup /*= nullptr*/) {
   index_meta meta;
   index_file_refs::ref_t meta_file_ref = load_newest_index_meta(meta, dir, codec);
 
@@ -301,6 +568,7 @@ directory_reader_impl::directory_reader_impl(
   }
 
   readers_t readers(meta.size());
+  std::vector<size_t> opened; // segments opened from scratch
   uint64_t docs_max = 0; // overall number of documents (with deleted)
   uint64_t docs_count = 0; // number of live documents
   reader_file_refs_t file_refs(readers.size() + 1); // +1 for index_meta file refs
@@ -315,14 +583,24 @@ directory_reader_impl::directory_reader_impl(
     auto& segment = meta.segment(i).meta;
     auto& segment_file_refs = file_refs[i];
     auto itr = reuse_candidates.find(segment.name);
+    const segment_file_refs_t* cached_file_refs = nullptr;
+
+    if (itr != reuse_candidates.end() && itr->second != INVALID_CANDIDATE) {
+      // segment readers share data with readers of previous versions
+      // of the same segment, e.g. in case of removals only
+      // a document mask has to be read
+      auto& cached_reader = (*cached_impl)[itr->second];
+      reader = cached_reader.reopen(segment);
+
+      if (reader == cached_reader) {
+        // segment is unchanged, so are its files
+        cached_file_refs = &cached_impl->file_refs_[itr->second];
+      }
 
-    if (itr != reuse_candidates.end()
-        && itr->second != INVALID_CANDIDATE
-        && segment == cached_impl->meta_.meta.segment(itr->second).meta) {
-      reader = (*cached_impl)[itr->second].reopen(segment);
       reuse_candidates.erase(itr);
     } else {
       reader = segment_reader::open(dir, segment);
+      opened.push_back(i);
     }
 
     if (!reader) {
@@ -334,8 +612,13 @@ directory_reader_impl::directory_reader_impl(
 
     docs_max += reader.docs_count();
     docs_count += reader.live_docs_count();
-    directory_utils::reference(const_cast<directory&>(dir), segment, visitor, true);
-    segment_file_refs.swap(tmp_file_refs);
+
+    if (cached_file_refs) {
+      segment_file_refs = *cached_file_refs;
+    } else {
+      directory_utils::reference(const_cast<directory&>(dir), segment, visitor, true);
+      segment_file_refs.swap(tmp_file_refs);
+    }
   }
 
   directory_utils::reference(const_cast<directory&>(dir), meta, visitor, true);
@@ -355,9 +638,15 @@ directory_reader_impl::directory_reader_impl(
     std::move(dir_meta),
     std::move(readers),
     docs_count,
-    docs_max
+    docs_max,
+    warmup
   );
 
+  if (warmup && !opened.empty()) {
+    auto& reader_impl = static_cast<const directory_reader_impl&>(*reader);
+    ::warmup(dir, reader_impl.meta(), reader, opened, warmup);
+  }
+
   return reader;
 }
 
@@ -26,10 +26,85 @@
 
 #include "shared.hpp"
 #include "index_reader.hpp"
+#include "utils/bit_utils.hpp"
 #include "utils/object_pool.hpp"
 
+#include <functional>
+#include <string>
+#include <vector>
+
 NS_ROOT
 
+NS_BEGIN(async_utils)
+class thread_pool;
+NS_END
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief kinds of segment files to read ahead during a warmup
+////////////////////////////////////////////////////////////////////////////////
+enum class WarmupFiles : uint32_t {
+  NONE = 0,
+  TERM_INDEX = 1, // term dictionary and term index
+  POSTINGS = 2, // document lists, positions and payloads
+  COLUMNSTORE = 4, // stored values and columnstore index
+  ALL = 7
+}; // WarmupFiles
+
+ENABLE_BITMASK_ENUM(WarmupFiles); // enable bitmap operations on the enum
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief statistics of a finished warmup
+////////////////////////////////////////////////////////////////////////////////
+struct warmup_stats {
+  size_t segments{}; // number of warmed up segments
+  size_t files{}; // number of files read ahead
+  uint64_t bytes{}; // number of bytes read ahead
+  uint64_t terms{}; // number of enumerated terms
+  uint64_t values{}; // number of visited column values
+}; // warmup_stats
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief specifies segment data loaded into memory by a warmup, i.e. data
+///        otherwise paged in (or decompressed) by the first queries
+///        against a newly opened segment
+////////////////////////////////////////////////////////////////////////////////
+struct warmup_options {
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief segment files to read ahead, files are advised to be preloaded
+  ///        by the directory (e.g. madvise for 'mmap_directory') and then
+  ///        read sequentially
+  //////////////////////////////////////////////////////////////////////////////
+  WarmupFiles files{ WarmupFiles::TERM_INDEX };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief percentage [0..100] of each file to read ahead from its beginning
+  //////////////////////////////////////////////////////////////////////////////
+  uint32_t percentage{ 100 };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief fields whose terms are enumerated
+  //////////////////////////////////////////////////////////////////////////////
+  std::vector<std::string> fields;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief columns whose values are iterated, i.e. blocks of such columns
+  ///        are loaded into columnstore caches
+  //////////////////////////////////////////////////////////////////////////////
+  std::vector<std::string> columns;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief pool executing a warmup, one task per segment,
+  ///        nullptr - warmup is executed by the calling thread
+  /// @note pool must outlive all readers using the options
+  //////////////////////////////////////////////////////////////////////////////
+  async_utils::thread_pool* pool{};
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief invoked once a warmup of all requested segments is finished
+  //////////////////////////////////////////////////////////////////////////////
+  std::function<void(const warmup_stats&)> done;
+}; // warmup_options
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief representation of the metadata of a directory_reader
 ////////////////////////////////////////////////////////////////////////////////
@@ -108,15 +183,38 @@ class IRESEARCH_API directory_reader final
     format::ptr codec = nullptr
   );
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief create an index reader over the specified directory and warm up
+  ///        all of its segments according to the specified 'warmup' options,
+  ///        the options are applied to new segments on every 'reopen()'
+  ///        if codec == nullptr then use the latest file for all known codecs
+  ////////////////////////////////////////////////////////////////////////////////
+  static directory_reader open(
+    const directory& dir,
+    format::ptr codec,
+    warmup_options warmup
+  );
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief open a new instance based on the latest file for the specified codec
   ///        this call will atempt to reuse segments from the existing reader
   ///        if codec == nullptr then use the latest file for all known codecs
+  /// @note newly opened segments are warmed up according to the options
+  ///       specified while opening the original reader (if any)
   ////////////////////////////////////////////////////////////////////////////////
   virtual directory_reader reopen(
     format::ptr codec = nullptr
   ) const;
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief loads data of all segments specified by 'options' into memory
+  /// @returns statistics of a finished warmup or empty statistics in case
+  ///          if warmup is scheduled on 'options.pool', 'options.done' is
+  ///          invoked on completion in both cases
+  /// @note directory must outlive a scheduled warmup
+  ////////////////////////////////////////////////////////////////////////////////
+  warmup_stats warmup(const warmup_options& options) const;
+
   void reset() noexcept {
     impl_.reset();
   }
@@ -0,0 +1,209 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_DOC_ID_MAP_H
+#define IRESEARCH_DOC_ID_MAP_H
+
+#include <vector>
+
+#include "types.hpp"
+#include "utils/bit_packing.hpp"
+#include "utils/bitset.hpp"
+#include "utils/math_utils.hpp"
+#include "utils/type_limits.hpp"
+
+NS_ROOT
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class doc_id_map
+/// @brief compact mapping of document identifiers of a segment being merged
+///        to identifiers of a merged segment, masked and unknown documents
+///        are mapped to 'doc_limits::eof()'
+/// @note the mapping is stored in one of the following ways:
+///       - OFFSET: segment without deletes, documents are shifted by a base
+///       - RANK: live documents keep their order, a document is mapped to
+///         the number of live documents preceding it, i.e. 1.5 bits per
+///         document are used
+///       - PACKED: arbitrary mapping, e.g. for sorted segments, identifiers
+///         are stored in a bit-packed array
+////////////////////////////////////////////////////////////////////////////////
+class doc_id_map {
+ public:
+  doc_id_map() = default;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief maps documents [doc_limits::min(), doc_limits::min() + size)
+  ///        to [base, base + size)
+  //////////////////////////////////////////////////////////////////////////////
+  void reset(doc_id_t size, doc_id_t base) noexcept {
+    clear();
+    type_ = OFFSET;
+    size_ = size_t(size) + doc_limits::min();
+    base_ = base - doc_limits::min();
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief maps live documents produced by 'live_docs' in ascending order
+  ///        to [base, base + number of live documents)
+  /// @returns next unused document identifier
+  //////////////////////////////////////////////////////////////////////////////
+  template<typename Iterator>
+  doc_id_t reset(Iterator& live_docs, doc_id_t size, doc_id_t base) {
+    clear();
+    size_ = size_t(size) + doc_limits::min();
+
+    std::vector<word_t> words(bitset::word(size_ - 1) + 1, 0);
+    while (live_docs.next()) {
+      const auto doc = live_docs.value();
+      assert(doc < size_);
+      set_bit(words[bitset::word(doc)], bitset::bit(doc));
+    }
+
+    std::vector<doc_id_t> ranks(words.size());
+    doc_id_t rank = 0;
+    for (size_t i = 0, count = words.size(); i < count; ++i) {
+      ranks[i] = rank;
+      rank += doc_id_t(math::math_traits<word_t>::pop(words[i]));
+    }
+
+    words_ = std::move(words);
+    ranks_ = std::move(ranks);
+    type_ = RANK;
+    base_ = base;
+
+    return base + rank;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief prepares mapping of documents [0, doc_limits::min() + size) to
+  ///        identifiers not greater than 'max', all documents are mapped to
+  ///        'doc_limits::eof()' until set via 'set(...)'
+  //////////////////////////////////////////////////////////////////////////////
+  void reset_packed(doc_id_t size, doc_id_t max) {
+    assert(!doc_limits::eof(max));
+    clear();
+    size_ = size_t(size) + doc_limits::min();
+    bits_ = packed::bits_required_32(max);
+
+    // extra word allows to access values spanning two words unconditionally
+    words_.assign(bitset::word(size_*bits_) + 2, 0);
+    type_ = PACKED;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief sets mapping of a document 'doc' in PACKED mode
+  //////////////////////////////////////////////////////////////////////////////
+  void set(doc_id_t doc, doc_id_t id) noexcept {
+    assert(PACKED == type_);
+    assert(doc < size_);
+    assert(doc_limits::valid(id) && id <= packed::max_value<doc_id_t>(bits_));
+
+    const size_t offset = size_t(doc)*bits_;
+    const auto bit = bitset::bit(offset);
+    auto* word = words_.data() + bitset::word(offset);
+    const word_t mask = packed::max_value<word_t>(bits_);
+
+    word[0] = (word[0] & ~(mask << bit)) | (word_t(id) << bit);
+
+    if (bit + bits_ > bits_required<word_t>()) {
+      const auto shift = bits_required<word_t>() - bit;
+      word[1] = (word[1] & ~(mask >> shift)) | (word_t(id) >> shift);
+    }
+  }
+
+  doc_id_t operator()(doc_id_t doc) const noexcept {
+    if (doc >= size_) {
+      return doc_limits::eof();
+    }
+
+    switch (type_) {
+      case OFFSET:
+        return base_ + doc;
+      case RANK: {
+        const auto word = words_[bitset::word(doc)];
+        const auto bit = bitset::bit(doc);
+
+        if (!check_bit(word, bit)) {
+          return doc_limits::eof(); // masked document
+        }
+
+        const auto preceding = word & ~(~word_t(0) << bit);
+        return base_ + ranks_[bitset::word(doc)]
+          + doc_id_t(math::math_traits<word_t>::pop(preceding));
+      }
+      case PACKED: {
+        const size_t offset = size_t(doc)*bits_;
+        const auto bit = bitset::bit(offset);
+        const auto* word = words_.data() + bitset::word(offset);
+
+        auto value = word[0] >> bit;
+        if (bit + bits_ > bits_required<word_t>()) {
+          value |= word[1] << (bits_required<word_t>() - bit);
+        }
+
+        const auto id = doc_id_t(value & packed::max_value<word_t>(bits_));
+
+        // unset mapping is stored as 'doc_limits::invalid()'
+        return doc_limits::valid(id) ? id : doc_limits::eof();
+      }
+      default:
+        return doc_limits::eof();
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @return approximate amount of memory used by the mapping
+  //////////////////////////////////////////////////////////////////////////////
+  size_t memory() const noexcept {
+    return words_.capacity()*sizeof(word_t) + ranks_.capacity()*sizeof(doc_id_t);
+  }
+
+ private:
+  using word_t = bitset::word_t;
+
+  enum type_t {
+    NONE, // every document is mapped to 'doc_limits::eof()'
+    OFFSET,
+    RANK,
+    PACKED
+  };
+
+  void clear() noexcept {
+    words_ = {};
+    ranks_ = {};
+    type_ = NONE;
+    size_ = 0;
+    base_ = 0;
+    bits_ = 0;
+  }
+
+  std::vector<word_t> words_; // live documents for RANK, values for PACKED
+  std::vector<doc_id_t> ranks_; // number of live documents before a word
+  type_t type_{ NONE };
+  size_t size_{}; // documents [0, size_) are mapped
+  doc_id_t base_{}; // offset of mapped identifiers
+  uint32_t bits_{}; // number of bits per identifier for PACKED
+}; // doc_id_map
+
+NS_END // ROOT
+
+#endif // IRESEARCH_DOC_ID_MAP_H
@@ -0,0 +1,208 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_DOCUMENT_MASK_H
+#define IRESEARCH_DOCUMENT_MASK_H
+
+#include "types.hpp"
+#include "utils/bitvector.hpp"
+#include "utils/math_utils.hpp"
+
+NS_ROOT
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class document_mask
+/// @brief set of document identifiers excluded from a segment, backed by a
+///        bitset so that masked documents can be checked and skipped
+///        word-at-a-time
+////////////////////////////////////////////////////////////////////////////////
+class document_mask {
+ public:
+  using word_t = bitvector::word_t;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @class const_iterator
+  /// @brief iterates over masked documents in ascending order
+  //////////////////////////////////////////////////////////////////////////////
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = doc_id_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const doc_id_t*;
+    using reference = const doc_id_t&;
+
+    const_iterator(const document_mask& mask, size_t word) noexcept
+      : begin_(mask.data()), end_(begin_ + mask.words()), word_(begin_ + word) {
+      if (word_ < end_) {
+        value_ = *word_;
+        next();
+      }
+    }
+
+    const_iterator& operator++() noexcept {
+      next();
+      return *this;
+    }
+
+    const_iterator operator++(int) noexcept {
+      const auto tmp = *this;
+      next();
+      return tmp;
+    }
+
+    reference operator*() const noexcept { return doc_; }
+
+    bool operator==(const const_iterator& rhs) const noexcept {
+      assert(begin_ == rhs.begin_);
+      return word_ == rhs.word_ && value_ == rhs.value_;
+    }
+
+    bool operator!=(const const_iterator& rhs) const noexcept {
+      return !(*this == rhs);
+    }
+
+   private:
+    void next() noexcept {
+      while (!value_) {
+        if (++word_ >= end_) {
+          word_ = end_;
+          return;
+        }
+
+        value_ = *word_;
+      }
+
+      const auto bit = math::math_traits<word_t>::ctz(value_);
+      doc_ = doc_id_t(bitset::bit_offset(size_t(word_ - begin_)) + bit);
+      unset_bit(value_, bit);
+    }
+
+    const word_t* begin_;
+    const word_t* end_;
+    const word_t* word_;
+    word_t value_{}; // not yet visited bits of the current word
+    doc_id_t doc_{};
+  }; // const_iterator
+
+  document_mask() = default;
+
+  // intentionally implicit
+  document_mask(std::initializer_list<doc_id_t> docs) {
+    for (const auto doc : docs) {
+      insert(doc);
+    }
+  }
+
+  template<typename Iterator>
+  document_mask(Iterator begin, Iterator end) {
+    for (; begin != end; ++begin) {
+      insert(*begin);
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns true if 'doc' wasn't masked before
+  //////////////////////////////////////////////////////////////////////////////
+  bool insert(doc_id_t doc) {
+    if (bits_.test(doc)) {
+      return false;
+    }
+
+    bits_.set(doc);
+    ++size_;
+    return true;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns number of removed documents
+  //////////////////////////////////////////////////////////////////////////////
+  size_t erase(doc_id_t doc) {
+    if (!bits_.test(doc)) {
+      return 0;
+    }
+
+    bits_.unset(doc);
+    --size_;
+    return 1;
+  }
+
+  bool contains(doc_id_t doc) const noexcept {
+    return bits_.test(doc);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns the smallest document not less than 'target' which isn't masked
+  //////////////////////////////////////////////////////////////////////////////
+  doc_id_t next_unmasked(doc_id_t target) const noexcept {
+    auto word = bitset::word(target);
+    const auto words = bits_.words();
+
+    if (word >= words) {
+      return target;
+    }
+
+    const auto* data = bits_.data();
+
+    // unmasked documents of the current word excluding those below 'target'
+    auto value = ~data[word] & (~word_t(0) << bitset::bit(target));
+
+    while (!value) {
+      if (++word == words) {
+        return doc_id_t(bitset::bit_offset(word));
+      }
+
+      value = ~data[word];
+    }
+
+    return doc_id_t(bitset::bit_offset(word) + math::math_traits<word_t>::ctz(value));
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief ensure capacity for documents up to 'max_doc' inclusive
+  //////////////////////////////////////////////////////////////////////////////
+  void reserve(doc_id_t max_doc) {
+    bits_.reserve(size_t(max_doc) + 1);
+  }
+
+  void clear() noexcept {
+    bits_.clear();
+    size_ = 0;
+  }
+
+  size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return 0 == size_; }
+
+  const word_t* data() const noexcept { return bits_.data(); }
+  size_t words() const noexcept { return bits_.words(); }
+
+  const_iterator begin() const noexcept { return const_iterator(*this, 0); }
+  const_iterator end() const noexcept { return const_iterator(*this, words()); }
+
+ private:
+  bitvector bits_;
+  size_t size_{}; // number of masked documents
+}; // document_mask
+
+NS_END
+
+#endif // IRESEARCH_DOCUMENT_MASK_H
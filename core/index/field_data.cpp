@@ -577,13 +577,12 @@ class term_iterator : public irs::term_iterator {
       const bytes_ref*& min,
       const bytes_ref*& max) {
     // refill postings
-    postings_.clear();
-    postings_.insert(field.terms_.begin(), field.terms_.end());
+    field.terms_.get_sorted_postings(postings_);
 
     max = min = &irs::bytes_ref::NIL;
     if (!postings_.empty()) {
-      min = &(postings_.begin()->first);
-      max = &((--postings_.end())->first);
+      min = &(postings_.front()->first);
+      max = &(postings_.back()->first);
     }
 
     field_ = &field;
@@ -601,7 +600,7 @@ class term_iterator : public irs::term_iterator {
 
   virtual const bytes_ref& value() const noexcept override {
     assert(it_ != postings_.end());
-    return it_->first;
+    return (*it_)->first;
   }
 
   virtual attribute* get_mutable(type_info::type_id) noexcept override {
@@ -616,7 +615,7 @@ class term_iterator : public irs::term_iterator {
     REGISTER_TIMER_DETAILED();
     assert(it_ != postings_.end());
 
-    return (this->*POSTINGS[size_t(field_->prox_random_access())])(it_->second);
+    return (this->*POSTINGS[size_t(field_->prox_random_access())])((*it_)->second);
   }
 
   virtual bool next() override {   
@@ -634,18 +633,6 @@ class term_iterator : public irs::term_iterator {
   }
 
  private:
-  struct less_t {
-    bool operator()(const bytes_ref& lhs, const bytes_ref& rhs) const noexcept {
-      return memcmp_less(lhs, rhs);
-    }
-  };
-
-  typedef std::map<
-    bytes_ref,
-    std::reference_wrapper<const posting>,
-    less_t
-  > map_t;
-
   typedef irs::doc_iterator::ptr(term_iterator::*postings_f)(const posting&) const;
 
   static const postings_f POSTINGS[2];
@@ -682,9 +669,9 @@ class term_iterator : public irs::term_iterator {
     return memory::to_managed<irs::doc_iterator, false>(&sorting_doc_itr_);
   }
 
-  map_t postings_;
-  map_t::iterator next_{ postings_.end() };
-  map_t::iterator it_{ postings_.end() };
+  postings::sorted_postings_t postings_;
+  postings::sorted_postings_t::const_iterator next_{ postings_.end() };
+  postings::sorted_postings_t::const_iterator it_{ postings_.end() };
   const field_data* field_{};
   const doc_map* doc_map_{};
   mutable detail::doc_iterator doc_itr_;
@@ -1169,12 +1156,24 @@ field_data& fields_data::emplace(const hashed_string_ref& name) {
 
   // replace original reference to 'name' provided by the caller
   // with a reference to the cached copy in 'value'
-  return map_utils::try_emplace_update_key(
+  const auto res = map_utils::try_emplace_update_key(
     fields_,                                                  // container
     generator,                                                // key generator
     name,                                                     // key
     name, byte_writer_, int_writer_, (nullptr != comparator_) // value
-  ).first->second;
+  );
+
+  auto& field = res.first->second;
+
+  if (res.second) {
+    const auto hint = terms_hints_.find(std::string(name.c_str(), name.size()));
+
+    if (hint != terms_hints_.end()) {
+      field.terms_.reserve(hint->second);
+    }
+  }
+
+  return field;
 }
 
 void fields_data::flush(field_writer& fw, flush_state& state) {
@@ -1202,9 +1201,15 @@ void fields_data::flush(field_writer& fw, flush_state& state) {
 
   detail::term_reader terms;
 
+  // remember number of terms per field to size postings of the next segment
+  terms_hints_.clear();
+  terms_hints_.reserve(fields.size());
+
   for (auto* field : fields) {
     auto& meta = field->meta();
 
+    terms_hints_.emplace(meta.name, field->terms_.size());
+
     // reset reader
     terms.reset(*field, state.docmap);
 
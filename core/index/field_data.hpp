@@ -182,6 +182,7 @@ class IRESEARCH_API fields_data: util::noncopyable {
   int_block_pool int_pool_; // FIXME why don't to use std::vector<size_t>?
   int_block_pool::inserter int_writer_;
   flags features_;
+  std::unordered_map<std::string, size_t> terms_hints_; // number of terms per field in the last flushed segment
   IRESEARCH_API_PRIVATE_VARIABLES_END
 };
 
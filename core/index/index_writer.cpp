@@ -146,7 +146,7 @@ bool add_document_mask_modified_records(
       // if the indexed doc_id was insert()ed after the request for modification
       // or the indexed doc_id was already masked then it should be skipped
       if (modification.generation < min_modification_generation
-          || !docs_mask.insert(doc_id).second) {
+          || !docs_mask.insert(doc_id)) {
         continue; // the current modification query does not match any records
       }
 
@@ -220,7 +220,7 @@ bool add_document_mask_modified_records(
       // if the indexed doc_id was insert()ed after the request for modification
       // or the indexed doc_id was already masked then it should be skipped
       if (modification.generation < doc_ctx.generation
-          || !ctx.docs_mask_.insert(doc_id).second) {
+          || !ctx.docs_mask_.insert(doc_id)) {
         continue; // the current modification query does not match any records
       }
 
@@ -267,7 +267,7 @@ bool add_document_mask_unused_updates(flush_segment_context& ctx) {
 
     // if it's an update record placeholder who's query already match some record
     if (ctx.modification_contexts_[doc_ctx.update_id].seen
-        || !ctx.docs_mask_.insert(doc_id).second) {
+        || !ctx.docs_mask_.insert(doc_id)) {
       continue; // the current placeholder record is in-use and valid
     }
 
@@ -547,6 +547,21 @@ segment_reader readers_cache::emplace(const segment_meta& meta) {
 
   cached_reader = std::move(reader); // clear existing reader
 
+  if (!cached_reader) {
+    // reuse a reader of another version of the same segment (all versions
+    // are in the same bucket), e.g. only document mask has to be read
+    // in case of removals
+    const key_t key(meta);
+
+    for (auto it = cache_.begin(cache_.bucket(key)),
+              end = cache_.end(cache_.bucket(key)); it != end; ++it) {
+      if (it->first.name == key.name && it->second) {
+        cached_reader = it->second;
+        break;
+      }
+    }
+  }
+
   // update cache, in case of failure reader stays empty
   reader = cached_reader
     ? cached_reader.reopen(meta)
@@ -1049,6 +1064,10 @@ index_writer::segment_context::segment_context(
 uint64_t index_writer::segment_context::flush() {
   SCOPED_LOCK(flush_mutex_); // prevent concurrent flush related modifications
 
+  return flush_locked();
+}
+
+uint64_t index_writer::segment_context::flush_locked() {
   if (!writer_ || !writer_->initialized() || !writer_->docs_cached()) {
     return 0; // skip flushing an empty writer
   }
@@ -1203,6 +1222,8 @@ index_writer::index_writer(
     directory& dir,
     format::ptr codec,
     size_t segment_pool_size,
+    size_t flush_threads,
+    size_t merge_threads,
     const segment_options& segment_limits,
     const comparer* comparator,
     const column_info_provider_t& column_info,
@@ -1215,6 +1236,12 @@ index_writer::index_writer(
     committed_state_(std::move(committed_state)),
     dir_(dir),
     flush_context_pool_(2), // 2 because just swap them due to common commit lock
+    flush_pool_(flush_threads
+      ? memory::make_unique<async_utils::thread_pool>(flush_threads, flush_threads)
+      : nullptr),
+    merge_pool_(merge_threads
+      ? memory::make_unique<async_utils::thread_pool>(merge_threads, merge_threads)
+      : nullptr),
     meta_(std::move(meta)),
     segment_limits_(segment_limits),
     segment_writer_pool_(segment_pool_size),
@@ -1358,6 +1385,8 @@ index_writer::ptr index_writer::make(
     dir,
     codec,
     opts.segment_pool_size,
+    opts.flush_threads,
+    opts.merge_threads,
     segment_options(opts),
     opts.comparator,
     opts.column_info ? opts.column_info : DEFAULT_COLUMN_INFO,
@@ -1395,7 +1424,8 @@ uint64_t index_writer::buffered_docs() const {
 bool index_writer::consolidate(
     const consolidation_policy_t& policy,
     format::ptr codec /*= nullptr*/,
-    const merge_writer::flush_progress_t& progress /*= {}*/) {
+    const merge_writer::flush_progress_t& progress /*= {}*/,
+    async_utils::rate_limiter* limiter /*= nullptr*/) {
   REGISTER_TIMER_DETAILED();
   if (!codec) {
     // use default codec if not specified
@@ -1507,7 +1537,15 @@ bool index_writer::consolidate(
   consolidation_segment.meta.name = file_name(meta_.increment()); // increment active meta, not fn arg
 
   ref_tracking_directory dir(dir_); // track references for new segment
-  merge_writer merger(dir, column_info_, comparator_);
+  std::unique_ptr<throttled_directory> throttled_dir; // merge output only
+
+  if (limiter) {
+    throttled_dir = memory::make_unique<throttled_directory>(dir, *limiter);
+  }
+
+  merge_writer merger(
+    throttled_dir ? static_cast<directory&>(*throttled_dir) : dir,
+    column_info_, comparator_, merge_pool_.get());
   merger.reserve(candidates.size());
 
   // add consolidated segments to the merge_writer
@@ -1749,7 +1787,7 @@ bool index_writer::import(
   segment.meta.name = file_name(meta_.increment());
   segment.meta.codec = codec;
 
-  merge_writer merger(dir, column_info_, comparator_);
+  merge_writer merger(dir, column_info_, comparator_, merge_pool_.get());
   merger.reserve(reader.size());
 
   for (auto& segment : reader) {
@@ -1926,6 +1964,24 @@ index_writer::pending_context_t index_writer::flush_all(const before_commit_f& b
 
   uint64_t max_tick = 0;
 
+  // state of segments being flushed concurrently by 'flush_pool_'
+  struct {
+    std::mutex mutex;
+    std::condition_variable cond;
+    size_t pending{}; // number of segments not yet flushed
+    uint64_t max_tick{};
+    std::exception_ptr error; // first flush failure
+  } async_flush;
+
+  // wait for the segments being flushed concurrently to finish
+  auto join_flush = irs::make_finally([&async_flush]()noexcept{
+    std::unique_lock<std::mutex> lock(async_flush.mutex);
+
+    while (async_flush.pending) {
+      async_flush.cond.wait(lock);
+    }
+  });
+
   for (auto& entry : ctx->pending_segment_contexts_) {
     // mark the 'segment_context' as dirty so that it will not be reused if this
     // 'flush_context' once again becomes the active context while the
@@ -1946,8 +2002,50 @@ index_writer::pending_context_t index_writer::flush_all(const before_commit_f& b
     // FIXME TODO flush_all() blocks flush_context::emplace(...) and insert()/remove()/replace()
     segment_flush_locks.emplace_back(entry.segment_->flush_mutex_); // prevent concurrent modification of segment_context properties during flush_context::emplace(...)
 
-    // force a flush of the underlying segment_writer
-    max_tick = std::max(entry.segment_->flush(), max_tick);
+    // force a flush of the underlying segment_writer, segments are independent
+    // of each other so they may be flushed concurrently while 'flush_mutex_'
+    // of each segment is held by this thread via 'segment_flush_locks'
+    if (flush_pool_) {
+      auto* segment = entry.segment_.get();
+
+      {
+        SCOPED_LOCK(async_flush.mutex);
+        ++async_flush.pending;
+      }
+
+      const auto scheduled = flush_pool_->run([segment, &async_flush]()->void {
+        uint64_t tick = 0;
+        std::exception_ptr error;
+
+        try {
+          tick = segment->flush_locked();
+        } catch (...) {
+          error = std::current_exception();
+        }
+
+        SCOPED_LOCK(async_flush.mutex);
+        async_flush.max_tick = std::max(tick, async_flush.max_tick);
+
+        if (error && !async_flush.error) {
+          async_flush.error = std::move(error);
+        }
+
+        if (!--async_flush.pending) {
+          async_flush.cond.notify_all();
+        }
+      });
+
+      if (!scheduled) {
+        {
+          SCOPED_LOCK(async_flush.mutex);
+          --async_flush.pending;
+        }
+
+        max_tick = std::max(segment->flush_locked(), max_tick);
+      }
+    } else {
+      max_tick = std::max(entry.segment_->flush(), max_tick);
+    }
 
     entry.doc_id_end_ = // may be integer_traits<size_t>::const_max if segment_meta only in this flush_context
       std::min(entry.segment_->uncomitted_doc_id_begin_, entry.doc_id_end_); // update so that can use valid value below
@@ -1958,6 +2056,21 @@ index_writer::pending_context_t index_writer::flush_all(const before_commit_f& b
 
   }
 
+  if (flush_pool_) {
+    // all segments must be flushed before index_meta is written
+    std::unique_lock<std::mutex> flush_lock(async_flush.mutex);
+
+    while (async_flush.pending) {
+      async_flush.cond.wait(flush_lock);
+    }
+
+    if (async_flush.error) {
+      std::rethrow_exception(async_flush.error);
+    }
+
+    max_tick = std::max(async_flush.max_tick, max_tick);
+  }
+
   /////////////////////////////////////////////////////////////////////////////
   /// Stage 1
   /// update document_mask for existing (i.e. sealed) segments
@@ -2273,7 +2386,7 @@ index_writer::pending_context_t index_writer::flush_all(const before_commit_f& b
              doc_id < valid_doc_id_begin;
              ++doc_id) {
           assert(integer_traits<doc_id_t>::const_max >= doc_id);
-          if (flush_segment_ctx.docs_mask_.emplace(doc_id_t(doc_id)).second) {
+          if (flush_segment_ctx.docs_mask_.insert(doc_id_t(doc_id))) {
             assert(flush_segment_ctx.segment_.meta.live_docs_count);
             --flush_segment_ctx.segment_.meta.live_docs_count; // decrement count of live docs
           }
@@ -2285,7 +2398,7 @@ index_writer::pending_context_t index_writer::flush_all(const before_commit_f& b
              doc_id < doc_id_end;
              ++doc_id) {
           assert(integer_traits<doc_id_t>::const_max >= doc_id);
-          if (flush_segment_ctx.docs_mask_.emplace(doc_id_t(doc_id)).second) {
+          if (flush_segment_ctx.docs_mask_.insert(doc_id_t(doc_id))) {
             assert(flush_segment_ctx.segment_.meta.live_docs_count);
             --flush_segment_ctx.segment_.meta.live_docs_count; // decrement count of live docs
           }
@@ -68,6 +68,7 @@ class readers_cache final : util::noncopyable {
     uint64_t version;
   };
 
+  // hash by name only, so that all versions of a segment share a bucket
   struct key_hash_t {
     size_t operator()(const key_t& key) const noexcept {
       return std::hash<std::string>()(key.name);
@@ -460,6 +461,20 @@ class IRESEARCH_API index_writer
     ////////////////////////////////////////////////////////////////////////////
     size_t segment_pool_size{128}; // arbitrary size
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief max number of threads used to flush pending segments
+    ///        concurrently during commit
+    ///        0 == flush segments sequentially on the committing thread
+    ////////////////////////////////////////////////////////////////////////////
+    size_t flush_threads{0};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief max number of threads used to merge field terms and columns of
+    ///        segments concurrently during consolidation and import
+    ///        0 == merge on the consolidating thread only
+    ////////////////////////////////////////////////////////////////////////////
+    size_t merge_threads{0};
+
     ////////////////////////////////////////////////////////////////////////////
     /// @brief aquire an exclusive lock on the repository to guard against index
     ///        corruption from multiple index_writers
@@ -539,6 +554,8 @@ class IRESEARCH_API index_writer
   ///        nullptr == use index_writer's codec
   /// @param progress callback triggered for consolidation steps, if the
   ///                 callback returns false then consolidation is aborted
+  /// @param limiter limits write bandwidth of the merge,
+  ///        nullptr == do not throttle
   /// @note for deffered policies during the commit stage each policy will be
   ///       given the exact same index_meta containing all segments in the
   ///       commit, however, the resulting acceptor will only be segments not
@@ -547,7 +564,8 @@ class IRESEARCH_API index_writer
   bool consolidate(
     const consolidation_policy_t& policy,
     format::ptr codec = nullptr,
-    const merge_writer::flush_progress_t& progress = {}
+    const merge_writer::flush_progress_t& progress = {},
+    async_utils::rate_limiter* limiter = nullptr
   );
 
   //////////////////////////////////////////////////////////////////////////////
@@ -815,6 +833,12 @@ class IRESEARCH_API index_writer
     ////////////////////////////////////////////////////////////////////////////
     uint64_t flush();
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief same as flush() but expects 'flush_mutex_' to be already held
+    ///        on behalf of the caller, e.g. by the committing thread
+    ////////////////////////////////////////////////////////////////////////////
+    uint64_t flush_locked();
+
     // returns context for "insert" operation
     segment_writer::update_context make_update_context();
 
@@ -1018,6 +1042,8 @@ class IRESEARCH_API index_writer
     directory& dir, 
     format::ptr codec,
     size_t segment_pool_size,
+    size_t flush_threads,
+    size_t merge_threads,
     const segment_options& segment_limits,
     const comparer* comparator,
     const column_info_provider_t& column_info,
@@ -1045,6 +1071,8 @@ class IRESEARCH_API index_writer
   consolidating_segments_t consolidating_segments_; // segments that are under consolidation
   directory& dir_; // directory used for initialization of readers
   std::vector<flush_context> flush_context_pool_; // collection of contexts that collect data to be flushed, 2 because just swap them
+  std::unique_ptr<async_utils::thread_pool> flush_pool_; // executor for concurrent segment flush during commit, nullptr == flush sequentially
+  std::unique_ptr<async_utils::thread_pool> merge_pool_; // executor for concurrent segment merge, nullptr == merge sequentially
   std::atomic<flush_context*> flush_context_; // currently active context accumulating data to be processed during the next flush
   index_meta meta_; // latest/active state of index metadata
   pending_state_t pending_state_; // current state awaiting commit completion
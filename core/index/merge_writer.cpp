@@ -33,6 +33,7 @@
 #include "index/comparer.hpp"
 #include "utils/directory_utils.hpp"
 #include "utils/log.hpp"
+#include "utils/misc.hpp"
 #include "utils/lz4compression.hpp"
 #include "utils/memory.hpp"
 #include "utils/type_limits.hpp"
@@ -41,8 +42,6 @@
 
 #include <array>
 
-#include <boost/iterator/filter_iterator.hpp>
-
 NS_LOCAL
 
 const irs::column_info NORM_COLUMN{
@@ -51,13 +50,6 @@ const irs::column_info NORM_COLUMN{
   false
 };
 
-// mapping of old doc_id to new doc_id (reader doc_ids are sequential 0 based)
-// masked doc_ids have value of MASKED_DOC_ID
-typedef std::vector<irs::doc_id_t> doc_id_map_t;
-
-// document mapping function
-typedef std::function<irs::doc_id_t(irs::doc_id_t)> doc_map_f;
-
 typedef std::unordered_map<irs::string_ref, const irs::field_meta*> field_meta_map_t;
 
 class noop_directory : public irs::directory {
@@ -173,7 +165,7 @@ class progress_tracker {
 /// @brief iterator over doc_ids for a term over all readers
 //////////////////////////////////////////////////////////////////////////////
 struct compound_doc_iterator : public irs::doc_iterator {
-  typedef std::pair<irs::doc_iterator::ptr, const doc_map_f*> doc_iterator_t;
+  typedef std::pair<irs::doc_iterator::ptr, const irs::doc_id_map*> doc_iterator_t;
   typedef std::vector<doc_iterator_t> iterators_t;
 
   static constexpr const size_t PROGRESS_STEP_DOCS = size_t(1) << 14;
@@ -393,7 +385,7 @@ class compound_iterator {
   size_t size() const { return iterators_.size(); }
 
   void add(const irs::sub_reader& reader,
-           const doc_map_f& doc_map) {
+           const irs::doc_id_map& doc_map) {
     iterator_mask_.emplace_back(iterators_.size());
     iterators_.emplace_back(reader.columns(), reader, doc_map);
   }
@@ -464,7 +456,7 @@ class compound_iterator {
     iterator_t(
         Iterator&& it,
         const irs::sub_reader& reader,
-        const doc_map_f& doc_map)
+        const irs::doc_id_map& doc_map)
       : it(std::move(it)),
         reader(&reader), 
         doc_map(&doc_map) {
@@ -475,7 +467,7 @@ class compound_iterator {
 
     Iterator it;
     const irs::sub_reader* reader;
-    const doc_map_f* doc_map;
+    const irs::doc_id_map* doc_map;
   };
 
   static_assert(std::is_nothrow_move_constructible_v<iterator_t>);
@@ -514,7 +506,7 @@ class compound_term_iterator : public irs::term_iterator {
   }
 
   const irs::field_meta& meta() const noexcept { return *meta_; }
-  void add(const irs::term_reader& reader, const doc_map_f& doc_map);
+  void add(const irs::term_reader& reader, const irs::doc_id_map& doc_map);
   virtual irs::attribute* get_mutable(irs::type_info::type_id) noexcept override {
     // no way to merge attributes for the same term spread over multiple iterators
     // would require API change for attributes
@@ -536,11 +528,11 @@ class compound_term_iterator : public irs::term_iterator {
  private:
   struct term_iterator_t {
     irs::seek_term_iterator::ptr first;
-    const doc_map_f* second;
+    const irs::doc_id_map* second;
 
     term_iterator_t(
         irs::seek_term_iterator::ptr&& term_itr,
-        const doc_map_f* doc_map)
+        const irs::doc_id_map* doc_map)
       : first(std::move(term_itr)), second(doc_map) {
     }
 
@@ -568,7 +560,7 @@ class compound_term_iterator : public irs::term_iterator {
 
 void compound_term_iterator::add(
     const irs::term_reader& reader,
-    const doc_map_f& doc_id_map) {
+    const irs::doc_id_map& doc_id_map) {
   term_iterator_mask_.emplace_back(term_iterators_.size()); // mark as used to trigger next()
   term_iterators_.emplace_back(reader.iterator(), &doc_id_map);
 }
@@ -661,7 +653,7 @@ class compound_field_iterator : public irs::basic_term_reader {
       progress_(progress, PROGRESS_STEP_FIELDS) {
   }
 
-  void add(const irs::sub_reader& reader, const doc_map_f& doc_id_map);
+  void add(const irs::sub_reader& reader, const irs::doc_id_map& doc_id_map);
   bool next();
   size_t size() const { return field_iterators_.size(); }
 
@@ -705,7 +697,7 @@ class compound_field_iterator : public irs::basic_term_reader {
     field_iterator_t(
         irs::field_iterator::ptr&& itr,
         const irs::sub_reader& reader,
-        const doc_map_f& doc_map)
+        const irs::doc_id_map& doc_map)
       : itr(std::move(itr)),
         reader(&reader),
         doc_map(&doc_map) {
@@ -716,7 +708,7 @@ class compound_field_iterator : public irs::basic_term_reader {
 
     irs::field_iterator::ptr itr;
     const irs::sub_reader* reader;
-    const doc_map_f* doc_map;
+    const irs::doc_id_map* doc_map;
   };
 
   static_assert(std::is_nothrow_move_constructible_v<field_iterator_t>);
@@ -741,7 +733,7 @@ typedef compound_iterator<irs::column_iterator::ptr> compound_column_meta_iterat
 
 void compound_field_iterator::add(
     const irs::sub_reader& reader,
-    const doc_map_f& doc_id_map) {
+    const irs::doc_id_map& doc_id_map) {
   field_iterator_mask_.emplace_back(term_iterator_t{
     field_iterators_.size(),
     nullptr,
@@ -888,7 +880,7 @@ class columnstore {
   bool insert(
       const irs::sub_reader& reader,
       irs::field_id column,
-      const doc_map_f& doc_map) {
+      const irs::doc_id_map& doc_map) {
     const auto* column_reader = reader.column_reader(column);
 
     if (!column_reader) {
@@ -1078,7 +1070,7 @@ bool write_columns(
   auto add_iterators = [&column_meta_itr](compound_doc_iterator::iterators_t& itrs) {
     auto add_iterators = [&itrs](
         const irs::sub_reader& segment,
-        const doc_map_f& doc_map,
+        const irs::doc_id_map& doc_map,
         const irs::column_meta& column) {
       auto* reader = segment.column_reader(column.id);
 
@@ -1122,13 +1114,12 @@ bool write_columns(
 }
 
 //////////////////////////////////////////////////////////////////////////////
-/// @brief write columnstore
+/// @brief write columnstore using already prepared column meta writer
 //////////////////////////////////////////////////////////////////////////////
 bool write_columns(
     columnstore& cs,
-    irs::directory& dir,
+    irs::column_meta_writer& cmw,
     const irs::column_info_provider_t& column_info,
-    const irs::segment_meta& meta,
     compound_column_meta_iterator_t& column_itr,
     const irs::merge_writer::flush_progress_t& progress) {
   REGISTER_TIMER_DETAILED();
@@ -1137,15 +1128,11 @@ bool write_columns(
 
   auto visitor = [&cs](
       const irs::sub_reader& segment,
-      const doc_map_f& doc_map,
+      const irs::doc_id_map& doc_map,
       const irs::column_meta& column) {
     return cs.insert(segment, column.id, doc_map);
   };
 
-  auto cmw = meta.codec->get_column_meta_writer();
-
-  cmw->prepare(dir, meta);
-
   while (column_itr.next()) {
     const auto& column_name = (*column_itr).name;
     cs.reset(column_info(column_name));
@@ -1157,15 +1144,36 @@ bool write_columns(
     }
 
     if (!cs.empty()) {
-      cmw->write(column_name, cs.id());
+      cmw.write(column_name, cs.id());
     } 
   }
 
-  cmw->flush();
+  cmw.flush();
 
   return true;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+/// @brief write columnstore
+//////////////////////////////////////////////////////////////////////////////
+bool write_columns(
+    columnstore& cs,
+    irs::directory& dir,
+    const irs::column_info_provider_t& column_info,
+    const irs::segment_meta& meta,
+    compound_column_meta_iterator_t& column_itr,
+    const irs::merge_writer::flush_progress_t& progress) {
+  REGISTER_TIMER_DETAILED();
+  assert(cs);
+  assert(progress);
+
+  auto cmw = meta.codec->get_column_meta_writer();
+
+  cmw->prepare(dir, meta);
+
+  return write_columns(cs, *cmw, column_info, column_itr, progress);
+}
+
 //////////////////////////////////////////////////////////////////////////////
 /// @brief write field term data
 //////////////////////////////////////////////////////////////////////////////
@@ -1191,7 +1199,7 @@ bool write_fields(
 
   auto merge_norms = [&cs] (
       const irs::sub_reader& segment,
-      const doc_map_f& doc_map,
+      const irs::doc_id_map& doc_map,
       const irs::field_meta& field) {
     // merge field norms if present
     if (irs::field_limits::valid(field.norm)
@@ -1258,7 +1266,7 @@ bool write_fields(
   auto add_iterators = [&field_itr](compound_doc_iterator::iterators_t& itrs) {
     auto add_iterators = [&itrs](
         const irs::sub_reader& segment,
-        const doc_map_f& doc_map,
+        const irs::doc_id_map& doc_map,
         const irs::field_meta& field) {
       if (!irs::field_limits::valid(field.norm)) {
         // field has no norms
@@ -1311,38 +1319,95 @@ bool write_fields(
   return !field_itr.aborted();
 }
 
+//////////////////////////////////////////////////////////////////////////////
+/// @brief write field norms only, identifiers of norm columns are stored in
+///        'norms' in the order of fields, 'field_limits::invalid()' denotes a
+///        field without norms
+//////////////////////////////////////////////////////////////////////////////
+bool write_norms(
+    columnstore& cs,
+    compound_field_iterator& field_itr,
+    std::vector<irs::field_id>& norms,
+    const irs::merge_writer::flush_progress_t& progress
+) {
+  REGISTER_TIMER_DETAILED();
+  assert(cs);
+
+  auto merge_norms = [&cs] (
+      const irs::sub_reader& segment,
+      const irs::doc_id_map& doc_map,
+      const irs::field_meta& field) {
+    // merge field norms if present
+    if (irs::field_limits::valid(field.norm)
+        && !cs.insert(segment, field.norm, doc_map)) {
+      return false;
+    }
+
+    return true;
+  };
+
+  while (field_itr.next()) {
+    cs.reset(NORM_COLUMN); // FIXME encoder for norms???
+
+    if (!progress() || !field_itr.visit(merge_norms)) {
+      return false;
+    }
+
+    norms.emplace_back(cs.empty() ? irs::field_limits::invalid() : cs.id());
+  }
+
+  return !field_itr.aborted();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief write field term data using already prepared field writer and norm
+///        columns written by 'write_norms(...)'
+//////////////////////////////////////////////////////////////////////////////
+bool write_terms(
+    irs::field_writer& field_writer,
+    compound_field_iterator& field_itr,
+    const std::vector<irs::field_id>& norms,
+    const irs::merge_writer::flush_progress_t& progress
+) {
+  REGISTER_TIMER_DETAILED();
+
+  for (auto norm = norms.begin(); field_itr.next(); ++norm) {
+    if (norm == norms.end() || !progress()) {
+      return false;
+    }
+
+    auto& field_meta = field_itr.meta();
+    auto terms = field_itr.iterator();
+
+    field_writer.write(field_meta.name, *norm, field_meta.features, *terms);
+  }
+
+  field_writer.end();
+
+  return !field_itr.aborted();
+}
+
 //////////////////////////////////////////////////////////////////////////////
 /// @brief computes doc_id_map and docs_count
 //////////////////////////////////////////////////////////////////////////////
 irs::doc_id_t compute_doc_ids(
-  doc_id_map_t& doc_id_map,
+  irs::doc_id_map& doc_id_map,
   const irs::sub_reader& reader,
   irs::doc_id_t next_id
 ) noexcept {
   REGISTER_TIMER_DETAILED();
-  // assume not a lot of space wasted if irs::doc_limits::min() > 0
+
   try {
-    doc_id_map.resize(
-      reader.docs_count() + irs::doc_limits::min(),
-      irs::doc_limits::eof()
-    );
+    auto docs_itr = reader.docs_iterator();
+    return doc_id_map.reset(*docs_itr, irs::doc_id_t(reader.docs_count()), next_id);
   } catch (...) {
     IR_FRMT_ERROR(
-      "Failed to resize merge_writer::doc_id_map to accommodate element: " IR_UINT64_T_SPECIFIER,
+      "Failed to allocate merge_writer::doc_id_map to accommodate element: " IR_UINT64_T_SPECIFIER,
       reader.docs_count() + irs::doc_limits::min()
     );
-    return irs::doc_limits::invalid();
-  }
-
-  for (auto docs_itr = reader.docs_iterator(); docs_itr->next(); ++next_id) {
-    auto src_doc_id = docs_itr->value();
-
-    assert(src_doc_id >= irs::doc_limits::min());
-    assert(src_doc_id < reader.docs_count() + irs::doc_limits::min());
-    doc_id_map[src_doc_id] = next_id; // set to next valid doc_id
   }
 
-  return next_id;
+  return irs::doc_limits::invalid();
 }
 
 
@@ -1353,9 +1418,7 @@ NS_END // LOCAL
 NS_ROOT
 
 merge_writer::reader_ctx::reader_ctx(irs::sub_reader::ptr reader) noexcept
-  : reader(reader),
-    doc_map([](doc_id_t) noexcept { return irs::doc_limits::eof(); }
-) {
+  : reader(reader) {
   assert(reader);
 }
 
@@ -1391,21 +1454,10 @@ bool merge_writer::flush(
     const auto docs_count = reader.docs_count();
 
     if (reader.live_docs_count() == docs_count) { // segment has no deletes
-      const auto reader_base = base_id - irs::doc_limits::min();
+      reader_ctx.doc_map.reset(doc_id_t(docs_count), base_id);
       base_id += docs_count;
-
-      reader_ctx.doc_map = [reader_base](doc_id_t doc) noexcept {
-        return reader_base + doc;
-      };
     } else { // segment has some deleted docs
-      auto& doc_id_map = reader_ctx.doc_id_map;
-      base_id = compute_doc_ids(doc_id_map , reader, base_id);
-
-      reader_ctx.doc_map = [&doc_id_map](doc_id_t doc) noexcept {
-        return doc >= doc_id_map.size()
-          ? irs::doc_limits::eof()
-          : doc_id_map[doc];
-      };
+      base_id = compute_doc_ids(reader_ctx.doc_map, reader, base_id);
     }
 
     if (!irs::doc_limits::valid(base_id)) {
@@ -1441,18 +1493,106 @@ bool merge_writer::flush(
     return false; // progress callback requested termination
   }
 
-  // write columns
-  if (!write_columns(cs, dir, *column_info_, segment.meta, columns_meta_itr, progress)) {
-    return false; // flush failure
-  }
+  if (pool_) {
+    // norms are written first, so field term data doesn't depend on the
+    // columnstore any more and can be written concurrently with the columns
+    std::vector<field_id> norms;
 
-  if (!progress()) {
-    return false; // progress callback requested termination
-  }
+    if (!write_norms(cs, fields_itr, norms, progress)) {
+      return false; // flush failure
+    }
 
-  // write field meta and field term data
-  if (!write_fields(cs, dir, segment.meta, fields_itr, fields_features, progress)) {
-    return false; // flush failure
+    compound_field_iterator terms_itr(progress);
+
+    for (auto& reader_ctx : readers_) {
+      terms_itr.add(*reader_ctx.reader, reader_ctx.doc_map);
+    }
+
+    // 'dir' isn't thread-safe, create all of the outputs upfront
+    auto column_meta_writer = segment.meta.codec->get_column_meta_writer();
+    column_meta_writer->prepare(dir, segment.meta);
+
+    flush_state flush_state;
+    flush_state.dir = &dir;
+    flush_state.doc_count = segment.meta.docs_count;
+    flush_state.features = &fields_features;
+    flush_state.name = segment.meta.name;
+
+    auto field_writer = segment.meta.codec->get_field_writer(true);
+    field_writer->prepare(flush_state);
+
+    struct {
+      std::mutex mutex;
+      std::condition_variable cond;
+      std::exception_ptr error;
+      bool done{};
+      bool result{};
+    } columns_task;
+
+    // columns task refers to the local state, always wait for its completion
+    auto join_columns_task = make_finally([&columns_task]()noexcept{
+      std::unique_lock<std::mutex> lock(columns_task.mutex);
+
+      while (!columns_task.done) {
+        columns_task.cond.wait(lock);
+      }
+    });
+
+    auto write_columns_task = [&]()->void {
+      bool result = false;
+      std::exception_ptr error;
+
+      try {
+        result = write_columns(cs, *column_meta_writer, *column_info_,
+                               columns_meta_itr, progress);
+      } catch (...) {
+        error = std::current_exception();
+      }
+
+      SCOPED_LOCK(columns_task.mutex);
+      columns_task.result = result;
+      columns_task.error = std::move(error);
+      columns_task.done = true;
+      columns_task.cond.notify_all();
+    };
+
+    if (!pool_->run(write_columns_task)) {
+      write_columns_task(); // executor isn't active, write columns in place
+    }
+
+    // write field meta and field term data
+    const bool terms_written = write_terms(*field_writer, terms_itr, norms, progress);
+    field_writer.reset();
+
+    {
+      std::unique_lock<std::mutex> lock(columns_task.mutex);
+
+      while (!columns_task.done) {
+        columns_task.cond.wait(lock);
+      }
+    }
+
+    if (columns_task.error) {
+      std::rethrow_exception(columns_task.error);
+    }
+
+    if (!terms_written || !columns_task.result) {
+      return false; // flush failure
+    }
+  } else {
+    // write columns
+    if (!write_columns(cs, dir, *column_info_, segment.meta, columns_meta_itr, progress)) {
+      return false; // flush failure
+    }
+
+    if (!progress()) {
+      return false; // progress callback requested termination
+    }
+
+    // write field meta and field term data
+    if (!write_fields(cs, dir, segment.meta, fields_itr, fields_features, progress)) {
+      return false; // flush failure
+    }
   }
 
   if (!progress()) {
@@ -1514,35 +1654,29 @@ bool merge_writer::flush_sorted(
                                   segment.meta.docs_count)) {
       return false;
     }
+  }
+
+  if (segment.meta.docs_count >= irs::doc_limits::eof()) {
+    // can't merge segments holding more than 'irs::doc_limits::eof()-1' docs
+    return false;
+  }
+
+  // prepare doc maps, identifiers are bounded by the number of merged docs
+  const auto max_id = doc_id_t(segment.meta.docs_count + irs::doc_limits::min() - 1);
 
-    // prepare doc maps
-    auto& doc_id_map = reader_ctx.doc_id_map;
+  for (auto& reader_ctx : readers_) {
+    auto& reader = *reader_ctx.reader;
 
     try {
-      // assume not a lot of space wasted if irs::doc_limits::min() > 0
-      doc_id_map.resize(
-        reader.docs_count() + irs::doc_limits::min(),
-        irs::doc_limits::eof()
-      );
+      reader_ctx.doc_map.reset_packed(doc_id_t(reader.docs_count()), max_id);
     } catch (...) {
       IR_FRMT_ERROR(
-        "Failed to resize merge_writer::doc_id_map to accommodate element: " IR_UINT64_T_SPECIFIER,
+        "Failed to allocate merge_writer::doc_id_map to accommodate element: " IR_UINT64_T_SPECIFIER,
         reader.docs_count() + irs::doc_limits::min()
       );
 
       return false;
     }
-
-    reader_ctx.doc_map = [&doc_id_map](doc_id_t doc) noexcept {
-      return doc >= doc_id_map.size()
-        ? irs::doc_limits::eof()
-        : doc_id_map[doc];
-    };
-  }
-
-  if (segment.meta.docs_count >= irs::doc_limits::eof()) {
-    // can't merge segments holding more than 'irs::doc_limits::eof()-1' docs
-    return false;
   }
 
   if (!progress()) {
@@ -1572,7 +1706,7 @@ bool merge_writer::flush_sorted(
     auto& payload = it.second->value;
 
     // fill doc id map
-    readers_[value.first].doc_id_map[it.first->value()] = next_id;
+    readers_[value.first].doc_map.set(it.first->value(), next_id);
 
     // write value into new column
     auto& stream = column.second(next_id);
@@ -1586,22 +1720,21 @@ bool merge_writer::flush_sorted(
   }
 
 #ifdef IRESEARCH_DEBUG
-  struct ne_eof {
-    bool operator()(doc_id_t doc) const noexcept {
-      return !doc_limits::eof(doc);
-    }
-  };
-
   // ensure doc ids for each segment are sorted
   for (auto& reader : readers_) {
-    auto& doc_map = reader.doc_id_map;
-    assert(doc_map.size() >= irs::doc_limits::min());
-    assert(
-      std::is_sorted(
-        boost::make_filter_iterator(ne_eof(), doc_map.begin(), doc_map.end()),
-        boost::make_filter_iterator(ne_eof(), doc_map.end(), doc_map.end())
-    ));
-    UNUSED(doc_map);
+    auto& doc_map = reader.doc_map;
+    doc_id_t last = doc_limits::invalid();
+
+    for (doc_id_t doc = doc_limits::min(),
+         end = doc_id_t(reader.reader->docs_count() + doc_limits::min());
+         doc < end; ++doc) {
+      const auto id = doc_map(doc);
+
+      if (!doc_limits::eof(id)) {
+        assert(last < id);
+        last = id;
+      }
+    }
   }
 #endif
 
@@ -1671,11 +1804,21 @@ bool merge_writer::flush(
 
   const auto& progress_callback = progress ? progress : PROGRESS_NOOP;
 
+  // in case of concurrent merge progress is reported from multiple threads
+  std::mutex progress_mutex;
+  bool aborted = false;
+  const flush_progress_t sync_progress_callback =
+      [&progress_callback, &progress_mutex, &aborted]() {
+    SCOPED_LOCK(progress_mutex);
+    aborted = aborted || !progress_callback();
+    return !aborted;
+  };
+
   tracking_directory track_dir(dir_); // track writer created files
 
   result = comparator_
     ? flush_sorted(track_dir, segment, progress_callback)
-    : flush(track_dir, segment, progress_callback);
+    : flush(track_dir, segment, pool_ ? sync_progress_callback : progress_callback);
 
   track_dir.flush_tracked(segment.meta.files);
 
@@ -27,7 +27,9 @@
 #include <vector>
 
 #include "column_info.hpp"
+#include "doc_id_map.hpp"
 #include "index_meta.hpp"
+#include "utils/async_utils.hpp"
 #include "utils/memory.hpp"
 #include "utils/noncopyable.hpp"
 #include "utils/string.hpp"
@@ -48,19 +50,24 @@ class IRESEARCH_API merge_writer: public util::noncopyable {
     explicit reader_ctx(sub_reader_ptr reader) noexcept;
 
     sub_reader_ptr reader; // segment reader
-    std::vector<doc_id_t> doc_id_map; // FIXME use bitpacking vector
-    std::function<doc_id_t(doc_id_t)> doc_map; // mapping function
+    doc_id_map doc_map; // mapping of segment documents to merged ones
   }; // reader_ctx
 
   merge_writer() noexcept;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @param pool if specified, field terms and columns of unsorted segments
+  ///        are merged concurrently using the given executor
+  //////////////////////////////////////////////////////////////////////////////
   explicit merge_writer(
       directory& dir,
       const column_info_provider_t& column_info,
-      const comparer* comparator = nullptr) noexcept
+      const comparer* comparator = nullptr,
+      async_utils::thread_pool* pool = nullptr) noexcept
     : dir_(dir),
       column_info_(&column_info),
-      comparator_(comparator) {
+      comparator_(comparator),
+      pool_(pool) {
     assert(column_info);
   }
 
@@ -120,6 +127,7 @@ class IRESEARCH_API merge_writer: public util::noncopyable {
   std::vector<reader_ctx> readers_;
   const column_info_provider_t* column_info_;
   const comparer* comparator_;
+  async_utils::thread_pool* pool_{}; // executor for concurrent merge
   IRESEARCH_API_PRIVATE_VARIABLES_END
 }; // merge_writer
 
@@ -21,19 +21,140 @@
 /// @author Vasiliy Nabatchikov
 ////////////////////////////////////////////////////////////////////////////////
 
-#include "utils/map_utils.hpp"
+#include "utils/math_utils.hpp"
 #include "utils/timer_utils.hpp"
 #include "utils/type_limits.hpp"
 #include "postings.hpp"
 
+#include <algorithm>
+#include <cstring>
+
+NS_LOCAL
+
+using namespace irs;
+
+typedef postings::sorted_postings_t::value_type entry_t;
+
+// number of entries below which radix sort falls back to comparison sort
+constexpr size_t RADIX_SORT_THRESHOLD = 32;
+
+bool less(const bytes_ref& lhs, const bytes_ref& rhs, size_t depth) noexcept {
+  assert(lhs.size() >= depth && rhs.size() >= depth);
+
+  const size_t size = std::min(lhs.size(), rhs.size()) - depth;
+  const auto res = std::memcmp(lhs.c_str() + depth, rhs.c_str() + depth, size);
+
+  if (0 == res) {
+    return lhs.size() < rhs.size();
+  }
+
+  return res < 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief MSD radix sort of terms, all terms in [begin;end) share a common
+///        prefix of 'depth' bytes
+////////////////////////////////////////////////////////////////////////////////
+void radix_sort(entry_t* begin, entry_t* end, entry_t* buf, size_t depth) {
+  while (size_t(std::distance(begin, end)) > RADIX_SORT_THRESHOLD) {
+    // bucket 0 is reserved for terms ending at 'depth'
+    size_t offsets[257]{};
+
+    for (auto* it = begin; it != end; ++it) {
+      const auto& term = (*it)->first;
+      ++offsets[term.size() > depth ? 1 + term[depth] : 0];
+    }
+
+    // skip bytes shared by all terms of the range
+    const auto size = size_t(std::distance(begin, end));
+    if (*std::max_element(offsets + 1, std::end(offsets)) == size) {
+      ++depth;
+      continue;
+    }
+
+    size_t offset = 0;
+    for (auto& count : offsets) {
+      const auto bucket_size = count;
+      count = offset;
+      offset += bucket_size;
+    }
+
+    for (auto* it = begin; it != end; ++it) {
+      const auto& term = (*it)->first;
+      buf[offsets[term.size() > depth ? 1 + term[depth] : 0]++] = *it;
+    }
+
+    std::copy(buf, buf + size, begin);
+
+    // terms are unique, so bucket 0 contains at most 1 entry
+    assert(offsets[0] <= 1);
+
+    for (size_t i = 1; i < 257; ++i) {
+      radix_sort(begin + offsets[i - 1], begin + offsets[i], buf, depth + 1);
+    }
+
+    return;
+  }
+
+  std::sort(begin, end, [depth](entry_t lhs, entry_t rhs) noexcept {
+    return less(lhs->first, rhs->first, depth);
+  });
+}
+
+NS_END
+
 NS_ROOT
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                           postings implementation
 // -----------------------------------------------------------------------------
 
-postings::postings(writer_t& writer):
-  writer_(writer) {
+postings::postings(writer_t& writer, size_t size_hint /*= 0*/)
+  : writer_(writer) {
+  reserve(size_hint);
+}
+
+void postings::clear() noexcept {
+  postings_.clear();
+  std::fill(slots_.begin(), slots_.end(), slot{ 0, EMPTY_SLOT });
+}
+
+void postings::reserve(size_t size) {
+  if (!size) {
+    return;
+  }
+
+  postings_.reserve(size);
+
+  // keep load factor below 0.5
+  const auto capacity = math::roundup_power2(2*size);
+
+  if (capacity > slots_.size()) {
+    rehash(capacity);
+  }
+}
+
+void postings::rehash(size_t capacity) {
+  assert(math::is_power2(capacity));
+  assert(capacity > 2*postings_.size());
+
+  std::vector<slot> slots(capacity, slot{ 0, EMPTY_SLOT });
+  const size_t mask = capacity - 1;
+
+  for (auto& entry : slots_) {
+    if (EMPTY_SLOT == entry.index) {
+      continue;
+    }
+
+    for (size_t i = entry.hash & mask; ; i = (i + 1) & mask) {
+      if (EMPTY_SLOT == slots[i].index) {
+        slots[i] = entry;
+        break;
+      }
+    }
+  }
+
+  slots_ = std::move(slots);
 }
 
 postings::emplace_result postings::emplace(const bytes_ref& term) {
@@ -46,9 +167,27 @@ postings::emplace_result postings::emplace(const bytes_ref& term) {
   if (writer_t::container::block_type::SIZE < max_term_len) {
     // TODO: maybe move big terms it to a separate storage
     // reject terms that do not fit in a block
-    return std::make_pair(map_.end(), false);
+    return std::make_pair(postings_.end(), false);
+  }
+
+  if (2*(postings_.size() + 1) > slots_.size()) {
+    rehash((std::max)(size_t(16), 2*slots_.size()));
+  }
+
+  const auto hash = uint32_t(std::hash<bytes_ref>()(term));
+  const size_t mask = slots_.size() - 1;
+  size_t i = hash & mask;
+
+  for (; EMPTY_SLOT != slots_[i].index; i = (i + 1) & mask) {
+    const auto& entry = slots_[i];
+
+    if (entry.hash == hash && postings_[entry.index].first == term) {
+      return std::make_pair(postings_.begin() + entry.index, false);
+    }
   }
 
+  assert(size() < doc_limits::eof()); // not larger then the static flag
+
   const auto slice_end = writer_.pool_offset() + max_term_len;
   const auto next_block_start = writer_.pool_offset() < parent.value_count()
                         ? writer_.position().block_offset() + writer_t::container::block_type::SIZE
@@ -59,26 +198,30 @@ postings::emplace_result postings::emplace(const bytes_ref& term) {
     writer_.seek(next_block_start);
   }
 
-  assert(size() < doc_limits::eof()); // not larger then the static flag
-
-  auto generator = [&term, this](const hashed_bytes_ref& key, const posting&) {
-    // for new terms also write out their value
-    writer_.write(term.c_str(), term.size());
-
-    // reuse hash but point ref at data in pool
-    return hashed_bytes_ref(
-      key.hash(),
-      (writer_.position() - term.size()).buffer(), term.size()
-    );
-  };
+  writer_.write(term.c_str(), term.size());
 
   // replace original reference to 'term' provided by the caller
   // with a reference to the cached copy in 'writer_'
-  return map_utils::try_emplace_update_key(
-    map_,                  // container
-    generator,             // key generator
-    make_hashed_ref(term)  // key
-  );
+  postings_.emplace_back(
+    std::piecewise_construct,
+    std::forward_as_tuple((writer_.position() - term.size()).buffer(), term.size()),
+    std::forward_as_tuple());
+
+  slots_[i] = slot{ hash, uint32_t(postings_.size() - 1) };
+
+  return std::make_pair(--postings_.end(), true);
+}
+
+void postings::get_sorted_postings(sorted_postings_t& sorted) const {
+  sorted.resize(postings_.size());
+
+  auto* begin = sorted.data();
+  for (auto& entry : postings_) {
+    *begin++ = &entry;
+  }
+
+  sorted_postings_t buf(sorted.size());
+  radix_sort(sorted.data(), sorted.data() + sorted.size(), buf.data(), 0);
 }
 
 NS_END
@@ -24,7 +24,8 @@
 #ifndef IRESEARCH_POSTINGS_H
 #define IRESEARCH_POSTINGS_H
 
-#include <unordered_map>
+#include <limits>
+#include <vector>
 
 #include "shared.hpp"
 #include "utils/block_pool.hpp"
@@ -53,30 +54,57 @@ struct posting {
   doc_id_t size{ 1 }; // length of postings
 };
 
+////////////////////////////////////////////////////////////////////////////////
+/// @class postings
+/// @brief in-memory postings of a field, terms are stored in a byte pool and
+///        looked up via open-addressing hash table of indices of postings,
+///        i.e. no allocations per unique term are made
+////////////////////////////////////////////////////////////////////////////////
 class IRESEARCH_API postings: util::noncopyable {
  public:
-  typedef std::unordered_map<hashed_bytes_ref, posting> map_t;
-  typedef std::pair<map_t::iterator, bool> emplace_result;
+  typedef std::vector<std::pair<bytes_ref, posting>> container_t;
+  typedef std::pair<container_t::iterator, bool> emplace_result;
+  typedef std::vector<const container_t::value_type*> sorted_postings_t;
   typedef byte_block_pool::inserter writer_t;
 
-  postings(writer_t& writer);
+  explicit postings(writer_t& writer, size_t size_hint = 0);
 
-  inline map_t::const_iterator begin() const { return map_.begin(); }
+  // returns postings in order of insertion
+  inline container_t::const_iterator begin() const { return postings_.begin(); }
 
-  inline void clear() { map_.clear(); }
+  // does not release allocated memory
+  void clear() noexcept;
 
   // on error returns std::ptr(end(), false)
   emplace_result emplace(const bytes_ref& term);
 
-  inline bool empty() const { return map_.empty(); }
+  inline bool empty() const { return postings_.empty(); }
+
+  inline container_t::const_iterator end() const { return postings_.end(); }
+
+  // reserves space for at least 'size' postings
+  void reserve(size_t size);
 
-  inline map_t::const_iterator end() const { return map_.end(); }
+  inline size_t size() const { return postings_.size(); }
 
-  inline size_t size() const { return map_.size(); }
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief fills 'sorted' with postings ordered by term
+  //////////////////////////////////////////////////////////////////////////////
+  void get_sorted_postings(sorted_postings_t& sorted) const;
 
  private:
+  struct slot {
+    uint32_t hash; // lower bits of the term hash
+    uint32_t index; // index of the posting in 'postings_'
+  }; // slot
+
+  static constexpr uint32_t EMPTY_SLOT = std::numeric_limits<uint32_t>::max();
+
+  void rehash(size_t capacity);
+
   IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
-  map_t map_;
+  container_t postings_;
+  std::vector<slot> slots_; // size is either 0 or a power of 2
   writer_t& writer_;
   IRESEARCH_API_PRIVATE_VARIABLES_END
 };
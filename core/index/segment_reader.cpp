@@ -77,25 +77,15 @@ class mask_doc_iterator final : public irs::doc_iterator {
   }
 
   virtual bool next() override {
-    while (it_->next()) {
-      if (mask_.find(value()) == mask_.end()) {
-        return true;
-      }
+    if (!it_->next()) {
+      return false;
     }
 
-    return false;
+    return !irs::doc_limits::eof(skip_masked(value()));
   }
 
   virtual irs::doc_id_t seek(irs::doc_id_t target) override {
-    const auto doc = it_->seek(target);
-
-    if (mask_.find(doc) == mask_.end()) {
-      return doc;
-    }
-
-    next();
-
-    return value();
+    return skip_masked(it_->seek(target));
   }
 
   virtual irs::doc_id_t value() const override {
@@ -107,6 +97,15 @@ class mask_doc_iterator final : public irs::doc_iterator {
   }
 
  private:
+  // skip whole runs of masked documents instead of checking them one by one
+  irs::doc_id_t skip_masked(irs::doc_id_t doc) {
+    while (mask_.contains(doc)) {
+      doc = it_->seek(mask_.next_unmasked(doc + 1));
+    }
+
+    return doc;
+  }
+
   const irs::document_mask& mask_; // excluded document ids
   irs::doc_iterator::ptr it_;
 }; // mask_doc_iterator
@@ -125,14 +124,17 @@ class masked_docs_iterator
   }
 
   virtual bool next() override {
-    while (next_ < end_) {
-      current_.value = next_++;
+    if (next_ < end_) {
+      // skips masked documents word-at-a-time
+      current_.value = docs_mask_.next_unmasked(next_);
 
-      if (docs_mask_.find(current_.value) == docs_mask_.end()) {
+      if (current_.value < end_) {
+        next_ = current_.value + 1;
         return true;
       }
     }
 
+    next_ = end_;
     current_.value = irs::doc_limits::eof();
 
     return false;
@@ -240,6 +242,13 @@ class segment_reader_impl : public sub_reader {
     const segment_meta& meta
   );
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief open a reader for another version of the same segment, in case
+  ///        if only document mask differs, only the mask is read while
+  ///        segment data readers are shared with the current reader
+  //////////////////////////////////////////////////////////////////////////////
+  sub_reader::ptr reopen(const segment_meta& meta) const;
+
   const directory& dir() const noexcept { 
     return dir_;
   }
@@ -260,27 +269,27 @@ class segment_reader_impl : public sub_reader {
       return nullptr;
     }
 
-    if (docs_mask_.empty()) {
+    if (docs_mask_->empty()) {
       return std::move(it);
     }
 
-    return memory::make_managed<mask_doc_iterator>(std::move(it), docs_mask_);
+    return memory::make_managed<mask_doc_iterator>(std::move(it), *docs_mask_);
   }
 
   virtual const term_reader* field(const string_ref& name) const override {
-    return field_reader_->field(name);
+    return data_->fields->field(name);
   }
 
   virtual field_iterator::ptr fields() const override {
-    return field_reader_->iterator();
+    return data_->fields->iterator();
   }
 
   virtual uint64_t live_docs_count() const noexcept override {
-    return docs_count_ - docs_mask_.size();
+    return docs_count_ - docs_mask_->size();
   }
 
   uint64_t meta_version() const noexcept {
-    return meta_version_;
+    return meta_.version;
   }
 
   virtual const sub_reader& operator[](size_t i) const noexcept override {
@@ -293,7 +302,7 @@ class segment_reader_impl : public sub_reader {
   }
 
   virtual const columnstore_reader::column_reader* sort() const noexcept override {
-    return sort_;
+    return data_->sort;
   }
 
   virtual const columnstore_reader::column_reader* column_reader(
@@ -302,21 +311,32 @@ class segment_reader_impl : public sub_reader {
 
  private:
   DECLARE_SHARED_PTR(segment_reader_impl); // required for NAMED_PTR(...)
-  std::vector<column_meta> columns_;
-  columnstore_reader::ptr columnstore_reader_;
-  const columnstore_reader::column_reader* sort_{};
+
+  // immutable data of a segment shared between readers
+  // of different versions of the segment
+  struct segment_data {
+    std::vector<column_meta> columns;
+    columnstore_reader::ptr columnstore;
+    const columnstore_reader::column_reader* sort{};
+    std::shared_ptr<const document_mask> docs_mask; // mask used for 'fields'
+    field_reader::ptr fields;
+    std::vector<column_meta*> id_to_column;
+    std::unordered_map<hashed_string_ref, column_meta*> name_to_column;
+  }; // segment_data
+
+  static std::shared_ptr<const document_mask> read_document_mask(
+    const directory& dir,
+    const segment_meta& meta);
+
+  std::shared_ptr<const segment_data> data_;
   const directory& dir_;
   uint64_t docs_count_;
-  document_mask docs_mask_;
-  field_reader::ptr field_reader_;
-  std::vector<column_meta*> id_to_column_;
-  uint64_t meta_version_;
-  std::unordered_map<hashed_string_ref, column_meta*> name_to_column_;
+  std::shared_ptr<const document_mask> docs_mask_;
+  segment_meta meta_;
 
   segment_reader_impl(
     const directory& dir,
-    uint64_t meta_version,
-    uint64_t docs_count
+    const segment_meta& meta
   );
 };
 
@@ -372,7 +392,7 @@ segment_reader segment_reader::reopen(const segment_meta& meta) const {
   // reuse self if no changes to meta
   return reader_impl.meta_version() == meta.version
     ? *this
-    : segment_reader_impl::open(reader_impl.dir(), meta);
+    : reader_impl.reopen(meta);
 }
 
 // -------------------------------------------------------------------
@@ -381,17 +401,26 @@ segment_reader segment_reader::reopen(const segment_meta& meta) const {
 
 segment_reader_impl::segment_reader_impl(
     const directory& dir,
-    uint64_t meta_version,
-    uint64_t docs_count)
+    const segment_meta& meta)
   : dir_(dir),
-    docs_count_(docs_count),
-    meta_version_(meta_version) {
+    docs_count_(meta.docs_count),
+    meta_(meta) {
+}
+
+/*static*/ std::shared_ptr<const document_mask> segment_reader_impl::read_document_mask(
+    const directory& dir,
+    const segment_meta& meta) {
+  auto docs_mask = memory::make_shared<document_mask>();
+  index_utils::read_document_mask(*docs_mask, dir, meta);
+
+  return docs_mask;
 }
 
 const column_meta* segment_reader_impl::column(
     const string_ref& name) const {
-  auto it = name_to_column_.find(make_hashed_ref(name));
-  return it == name_to_column_.end() ? nullptr : it->second;
+  auto& name_to_column = data_->name_to_column;
+  auto it = name_to_column.find(make_hashed_ref(name));
+  return it == name_to_column.end() ? nullptr : it->second;
 }
 
 column_iterator::ptr segment_reader_impl::columns() const {
@@ -407,12 +436,14 @@ column_iterator::ptr segment_reader_impl::columns() const {
     string_ref, column_meta, column_iterator, less
   > iterator_t;
 
+  auto& columns = data_->columns;
+
   return memory::make_managed<iterator_t>(
-    columns_.data(), columns_.data() + columns_.size());
+    columns.data(), columns.data() + columns.size());
 }
 
 doc_iterator::ptr segment_reader_impl::docs_iterator() const {
-  if (docs_mask_.empty()) {
+  if (docs_mask_->empty()) {
     return memory::make_managed<::all_iterator>(docs_count_);
   }
 
@@ -420,26 +451,29 @@ doc_iterator::ptr segment_reader_impl::docs_iterator() const {
   return memory::make_managed<masked_docs_iterator>(
     doc_limits::min(),
     doc_id_t(doc_limits::min() + docs_count_),
-    docs_mask_);
+    *docs_mask_);
 }
 
 /*static*/ sub_reader::ptr segment_reader_impl::open(
     const directory& dir, const segment_meta& meta) {
   auto& codec = *meta.codec;
 
-  PTR_NAMED(segment_reader_impl, reader, dir, meta.version, meta.docs_count);
+  PTR_NAMED(segment_reader_impl, reader, dir, meta);
+
+  auto data = memory::make_shared<segment_data>();
 
   // read document mask
-  index_utils::read_document_mask(reader->docs_mask_, dir, meta);
+  reader->docs_mask_ = read_document_mask(dir, meta);
+  data->docs_mask = reader->docs_mask_;
 
   // initialize mandatory field reader
-  auto& field_reader = reader->field_reader_;
+  auto& field_reader = data->fields;
   field_reader = codec.get_field_reader();
-  field_reader->prepare(dir, meta, reader->docs_mask_);
+  field_reader->prepare(dir, meta, *data->docs_mask);
 
   // initialize optional columnstore
   if (segment_reader::has<irs::columnstore_reader>(meta)) {
-    auto& columnstore_reader = reader->columnstore_reader_;
+    auto& columnstore_reader = data->columnstore;
     columnstore_reader  = codec.get_columnstore_reader();
 
     if (!columnstore_reader->prepare(dir, meta)) {
@@ -450,9 +484,9 @@ doc_iterator::ptr segment_reader_impl::docs_iterator() const {
     }
 
     if (field_limits::valid(meta.sort)) {
-      reader->sort_ = columnstore_reader->column(meta.sort);
+      data->sort = columnstore_reader->column(meta.sort);
 
-      if (!reader->sort_) {
+      if (!data->sort) {
         throw index_error(string_utils::to_string(
           "failed to find sort column '" IR_UINT64_T_SPECIFIER "' (according to meta) in columnstore in segment '%s'",
           meta.sort, meta.name.c_str()
@@ -466,18 +500,67 @@ doc_iterator::ptr segment_reader_impl::docs_iterator() const {
     codec,
     dir,
     meta,
-    reader->columns_,
-    reader->id_to_column_,
-    reader->name_to_column_
+    data->columns,
+    data->id_to_column,
+    data->name_to_column
   );
 
+  reader->data_ = std::move(data);
+
+  return reader;
+}
+
+sub_reader::ptr segment_reader_impl::reopen(const segment_meta& meta) const {
+  // data files of a segment are never modified, a new version
+  // of a segment differs only by its document mask
+  auto same_data = [this](const segment_meta& meta) {
+    if (meta.name != meta_.name
+        || meta.codec != meta_.codec
+        || meta.docs_count != meta_.docs_count
+        || meta.column_store != meta_.column_store
+        || meta.sort != meta_.sort) {
+      return false;
+    }
+
+    auto mask_writer = meta.codec->get_document_mask_writer();
+    const auto lhs_mask = mask_writer->filename(meta_);
+    const auto rhs_mask = mask_writer->filename(meta);
+
+    // all files except document masks must match
+    size_t count = 0;
+
+    for (auto& file : meta_.files) {
+      if (file == lhs_mask) {
+        continue;
+      }
+
+      if (!meta.files.count(file)) {
+        return false;
+      }
+
+      ++count;
+    }
+
+    return count + meta.files.count(rhs_mask) == meta.files.size();
+  };
+
+  if (!meta.codec || !same_data(meta)) {
+    return open(dir_, meta);
+  }
+
+  PTR_NAMED(segment_reader_impl, reader, dir_, meta);
+  reader->data_ = data_; // share segment data
+  reader->docs_mask_ = read_document_mask(dir_, meta);
+
   return reader;
 }
 
 const columnstore_reader::column_reader* segment_reader_impl::column_reader(
     field_id field) const {
-  return columnstore_reader_
-    ? columnstore_reader_->column(field)
+  auto& columnstore = data_->columnstore;
+
+  return columnstore
+    ? columnstore->column(field)
     : nullptr;
 }
 
@@ -260,14 +260,14 @@ void segment_writer::flush_fields(const doc_map& docmap) {
 
 size_t segment_writer::flush_doc_mask(const segment_meta &meta) {
   document_mask docs_mask;
-  docs_mask.reserve(docs_mask_.size());
+  docs_mask.reserve(doc_id_t(docs_mask_.size() + doc_limits::min()));
 
   for (size_t doc_id = 0, doc_id_end = docs_mask_.size();
        doc_id < doc_id_end;
        ++doc_id) {
     if (docs_mask_.test(doc_id)) {
       assert(size_t(integer_traits<doc_id_t>::const_max) >= doc_id + doc_limits::min());
-      docs_mask.emplace(doc_id_t(doc_id + doc_limits::min()));
+      docs_mask.insert(doc_id_t(doc_id + doc_limits::min()));
     }
   }
 
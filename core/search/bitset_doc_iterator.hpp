@@ -40,6 +40,12 @@ class bitset_doc_iterator final
     : bitset_doc_iterator(set, order::prepared::unordered()) {
   }
 
+  // iterator shares ownership of the specified bitset
+  explicit bitset_doc_iterator(std::shared_ptr<const bitset> set)
+    : bitset_doc_iterator(*set) {
+    owner_ = std::move(set);
+  }
+
   bitset_doc_iterator(
     const sub_reader& reader,
     const byte_type* stats,
@@ -56,6 +62,7 @@ class bitset_doc_iterator final
 
   bitset_doc_iterator(const bitset& set, const order::prepared& ord);
 
+  std::shared_ptr<const bitset> owner_; // keeps shared bitset alive
   cost cost_;
   document doc_;
   score score_;
@@ -30,6 +30,10 @@
 #include "index/field_meta.hpp"
 #include "utils/math_utils.hpp"
 
+#ifdef IRESEARCH_SSE2
+#include <emmintrin.h>
+#endif
+
 NS_LOCAL
 
 const irs::math::sqrt<uint32_t, float_t, 1024> SQRT;
@@ -346,6 +350,107 @@ struct norm_score_ctx final : public score_ctx {
   float_t norm_length_{ 0.f }; // precomputed 'k*b/avgD' if norms present, '0' otherwise
 }; // norm_score_ctx
 
+struct bound_ctx final : public irs::score_ctx {
+  bound_ctx(
+      byte_type* score_buf,
+      float_t k,
+      irs::boost_t boost,
+      const bm25::stats& stats,
+      const frequency_bound* freq) noexcept
+    : score_buf(score_buf),
+      freq_(freq),
+      num_(boost * (k + 1) * stats.idf),
+      norm_const_(k) {
+    assert(freq_);
+  }
+
+  byte_type* score_buf;
+  const frequency_bound* freq_; // block frequency bound
+  float_t num_; // partially precomputed numerator : boost * (k + 1) * idf
+  float_t norm_const_; // 'k' or 'k*(1-b)' factor
+}; // bound_ctx
+
+struct block_ctx final : public irs::score_ctx {
+  block_ctx(
+      float_t k,
+      irs::boost_t boost,
+      const bm25::stats& stats,
+      irs::norm&& norm) noexcept
+    : norm_(std::move(norm)),
+      num_(boost * (k + 1) * stats.idf),
+      norm_const_(k) {
+    // if there is no norms, assume that b==0
+    if (!norm_.empty()) {
+      norm_const_ = stats.norm_const;
+      norm_length_ = stats.norm_length;
+    }
+  }
+
+  irs::norm norm_;
+  float_t num_; // partially precomputed numerator : boost * (k + 1) * idf
+  float_t norm_const_; // 'k' factor
+  float_t norm_length_{ 0.f }; // precomputed 'k*b/avgD' if norms present, '0' otherwise
+}; // block_ctx
+
+// number of documents scored at once by 'score_block'
+constexpr size_t SCORE_BLOCK_SIZE = 64;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief scores a block of documents, evaluates the same expression as the
+///        per-document scorers, the 'num * tf / (denom + tf)' part is
+///        vectorized, length norms are read one by one
+////////////////////////////////////////////////////////////////////////////////
+void score_block(
+    irs::score_ctx* ctx,
+    const doc_id_t* docs,
+    const uint32_t* freqs,
+    size_t count,
+    byte_type* scores,
+    size_t stride) {
+  auto& state = *static_cast<bm25::block_ctx*>(ctx);
+
+  float_t denoms[SCORE_BLOCK_SIZE]; // 'norm_const + norm_length * norm'
+  float_t values[SCORE_BLOCK_SIZE];
+
+  while (count) {
+    const size_t size = std::min(count, SCORE_BLOCK_SIZE);
+
+    if (state.norm_.empty()) {
+      std::fill_n(denoms, size, state.norm_const_);
+    } else {
+      for (size_t i = 0; i < size; ++i) {
+        denoms[i] = state.norm_const_ + state.norm_length_ * state.norm_.read(docs[i]);
+      }
+    }
+
+    size_t i = 0;
+
+#ifdef IRESEARCH_SSE2
+    const __m128 num = _mm_set1_ps(state.num_);
+
+    for (; i + 4 <= size; i += 4) {
+      const __m128i freq = _mm_loadu_si128(reinterpret_cast<const __m128i*>(freqs + i));
+      const __m128 tf = _mm_sqrt_ps(_mm_cvtepi32_ps(freq));
+      const __m128 denom = _mm_add_ps(_mm_loadu_ps(denoms + i), tf);
+      _mm_storeu_ps(values + i, _mm_div_ps(_mm_mul_ps(num, tf), denom));
+    }
+#endif
+
+    for (; i < size; ++i) {
+      const float_t tf = ::SQRT(freqs[i]);
+      values[i] = state.num_ * tf / (denoms[i] + tf);
+    }
+
+    for (i = 0; i < size; ++i, scores += stride) {
+      irs::sort::score_cast<score_t>(scores) = values[i];
+    }
+
+    docs += size;
+    freqs += size;
+    count -= size;
+  }
+}
+
 class sort final : public irs::prepared_sort_basic<bm25::score_t, bm25::stats> {
  public:
   sort(float_t k, float_t b) noexcept
@@ -511,6 +616,82 @@ class sort final : public irs::prepared_sort_basic<bm25::score_t, bm25::stats> {
     }
   }
 
+  virtual score_function prepare_bound(
+      const sub_reader& /*segment*/,
+      const term_reader& /*field*/,
+      const byte_type* query_stats,
+      byte_type* bound_buf,
+      const attribute_provider& doc_attrs,
+      boost_t boost) const override {
+    auto* freq = irs::get<frequency_bound>(doc_attrs);
+
+    if (!freq || boost < 0.f || irs::get<irs::filter_boost>(doc_attrs)) {
+      // unbounded
+      return { nullptr, nullptr };
+    }
+
+    auto& stats = stats_cast(query_stats);
+
+    // 'norm_length * norm' is non-negative, hence
+    // 'num * tf / (norm_const + tf)' is an upper bound for a given 'tf'
+    auto ctx = memory::make_unique<bm25::bound_ctx>(bound_buf, k_, boost, stats, freq);
+
+    if (b_ != 0.f) {
+      // norms might be absent in the segment, 'k' is used in this case
+      ctx->norm_const_ = std::min(ctx->norm_const_, stats.norm_const);
+    }
+
+    if (ctx->norm_const_ < 0.f) {
+      // non-monotonic function of 'tf'
+      return { nullptr, nullptr };
+    }
+
+    return {
+      std::move(ctx),
+      [](irs::score_ctx* ctx) noexcept -> const byte_type* {
+        auto& state = *static_cast<bm25::bound_ctx*>(ctx);
+
+        const float_t tf = ::SQRT(state.freq_->value());
+        irs::sort::score_cast<score_t>(state.score_buf) = state.num_ * tf / (state.norm_const_ + tf);
+
+        return state.score_buf;
+      }
+    };
+  }
+
+  virtual block_score_function prepare_block_scorer(
+      const sub_reader& segment,
+      const term_reader& field,
+      const byte_type* query_stats,
+      const attribute_provider& doc_attrs,
+      boost_t boost) const override {
+    if (!irs::get<frequency>(doc_attrs) || irs::get<irs::filter_boost>(doc_attrs)) {
+      // scores don't depend on frequency or depend on
+      // a per-document boost, see 'prepare_scorer'
+      return {};
+    }
+
+    irs::norm norm;
+
+    if (b_ != 0.f) {
+      auto* doc = irs::get<document>(doc_attrs);
+
+      if (!doc) {
+        // we need 'document' attribute to be exposed
+        return {};
+      }
+
+      if (!norm.reset(segment, field.meta().norm, *doc)) {
+        norm.clear(); // BM15
+      }
+    }
+
+    return {
+      memory::make_unique<bm25::block_ctx>(k_, boost, stats_cast(query_stats), std::move(norm)),
+      &bm25::score_block
+    };
+  }
+
   virtual irs::sort::term_collector::ptr prepare_term_collector() const override {
     return irs::memory::make_unique<term_collector>();
   }
@@ -28,6 +28,7 @@
 #include "disjunction.hpp"
 #include "min_match_disjunction.hpp"
 #include "exclusion.hpp"
+#include "max_score_disjunction.hpp"
 
 NS_LOCAL
 
@@ -86,6 +87,15 @@ irs::doc_iterator::ptr make_disjunction(
       std::move(itrs), ord, std::forward<Args>(args)...);
   }
 
+  if constexpr (0 == sizeof...(Args)) {
+    using max_score_disjunction_t = irs::max_score_disjunction<irs::doc_iterator::ptr>;
+
+    // all sub-iterators provide score bounds, enable top-k pruning
+    if (max_score_disjunction_t::applicable(itrs, ord, irs::sort::MergeType::AGGREGATE)) {
+      return irs::memory::make_managed<max_score_disjunction_t>(std::move(itrs), ord);
+    }
+  }
+
   return irs::make_disjunction<scored_disjunction_t>(
     std::move(itrs), ord, std::forward<Args>(args)...);
 }
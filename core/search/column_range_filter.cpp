@@ -0,0 +1,258 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "column_range_filter.hpp"
+
+#include "analysis/token_attributes.hpp"
+#include "formats/empty_term_reader.hpp"
+#include "index/index_reader.hpp"
+#include "search/cost.hpp"
+#include "search/score.hpp"
+#include "utils/frozen_attributes.hpp"
+
+NS_LOCAL
+
+using namespace irs;
+
+using range_t = by_column_range_options::range_type;
+
+bool is_min(const bytes_ref& value, const range_t& rng) noexcept {
+  switch (rng.min_type) {
+    case BoundType::INCLUSIVE:
+      return compare(value, rng.min) >= 0;
+    case BoundType::EXCLUSIVE:
+      return compare(value, rng.min) > 0;
+    default:
+      return true;
+  }
+}
+
+bool is_max(const bytes_ref& value, const range_t& rng) noexcept {
+  switch (rng.max_type) {
+    case BoundType::INCLUSIVE:
+      return compare(value, rng.max) <= 0;
+    case BoundType::EXCLUSIVE:
+      return compare(value, rng.max) < 0;
+    default:
+      return true;
+  }
+}
+
+bool in_range(const bytes_ref& value, const range_t& rng) noexcept {
+  return is_min(value, rng) && is_max(value, rng);
+}
+
+bool is_empty(const range_t& rng) noexcept {
+  if (BoundType::UNBOUNDED == rng.min_type
+      || BoundType::UNBOUNDED == rng.max_type) {
+    return false;
+  }
+
+  const auto cmp = compare(bytes_ref(rng.min), rng.max);
+
+  return cmp > 0 || (0 == cmp && (BoundType::EXCLUSIVE == rng.min_type
+                                  || BoundType::EXCLUSIVE == rng.max_type));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class column_range_iterator
+/// @brief returns documents of an underlying column iterator which values
+///        fall into a specified range
+////////////////////////////////////////////////////////////////////////////////
+class column_range_iterator final
+    : public frozen_attributes<3, doc_iterator> {
+ public:
+  column_range_iterator(
+      doc_iterator::ptr&& it,
+      const payload& value,
+      const range_t& rng)
+    : attributes{{
+        { type<document>::id(), &doc_   },
+        { type<cost>::id(),     &cost_  },
+        { type<score>::id(),    &score_ },
+      }},
+      cost_(cost::extract(*it)),
+      it_(std::move(it)),
+      value_(&value),
+      rng_(&rng) {
+    assert(it_);
+  }
+
+  virtual doc_id_t value() const noexcept override {
+    return doc_.value;
+  }
+
+  virtual bool next() override {
+    while (it_->next()) {
+      if (in_range(value_->value, *rng_)) {
+        doc_.value = it_->value();
+        return true;
+      }
+    }
+
+    doc_.value = doc_limits::eof();
+    return false;
+  }
+
+  virtual doc_id_t seek(doc_id_t target) override {
+    if (target <= doc_.value) {
+      return doc_.value;
+    }
+
+    const auto doc = it_->seek(target);
+
+    if (doc_limits::eof(doc) || in_range(value_->value, *rng_)) {
+      doc_.value = doc;
+    } else {
+      next();
+    }
+
+    return doc_.value;
+  }
+
+ private:
+  document doc_;
+  cost cost_;
+  score score_;
+  doc_iterator::ptr it_;
+  const payload* value_;
+  const range_t* rng_;
+}; // column_range_iterator
+
+class column_range_query final : public filter::prepared {
+ public:
+  column_range_query(
+      const std::string& field,
+      const range_t& rng,
+      bstring&& stats,
+      boost_t boost)
+    : filter::prepared(boost),
+      field_(field),
+      rng_(rng),
+      stats_(std::move(stats)) {
+  }
+
+  virtual doc_iterator::ptr execute(
+      const sub_reader& segment,
+      const order::prepared& ord,
+      const attribute_provider* /*ctx*/) const override {
+    const auto* column = segment.column_reader(field_);
+
+    if (!column) {
+      return doc_iterator::empty();
+    }
+
+    auto it = iterator(*column);
+
+    if (IRS_UNLIKELY(!it)) {
+      return doc_iterator::empty();
+    }
+
+    if (!ord.empty()) {
+      auto* score = irs::get_mutable<irs::score>(it.get());
+
+      if (score) {
+        order::prepared::scorers scorers(
+          ord, segment, empty_term_reader(column->size()),
+          stats_.c_str(), score->realloc(ord), *it, boost());
+
+        irs::reset(*score, std::move(scorers));
+      }
+    }
+
+    return it;
+  }
+
+ private:
+  doc_iterator::ptr iterator(const columnstore_reader::column_reader& column) const {
+    const auto bounds = column.bounds();
+
+    if (!bounds.first.null() && !bounds.second.null()
+        && is_min(bounds.first, rng_) && is_max(bounds.second, rng_)) {
+      // all values of the column fall into the range
+      return column.iterator();
+    }
+
+    const bytes_ref min = BoundType::UNBOUNDED == rng_.min_type
+      ? bytes_ref::NIL
+      : bytes_ref(rng_.min);
+    const bytes_ref max = BoundType::UNBOUNDED == rng_.max_type
+      ? bytes_ref::NIL
+      : bytes_ref(rng_.max);
+
+    auto it = column.iterator(min, max);
+
+    if (IRS_UNLIKELY(!it)) {
+      return doc_iterator::empty();
+    }
+
+    const auto* value = irs::get<payload>(*it);
+
+    if (!value) {
+      // column doesn't store any data, i.e. all values are empty
+      return in_range(bytes_ref::EMPTY, rng_)
+        ? std::move(it)
+        : doc_iterator::empty();
+    }
+
+    return memory::make_managed<column_range_iterator>(std::move(it), *value, rng_);
+  }
+
+  std::string field_;
+  range_t rng_;
+  bstring stats_;
+}; // column_range_query
+
+NS_END
+
+NS_ROOT
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                    by_column_range implementation
+// -----------------------------------------------------------------------------
+
+DEFINE_FACTORY_DEFAULT(by_column_range)
+
+filter::prepared::ptr by_column_range::prepare(
+    const index_reader& reader,
+    const order::prepared& order,
+    boost_t filter_boost,
+    const attribute_provider* /*ctx*/) const {
+  if (is_empty(options().range)) {
+    return prepared::empty();
+  }
+
+  // skip field-level/term-level statistics because there are no explicit
+  // fields/terms, but still collect index-level statistics
+  // i.e. all fields and terms implicitly match
+  bstring stats(order.stats_size(), 0);
+  auto* stats_buf = const_cast<byte_type*>(stats.data());
+
+  order.prepare_collectors(stats_buf, reader);
+
+  filter_boost *= boost();
+
+  return memory::make_managed<column_range_query>(
+    field(), options().range, std::move(stats), filter_boost);
+}
+
+NS_END // ROOT
@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_COLUMN_RANGE_FILTER_H
+#define IRESEARCH_COLUMN_RANGE_FILTER_H
+
+#include "filter.hpp"
+#include "search_range.hpp"
+#include "utils/string.hpp"
+
+NS_ROOT
+
+class by_column_range;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @struct by_column_range_options
+/// @brief options for column range filter
+////////////////////////////////////////////////////////////////////////////////
+struct IRESEARCH_API by_column_range_options {
+  using filter_type = by_column_range;
+  using range_type = search_range<bstring>;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief range of stored values, values are compared lexicographically
+  //////////////////////////////////////////////////////////////////////////////
+  range_type range;
+
+  bool operator==(const by_column_range_options& rhs) const noexcept {
+    return range == rhs.range;
+  }
+
+  size_t hash() const noexcept {
+    return std::hash<range_type>()(range);
+  }
+}; // by_column_range_options
+
+//////////////////////////////////////////////////////////////////////////////
+/// @class by_column_range
+/// @brief user-side filter matching documents which values stored in a
+///        column specified by 'field()' fall into a given range
+/// @note blocks of a column which value bounds don't intersect with the
+///       range aren't read at all, value bounds are stored by format 1_4
+///       and later ('iresearch_10_columnstore' version 2) for columns
+///       with values up to 64 bytes, e.g. big-endian encoded numbers
+//////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API by_column_range final
+    : public filter_base<by_column_range_options> {
+ public:
+  static constexpr string_ref type_name() noexcept {
+    return "iresearch::by_column_range";
+  }
+
+  DECLARE_FACTORY();
+
+  using filter::prepare;
+
+  virtual filter::prepared::ptr prepare(
+    const index_reader& rdr,
+    const order::prepared& ord,
+    boost_t boost,
+    const attribute_provider* ctx) const override;
+}; // by_column_range
+
+NS_END // ROOT
+
+NS_BEGIN(std)
+
+template<>
+struct hash<::iresearch::by_column_range_options> {
+  size_t operator()(const ::iresearch::by_column_range_options& v) const noexcept {
+    return v.hash();
+  }
+};
+
+NS_END
+
+#endif // IRESEARCH_COLUMN_RANGE_FILTER_H
@@ -0,0 +1,304 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include <rapidjson/rapidjson/document.h> // for rapidjson::Document
+
+#include "column_sort.hpp"
+
+#include "analysis/token_attributes.hpp"
+#include "index/index_reader.hpp"
+#include "store/store_utils.hpp"
+#include "utils/log.hpp"
+
+NS_LOCAL
+
+using namespace irs;
+
+const string_ref COLUMN_PARAM_NAME = "column";
+const string_ref TYPE_PARAM_NAME = "type";
+
+const std::pair<string_ref, column_sort::ValueType> VALUE_TYPES[] {
+  { "int", column_sort::ValueType::INT },
+  { "long", column_sort::ValueType::LONG },
+  { "float", column_sort::ValueType::FLOAT },
+  { "double", column_sort::ValueType::DOUBLE },
+};
+
+sort::ptr make_from_object(
+    const rapidjson::Document& json,
+    const string_ref& args) {
+  assert(json.IsObject());
+
+  auto ptr = memory::make_unique<column_sort>();
+
+  {
+    // required string
+    const auto* key = COLUMN_PARAM_NAME.c_str();
+
+    if (!json.HasMember(key) || !json[key].IsString()) {
+      IR_FRMT_ERROR(
+        "Missing or non-string value in '%s' while constructing columnsort scorer from jSON arguments: %s",
+        key, args.c_str());
+
+      return nullptr;
+    }
+
+    ptr->column(string_ref(json[key].GetString(), json[key].GetStringLength()));
+  }
+
+  {
+    // optional string
+    const auto* key = TYPE_PARAM_NAME.c_str();
+
+    if (json.HasMember(key)) {
+      const auto* value = json[key].IsString()
+        ? std::find_if(std::begin(VALUE_TYPES), std::end(VALUE_TYPES),
+                       [&json, key](const auto& entry) {
+            return entry.first == string_ref(json[key].GetString(), json[key].GetStringLength());
+          })
+        : std::end(VALUE_TYPES);
+
+      if (value == std::end(VALUE_TYPES)) {
+        IR_FRMT_ERROR(
+          "Invalid value in '%s' while constructing columnsort scorer from jSON arguments: %s",
+          key, args.c_str());
+
+        return nullptr;
+      }
+
+      ptr->value_type(value->second);
+    }
+  }
+
+  return ptr;
+}
+
+sort::ptr make_json(const string_ref& args) {
+  if (args.null()) {
+    // default args
+    return memory::make_unique<column_sort>();
+  }
+
+  rapidjson::Document json;
+
+  if (json.Parse(args.c_str(), args.size()).HasParseError()) {
+    IR_FRMT_ERROR(
+      "Invalid jSON arguments passed while constructing columnsort scorer, arguments: %s",
+      args.c_str());
+
+    return nullptr;
+  }
+
+  switch (json.GetType()) {
+    case rapidjson::kStringType: // column name
+      return memory::make_unique<column_sort>(
+        string_ref(json.GetString(), json.GetStringLength()));
+    case rapidjson::kObjectType:
+      return make_from_object(json, args);
+    default: // wrong type
+      IR_FRMT_ERROR(
+        "Invalid jSON arguments passed while constructing columnsort scorer, arguments: %s",
+        args.c_str());
+
+      return nullptr;
+  }
+}
+
+REGISTER_SCORER_JSON(irs::column_sort, make_json);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a stored value doesn't depend on a matched term, i.e. all scores
+///        merged for a document are equal, hence merging takes any of them
+///        rather than summing values up or comparing against a
+///        zero-initialized score
+////////////////////////////////////////////////////////////////////////////////
+template<typename T>
+struct column_score_traits : score_traits<T> {
+  using score_traits<T>::score_cast;
+
+  static void bulk_aggregate(const order_bucket* ctx, byte_type* dst,
+                             const byte_type** src_begin, size_t size) noexcept {
+    const auto offset = ctx->score_offset;
+    score_cast(dst + offset) = size ? score_cast(*src_begin + offset) : T();
+  }
+
+  static void aggregate(const order_bucket* ctx,
+                        byte_type* RESTRICT dst,
+                        const byte_type* RESTRICT src) noexcept {
+    const auto offset = ctx->score_offset;
+    score_cast(dst + offset) = score_cast(src + offset);
+  }
+
+  static void bulk_max(const order_bucket* ctx, byte_type* dst,
+                       const byte_type** src_begin, size_t size) noexcept {
+    bulk_aggregate(ctx, dst, src_begin, size);
+  }
+
+  static void max(const order_bucket* ctx,
+                  byte_type* RESTRICT dst,
+                  const byte_type* RESTRICT src) noexcept {
+    aggregate(ctx, dst, src);
+  }
+}; // column_score_traits
+
+template<typename T>
+using read_f = T(*)(data_input&);
+
+template<typename T>
+struct column_score_ctx final : score_ctx {
+  column_score_ctx(
+      byte_type* score_buf,
+      const document* doc,
+      doc_iterator::ptr&& it,
+      const payload* value,
+      read_f<T> read) noexcept
+    : score_buf(score_buf),
+      doc(doc),
+      it(std::move(it)),
+      value(value),
+      read(read) {
+    assert(this->doc);
+    assert(this->it);
+    assert(this->value);
+    assert(this->read);
+  }
+
+  byte_type* score_buf;
+  const document* doc;
+  doc_iterator::ptr it; // column iterator, reads column blocks as a whole
+  const payload* value;
+  read_f<T> read;
+}; // column_score_ctx
+
+template<typename T>
+class prepared final : public prepared_sort_base<T, void, column_score_traits<T>> {
+ public:
+  using traits_t = column_score_traits<T>;
+
+  // score of documents without a value
+  static constexpr T MISSING = std::numeric_limits<T>::lowest();
+
+  prepared(const std::string& column, read_f<T> read)
+    : column_(column), read_(read) {
+  }
+
+  virtual const flags& features() const override {
+    return flags::empty_instance();
+  }
+
+  virtual bool less(const byte_type* lhs, const byte_type* rhs) const override {
+    return traits_t::score_cast(lhs) < traits_t::score_cast(rhs);
+  }
+
+  virtual score_function prepare_scorer(
+      const sub_reader& segment,
+      const term_reader& /*field*/,
+      const byte_type* /*stats*/,
+      byte_type* score_buf,
+      const attribute_provider& doc_attrs,
+      boost_t /*boost*/) const override {
+    auto* doc = irs::get<document>(doc_attrs);
+
+    if (!doc) {
+      // we need 'document' attribute to be exposed
+      return { nullptr, nullptr };
+    }
+
+    const auto* column = segment.column_reader(column_);
+    auto it = column ? column->iterator() : nullptr;
+    auto* value = it ? irs::get<payload>(*it) : nullptr;
+
+    if (!value) {
+      // no values in a segment
+      traits_t::score_cast(score_buf) = MISSING;
+
+      return {
+        reinterpret_cast<score_ctx*>(score_buf),
+        [](score_ctx* ctx) noexcept -> const byte_type* {
+          return reinterpret_cast<byte_type*>(ctx);
+        }
+      };
+    }
+
+    return {
+      memory::make_unique<column_score_ctx<T>>(score_buf, doc, std::move(it), value, read_),
+      [](score_ctx* ctx) -> const byte_type* {
+        auto& state = *static_cast<column_score_ctx<T>*>(ctx);
+        const doc_id_t target = state.doc->value;
+        auto& score = traits_t::score_cast(state.score_buf);
+
+        if (target == state.it->seek(target)) {
+          bytes_ref_input in(state.value->value);
+          score = state.read(in);
+        } else {
+          score = MISSING;
+        }
+
+        return state.score_buf;
+      }
+    };
+  }
+
+ private:
+  std::string column_;
+  read_f<T> read_;
+}; // prepared
+
+NS_END
+
+NS_ROOT
+
+DEFINE_FACTORY_DEFAULT(irs::column_sort)
+
+/*static*/ void column_sort::init() {
+  REGISTER_SCORER_JSON(column_sort, make_json); // match registration above
+}
+
+column_sort::column_sort(
+    const string_ref& column /*= string_ref::EMPTY*/,
+    ValueType type /*= ValueType::LONG*/)
+  : sort(irs::type<column_sort>::get()),
+    column_(column.c_str(), column.size()),
+    type_(type) {
+}
+
+sort::prepared::ptr column_sort::prepare() const {
+  switch (type_) {
+    case ValueType::INT:
+      return memory::make_unique<::prepared<int64_t>>(
+        column_, [](data_input& in) -> int64_t { return read_zvint(in); });
+    case ValueType::LONG:
+      return memory::make_unique<::prepared<int64_t>>(
+        column_, [](data_input& in) -> int64_t { return read_zvlong(in); });
+    case ValueType::FLOAT:
+      return memory::make_unique<::prepared<double_t>>(
+        column_, [](data_input& in) -> double_t { return read_zvfloat(in); });
+    case ValueType::DOUBLE:
+      return memory::make_unique<::prepared<double_t>>(
+        column_, [](data_input& in) -> double_t { return read_zvdouble(in); });
+  }
+
+  assert(false);
+  return nullptr;
+}
+
+NS_END
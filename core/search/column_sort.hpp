@@ -0,0 +1,80 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_COLUMN_SORT_H
+#define IRESEARCH_COLUMN_SORT_H
+
+#include "scorers.hpp"
+
+NS_ROOT
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class column_sort
+/// @brief orders documents by a numeric value stored in a column (doc values),
+///        e.g. a timestamp, values are expected to be written by the
+///        'write_zv*' function matching the specified value type
+/// @note documents without a value rank as having the lowest possible value
+/// @note use 'reverse' to prefer greater values
+/// @note column blocks aren't skipped by their min/max values since bounds
+///       are tracked in lexicographical order which doesn't match the order
+///       of 'write_zv*' encoded numbers
+////////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API column_sort final : public sort {
+ public:
+  enum class ValueType {
+    INT,    // 'write_zvint', ordered as int64_t
+    LONG,   // 'write_zvlong', ordered as int64_t
+    FLOAT,  // 'write_zvfloat', ordered as double_t
+    DOUBLE, // 'write_zvdouble', ordered as double_t
+  };
+
+  static constexpr string_ref type_name() noexcept {
+    return "columnsort";
+  }
+
+  static void init(); // for trigering registration in a static build
+
+  // for use with irs::order::add<T>() and default args (static build)
+  DECLARE_FACTORY();
+
+  explicit column_sort(
+    const string_ref& column = string_ref::EMPTY,
+    ValueType type = ValueType::LONG);
+
+  const std::string& column() const noexcept { return column_; }
+  void column(const string_ref& column) { column_.assign(column.c_str(), column.size()); }
+
+  ValueType value_type() const noexcept { return type_; }
+  void value_type(ValueType type) noexcept { type_ = type; }
+
+  virtual sort::prepared::ptr prepare() const override;
+
+ private:
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  std::string column_;
+  ValueType type_;
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // column_sort
+
+NS_END
+
+#endif // IRESEARCH_COLUMN_SORT_H
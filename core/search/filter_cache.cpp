@@ -0,0 +1,315 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "filter_cache.hpp"
+
+#include <algorithm>
+
+#include "bitset_doc_iterator.hpp"
+#include "index/segment_reader.hpp"
+#include "utils/hash_utils.hpp"
+#include "utils/thread_utils.hpp"
+#include "utils/type_limits.hpp"
+
+NS_LOCAL
+
+using namespace irs;
+
+// approximate memory occupied by an entry besides the bitset
+constexpr size_t ENTRY_OVERHEAD = 128;
+
+// @returns segment reader implementation which is released on reopen,
+//          nullptr if the specified reader can't be identified
+sub_reader::ptr segment_identity(const sub_reader& rdr) {
+  const auto* segment = dynamic_cast<const segment_reader*>(&rdr);
+
+  return segment ? static_cast<sub_reader::ptr>(*segment) : nullptr;
+}
+
+NS_END
+
+NS_ROOT
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                               filter_cache::query
+// -----------------------------------------------------------------------------
+
+class filter_cache::query final : public filter::prepared {
+ public:
+  query(
+      filter::prepared::ptr&& impl,
+      filter_cache& cache,
+      std::shared_ptr<const irs::filter>&& filter,
+      bool admitted) noexcept
+    : filter::prepared(impl->boost()),
+      query_(std::move(impl)),
+      cache_(&cache),
+      filter_(std::move(filter)),
+      hash_(filter_->hash()),
+      admitted_(admitted) {
+  }
+
+  using filter::prepared::execute;
+
+  virtual doc_iterator::ptr execute(
+      const sub_reader& rdr,
+      const order::prepared& ord,
+      const attribute_provider* ctx) const override {
+    if (!ord.empty()) {
+      // only unscored results are cached
+      return query_->execute(rdr, ord, ctx);
+    }
+
+    return cache_->execute(*query_, filter_, hash_, admitted_, rdr, ctx);
+  }
+
+ private:
+  filter::prepared::ptr query_;
+  filter_cache* cache_;
+  std::shared_ptr<const irs::filter> filter_;
+  size_t hash_;
+  bool admitted_; // results may be cached
+}; // query
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                      filter_cache
+// -----------------------------------------------------------------------------
+
+size_t filter_cache::key_hash::operator()(
+    const std::pair<const sub_reader*, size_t>& key) const noexcept {
+  return hash_combine(std::hash<const sub_reader*>()(key.first), key.second);
+}
+
+filter_cache::filter_cache(const options& opts /*= options()*/)
+  : opts_(opts),
+    history_(std::max(size_t(1), opts.history_size), 0) {
+}
+
+bool filter_cache::admit(size_t hash) {
+  SCOPED_LOCK(mutex_);
+  const size_t frequency = 1 + std::count(history_.begin(), history_.end(), hash);
+
+  history_[history_pos_] = hash;
+  history_pos_ = (history_pos_ + 1) % history_.size();
+
+  return frequency >= opts_.min_frequency;
+}
+
+void filter_cache::clear() {
+  SCOPED_LOCK(mutex_);
+  index_.clear();
+  entries_.clear();
+  stats_.entries = 0;
+  stats_.memory = 0;
+}
+
+filter_cache::index_t::iterator filter_cache::erase(index_t::iterator it) {
+  auto entry = it->second;
+  assert(stats_.memory >= entry->memory && stats_.entries);
+  stats_.memory -= entry->memory;
+  --stats_.entries;
+  ++stats_.evictions;
+  entries_.erase(entry);
+  return index_.erase(it);
+}
+
+void filter_cache::evict_lru() {
+  assert(!entries_.empty());
+  auto& lru = entries_.back();
+  auto range = index_.equal_range(std::make_pair(lru.segment_key, lru.hash));
+
+  for (auto it = range.first;; ++it) {
+    assert(it != range.second);
+
+    if (&*it->second == &lru) {
+      erase(it);
+      return;
+    }
+  }
+}
+
+doc_iterator::ptr filter_cache::execute(
+    const filter::prepared& query,
+    const std::shared_ptr<const irs::filter>& filter,
+    size_t hash,
+    bool admitted,
+    const sub_reader& rdr,
+    const attribute_provider* ctx) {
+  auto segment = segment_identity(rdr);
+
+  if (!segment) {
+    return query.execute(rdr, order::prepared::unordered(), ctx);
+  }
+
+  auto docs = find(segment.get(), hash, *filter);
+
+  if (docs) {
+    return memory::make_managed<bitset_doc_iterator>(std::move(docs));
+  }
+
+  if (!admitted) {
+    return query.execute(rdr, order::prepared::unordered(), ctx);
+  }
+
+  // materialize results of the query
+  auto it = query.execute(rdr, order::prepared::unordered(), ctx);
+  auto set = std::make_shared<bitset>(rdr.docs_count() + doc_limits::min());
+
+  while (it->next()) {
+    set->set(it->value());
+  }
+
+  insert({ segment.get(), segment, hash, filter, set,
+           ENTRY_OVERHEAD + set->words()*sizeof(bitset::word_t) });
+
+  return memory::make_managed<bitset_doc_iterator>(std::move(set));
+}
+
+std::shared_ptr<const bitset> filter_cache::find(
+    const sub_reader* segment,
+    size_t hash,
+    const irs::filter& filter) {
+  SCOPED_LOCK(mutex_);
+  auto range = index_.equal_range(std::make_pair(segment, hash));
+
+  for (auto it = range.first; it != range.second;) {
+    auto& entry = *it->second;
+
+    if (entry.segment.expired()) {
+      // different segment at the same address
+      it = erase(it);
+      continue;
+    }
+
+    if (*entry.filter == filter) {
+      entries_.splice(entries_.begin(), entries_, it->second); // mark as recent
+      ++stats_.hits;
+      return entry.docs;
+    }
+
+    ++it;
+  }
+
+  ++stats_.misses;
+  return nullptr;
+}
+
+void filter_cache::insert(entry&& value) {
+  if (value.memory > opts_.max_memory) {
+    return; // doesn't fit
+  }
+
+  SCOPED_LOCK(mutex_);
+  auto range = index_.equal_range(std::make_pair(value.segment_key, value.hash));
+
+  for (auto it = range.first; it != range.second; ++it) {
+    if (!it->second->segment.expired() && *it->second->filter == *value.filter) {
+      return; // concurrently inserted
+    }
+  }
+
+  // evict least recently used entries, entries of released segments are
+  // never hit, so they drift to the back and are dropped along the way
+  while (!entries_.empty()
+         && (entries_.back().segment.expired()
+             || stats_.memory + value.memory > opts_.max_memory)) {
+    evict_lru();
+  }
+
+  const auto key = std::make_pair(value.segment_key, value.hash);
+  stats_.memory += value.memory;
+  ++stats_.entries;
+  entries_.emplace_front(std::move(value));
+  index_.emplace(key, entries_.begin());
+}
+
+filter_cache::stats filter_cache::metrics() const {
+  SCOPED_LOCK(mutex_);
+  return stats_;
+}
+
+filter::prepared::ptr filter_cache::prepare(
+    std::shared_ptr<const irs::filter> filter,
+    const index_reader& rdr,
+    const order::prepared& ord,
+    boost_t boost,
+    const attribute_provider* ctx) {
+  assert(filter);
+  auto query = filter->prepare(rdr, ord, boost, ctx);
+
+  if (!query) {
+    return query;
+  }
+
+  const bool admitted = admit(filter->hash());
+
+  return memory::make_managed<filter_cache::query>(
+    std::move(query), *this, std::move(filter), admitted);
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                     cached_filter
+// -----------------------------------------------------------------------------
+
+DEFINE_FACTORY_DEFAULT(irs::cached_filter)
+
+cached_filter::cached_filter() noexcept
+  : irs::filter(irs::type<cached_filter>::get()) {
+}
+
+irs::filter::prepared::ptr cached_filter::prepare(
+    const index_reader& rdr,
+    const order::prepared& ord,
+    boost_t boost,
+    const attribute_provider* ctx) const {
+  if (!filter_) {
+    return prepared::empty();
+  }
+
+  boost *= this->boost();
+
+  if (!cache_) {
+    return filter_->prepare(rdr, ord, boost, ctx);
+  }
+
+  return cache_->prepare(filter_, rdr, ord, boost, ctx);
+}
+
+size_t cached_filter::hash() const noexcept {
+  return filter_
+    ? hash_combine(irs::filter::hash(), filter_->hash())
+    : irs::filter::hash();
+}
+
+bool cached_filter::equals(const irs::filter& rhs) const noexcept {
+  if (!irs::filter::equals(rhs)) {
+    return false;
+  }
+
+  const auto& typed_rhs = static_cast<const cached_filter&>(rhs);
+
+  return filter_ && typed_rhs.filter_
+    ? *filter_ == *typed_rhs.filter_
+    : !filter_ && !typed_rhs.filter_;
+}
+
+NS_END
@@ -0,0 +1,216 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_FILTER_CACHE_H
+#define IRESEARCH_FILTER_CACHE_H
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "filter.hpp"
+#include "utils/bitset.hpp"
+#include "utils/noncopyable.hpp"
+
+NS_ROOT
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class filter_cache
+/// @brief LRU cache of unscored per-segment filter results stored as bitsets,
+///        entries are keyed on segment identity and filter hash/equality
+/// @note an entry becomes unreachable as soon as the segment reader it was
+///       computed for is released, e.g. after reopen or a change of the
+///       segment's document mask, and is evicted once it's looked up or
+///       becomes the least recently used one
+/// @note results of a cached filter must not depend on the execution context
+/// @note the cache must outlive queries prepared through it
+////////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API filter_cache : private util::noncopyable {
+ public:
+  using ptr = std::shared_ptr<filter_cache>;
+
+  struct options {
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief max amount of memory occupied by cached bitsets
+    ////////////////////////////////////////////////////////////////////////////
+    size_t max_memory{32*(1 << 20)};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief min number of preparations of a filter among the last
+    ///        'history_size' preparations before its results get cached
+    ////////////////////////////////////////////////////////////////////////////
+    size_t min_frequency{2};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief number of recently prepared filters tracked for admission
+    ////////////////////////////////////////////////////////////////////////////
+    size_t history_size{256};
+
+    options() {} // GCC5 requires non-default definition
+  };
+
+  struct stats {
+    size_t entries{}; // number of cached bitsets
+    size_t memory{}; // memory occupied by cached bitsets
+    size_t hits{};
+    size_t misses{};
+    size_t evictions{};
+  };
+
+  explicit filter_cache(const options& opts = options());
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief prepare the specified filter, unscored results of the returned
+  ///        query are served from the cache, scored execution is delegated
+  ///        to the query prepared by the filter
+  //////////////////////////////////////////////////////////////////////////////
+  filter::prepared::ptr prepare(
+    std::shared_ptr<const filter> filter,
+    const index_reader& rdr,
+    const order::prepared& ord,
+    boost_t boost,
+    const attribute_provider* ctx);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief drop all cached entries
+  //////////////////////////////////////////////////////////////////////////////
+  void clear();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns current state of the cache
+  //////////////////////////////////////////////////////////////////////////////
+  stats metrics() const;
+
+ private:
+  class query;
+
+  struct entry {
+    const sub_reader* segment_key;
+    std::weak_ptr<const sub_reader> segment;
+    size_t hash;
+    std::shared_ptr<const irs::filter> filter;
+    std::shared_ptr<const bitset> docs;
+    size_t memory;
+  };
+
+  using entries_t = std::list<entry>; // most recently used first
+
+  struct key_hash {
+    size_t operator()(const std::pair<const sub_reader*, size_t>& key) const noexcept;
+  };
+
+  using index_t = std::unordered_multimap<
+    std::pair<const sub_reader*, size_t>,
+    entries_t::iterator,
+    key_hash>;
+
+  bool admit(size_t hash);
+  index_t::iterator erase(index_t::iterator it);
+  void evict_lru();
+  doc_iterator::ptr execute(
+    const filter::prepared& query,
+    const std::shared_ptr<const irs::filter>& filter,
+    size_t hash,
+    bool admitted,
+    const sub_reader& rdr,
+    const attribute_provider* ctx);
+  std::shared_ptr<const bitset> find(
+    const sub_reader* segment, size_t hash, const irs::filter& filter);
+  void insert(entry&& value);
+
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  options opts_;
+  mutable std::mutex mutex_;
+  entries_t entries_;
+  index_t index_;
+  std::vector<size_t> history_; // ring of hashes of recently prepared filters
+  size_t history_pos_{};
+  stats stats_;
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // filter_cache
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class cached_filter
+/// @brief filter wrapper which serves unscored results of the wrapped filter
+///        from a filter_cache, e.g. for repeated sub-filters of boolean
+///        filters
+/// @note the wrapped filter must not be modified once prepared
+////////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API cached_filter final : public irs::filter {
+ public:
+  static constexpr string_ref type_name() noexcept {
+    return "iresearch::cached_filter";
+  }
+
+  DECLARE_FACTORY();
+
+  cached_filter() noexcept;
+
+  const filter_cache::ptr& cache() const noexcept { return cache_; }
+
+  cached_filter& cache(filter_cache::ptr cache) noexcept {
+    cache_ = std::move(cache);
+    return *this;
+  }
+
+  const irs::filter* filter() const noexcept { return filter_.get(); }
+
+  cached_filter& filter(std::shared_ptr<const irs::filter> filter) noexcept {
+    filter_ = std::move(filter);
+    return *this;
+  }
+
+  template<typename T>
+  T& filter() {
+    typedef typename std::enable_if <
+      std::is_base_of<irs::filter, T>::value, T
+    >::type type;
+
+    auto filter = std::make_shared<type>();
+    auto& ref = *filter;
+    filter_ = std::move(filter);
+    return ref;
+  }
+
+  using irs::filter::prepare;
+
+  virtual irs::filter::prepared::ptr prepare(
+    const index_reader& rdr,
+    const order::prepared& ord,
+    boost_t boost,
+    const attribute_provider* ctx) const override;
+
+  virtual size_t hash() const noexcept override;
+
+ protected:
+  virtual bool equals(const irs::filter& rhs) const noexcept override;
+
+ private:
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  filter_cache::ptr cache_;
+  std::shared_ptr<const irs::filter> filter_;
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // cached_filter
+
+NS_END
+
+#endif // IRESEARCH_FILTER_CACHE_H
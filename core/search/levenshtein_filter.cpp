@@ -152,7 +152,7 @@ void visit(
     const term_reader& reader,
     const byte_type no_distance,
     const uint32_t utf8_target_size,
-    automaton_table_matcher& matcher,
+    const automaton_table_matcher& matcher,
     Visitor& visitor) {
   assert(fst::kError != matcher.Properties(0));
   auto terms = reader.iterator(matcher);
@@ -182,20 +182,40 @@ void visit(
   }
 }
 
+//////////////////////////////////////////////////////////////////////////////
+/// @returns levenshtein automaton for a specified term and description,
+///          cached one is preferred
+//////////////////////////////////////////////////////////////////////////////
+compiled_automaton::ptr compile_levenshtein(
+    const parametric_description& d,
+    bool with_transpositions,
+    const bytes_ref& term) {
+  automaton_cache_key key;
+  key.type = irs::type<by_edit_distance>::id();
+  key.pattern = term;
+  key.max_distance = d.max_distance();
+  key.with_transpositions = with_transpositions;
+  key.description = &d; // descriptions may come from different providers
+
+  return compile_automaton(key, [&d, &term]() {
+    return make_levenshtein_automaton(d, term);
+  });
+}
+
 template<typename Collector>
 bool collect_terms(
     const index_reader& index,
     const string_ref& field,
     const bytes_ref& term,
     const parametric_description& d,
+    bool with_transpositions,
     Collector& collector) {
-  const auto acceptor = make_levenshtein_automaton(d, term);
+  const auto compiled = compile_levenshtein(d, with_transpositions, term);
 
-  if (!validate(acceptor)) {
+  if (!validate(compiled->acceptor)) {
     return false;
   }
 
-  auto matcher = make_automaton_matcher(acceptor);
   const uint32_t utf8_term_size = std::max(1U, uint32_t(utf8_utils::utf8_length(term)));
   const byte_type max_distance = d.max_distance() + 1;
 
@@ -206,7 +226,7 @@ bool collect_terms(
       continue;
     }
 
-    visit(segment, *reader, max_distance, utf8_term_size, matcher, collector);
+    visit(segment, *reader, max_distance, utf8_term_size, compiled->matcher, collector);
   }
 
   return true;
@@ -219,7 +239,8 @@ filter::prepared::ptr prepare_levenshtein_filter(
     const string_ref& field,
     const bytes_ref& term,
     size_t terms_limit,
-    const parametric_description& d) {
+    const parametric_description& d,
+    bool with_transpositions) {
   field_collectors field_stats(order);
   term_collectors term_stats(order, 1);
   multiterm_query::states_t states(index.size());
@@ -228,13 +249,13 @@ filter::prepared::ptr prepare_levenshtein_filter(
     all_terms_collector<decltype(states)> term_collector(states, field_stats, term_stats);
     term_collector.stat_index(0); // aggregate stats from different terms
 
-    if (!collect_terms(index, field, term, d, term_collector)) {
+    if (!collect_terms(index, field, term, d, with_transpositions, term_collector)) {
       return filter::prepared::empty();
     }
   } else {
     top_terms_collector term_collector(terms_limit, field_stats);
 
-    if (!collect_terms(index, field, term, d, term_collector)) {
+    if (!collect_terms(index, field, term, d, with_transpositions, term_collector)) {
       return filter::prepared::empty();
     }
 
@@ -281,18 +302,7 @@ DEFINE_FACTORY_DEFAULT(by_edit_distance)
       };
     },
     [&opts](const parametric_description& d) -> field_visitor {
-      struct automaton_context : util::noncopyable {
-        automaton_context(const parametric_description& d, const bytes_ref& term)
-          : acceptor(make_levenshtein_automaton(d, term)),
-            matcher(make_automaton_matcher(acceptor)) {
-        }
-
-        automaton acceptor;
-        automaton_table_matcher matcher;
-      };
-
-      // FIXME
-      auto ctx = memory::make_shared<automaton_context>(d, opts.term);
+      auto ctx = compile_levenshtein(d, opts.with_transpositions, opts.term);
 
       if (!validate(ctx->acceptor)) {
         return [](const sub_reader&, const term_reader&, filter_visitor&){};
@@ -304,7 +314,7 @@ DEFINE_FACTORY_DEFAULT(by_edit_distance)
       return [ctx, utf8_term_size, max_distance](
           const sub_reader& segment,
           const term_reader& field,
-          filter_visitor& visitor) mutable {
+          filter_visitor& visitor) {
         return ::visit(segment, field, max_distance,
                        utf8_term_size, ctx->matcher, visitor);
       };
@@ -330,9 +340,10 @@ DEFINE_FACTORY_DEFAULT(by_edit_distance)
     [&index, &order, boost, &field, &term]() -> filter::prepared::ptr {
       return by_term::prepare(index, order, boost, field, term);
     },
-    [&field, &term, scored_terms_limit, &index, &order, boost](
+    [&field, &term, scored_terms_limit, &index, &order, boost, with_transpositions](
         const parametric_description& d) -> filter::prepared::ptr {
-      return prepare_levenshtein_filter(index, order, boost, field, term, scored_terms_limit, d);
+      return prepare_levenshtein_filter(index, order, boost, field, term,
+                                        scored_terms_limit, d, with_transpositions);
     }
   );
 }
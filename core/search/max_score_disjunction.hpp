@@ -0,0 +1,318 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_MAX_SCORE_DISJUNCTION_H
+#define IRESEARCH_MAX_SCORE_DISJUNCTION_H
+
+#include "conjunction.hpp"
+#include "cost.hpp"
+#include "score.hpp"
+#include "index/iterators.hpp"
+#include "utils/type_limits.hpp"
+
+NS_ROOT
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class max_score_disjunction
+/// @brief scored disjunction skipping documents which can't exceed the
+///        threshold provided via 'score_threshold' attribute (MaxScore with
+///        block-max bounds).
+///-----------------------------------------------------------------------------
+///   [0]   <-- sub-iterators sorted by max score in ascending order
+///   ...   | non-essential: sum of their max scores doesn't exceed threshold,
+///   [e-1] | never drive iteration, only evaluated for candidates
+///   [e]   <-- essential: candidates are produced by these iterators only
+///   ...
+///   [n-1]
+///-----------------------------------------------------------------------------
+/// @note applicable for AGGREGATE merge of orders preferring higher scores
+///       (i.e. 'reverse' buckets) only, for such orders 'order::less(lhs, rhs)'
+///       denotes that 'lhs' is strictly greater than 'rhs'
+////////////////////////////////////////////////////////////////////////////////
+template<typename DocIterator>
+class max_score_disjunction final
+    : public frozen_attributes<4, doc_iterator>,
+      private score_ctx {
+ public:
+  struct adapter : score_iterator_adapter<DocIterator> {
+    using base = score_iterator_adapter<DocIterator>;
+
+    adapter(base&& rhs) noexcept
+      : base(std::move(rhs)),
+        bound(irs::get_mutable<score_upper_bound>(this->it.get())) {
+      assert(bound && !bound->empty());
+    }
+
+    score_upper_bound* bound;
+    doc_id_t block_end{doc_limits::invalid()}; // last doc of evaluated block
+  };
+
+  using doc_iterators_t = std::vector<score_iterator_adapter<DocIterator>>;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns true if disjunction is applicable for the specified sub-iterators
+  //////////////////////////////////////////////////////////////////////////////
+  static bool applicable(
+      doc_iterators_t& itrs,
+      const order::prepared& ord,
+      sort::MergeType merge_type) {
+    if (ord.empty() || itrs.size() < 2
+        || sort::MergeType::AGGREGATE != merge_type) {
+      return false;
+    }
+
+    for (auto& bucket : ord) {
+      if (!bucket.reverse) {
+        return false;
+      }
+    }
+
+    for (auto& it : itrs) {
+      const auto* bound = irs::get<score_upper_bound>(*it.it);
+
+      if (!bound || bound->empty()) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  max_score_disjunction(
+      doc_iterators_t&& itrs,
+      const order::prepared& ord)
+    : frozen_attributes<4, doc_iterator>{{
+        { type<document>::id(),        &doc_       },
+        { type<cost>::id(),            &cost_      },
+        { type<score>::id(),           &score_     },
+        { type<score_threshold>::id(), &threshold_ },
+      }},
+      score_(ord),
+      ord_(&ord),
+      merger_(ord.prepare_merger(sort::MergeType::AGGREGATE)) {
+    assert(applicable(itrs, ord, sort::MergeType::AGGREGATE));
+
+    itrs_.reserve(itrs.size());
+    cost::cost_t est = 0;
+    for (auto& it : itrs) {
+      est += cost::extract(it, 0);
+      itrs_.emplace_back(std::move(it));
+    }
+    cost_.value(est);
+
+    // sort sub-iterators in ascending order by their max score
+    std::sort(itrs_.begin(), itrs_.end(),
+      [&ord](const adapter& lhs, const adapter& rhs) {
+        return ord.less(rhs.bound->max(), lhs.bound->max());
+    });
+
+    // bounds_[i] is the sum of max scores of the first 'i' sub-iterators
+    const size_t size = ord.score_size();
+    bounds_.resize((itrs_.size() + 1) * size, 0);
+    for (size_t i = 0; i < itrs_.size(); ++i) {
+      auto* sum = bound(i + 1);
+      std::memcpy(sum, bound(i), size);
+      merger_(sum, itrs_[i].bound->max());
+    }
+    tmp_.resize(size);
+
+    score_.reset(this, [](score_ctx* ctx) -> const byte_type* {
+      // score is evaluated while looking for the next competitive document
+      return static_cast<max_score_disjunction*>(ctx)->score_.data();
+    });
+  }
+
+  virtual doc_id_t value() const noexcept override {
+    return doc_.value;
+  }
+
+  virtual bool next() override {
+    if (doc_limits::eof(doc_.value)) {
+      return false;
+    }
+
+    return !doc_limits::eof(advance(doc_.value + 1));
+  }
+
+  virtual doc_id_t seek(doc_id_t target) override {
+    if (target <= doc_.value) {
+      return doc_.value;
+    }
+
+    return advance(target);
+  }
+
+ private:
+  byte_type* bound(size_t i) noexcept {
+    assert(i <= itrs_.size());
+    return &bounds_[0] + i*ord_->score_size();
+  }
+
+  // @returns true if 'score' is strictly greater than threshold
+  bool exceeds(const byte_type* score) const {
+    return ord_->less(score, threshold_.value.c_str());
+  }
+
+  // recompute the number of non-essential sub-iterators
+  void refresh_threshold() {
+    if (threshold_.value == last_threshold_) {
+      return;
+    }
+
+    last_threshold_ = threshold_.value;
+    essential_ = 0;
+
+    if (threshold_.empty()) {
+      return;
+    }
+
+    assert(threshold_.value.size() == ord_->score_size());
+    while (essential_ < itrs_.size() && !exceeds(bound(essential_ + 1))) {
+      ++essential_;
+    }
+  }
+
+  // @returns true if sum of block bounds of all iterators at 'doc'
+  //          exceeds threshold, 'end' is set to the last doc for which the
+  //          estimation is valid
+  bool competitive_block(doc_id_t doc, doc_id_t& end) {
+    auto* sum = &tmp_[0];
+    std::memset(sum, 0, tmp_.size());
+    end = doc_limits::eof();
+
+    for (auto& it : itrs_) {
+      if (doc_limits::eof(it.value())) {
+        continue;
+      }
+
+      if (it.block_end < doc) {
+        it.block_end = it.bound->shallow_seek(doc);
+      }
+
+      merger_(sum, it.bound->value());
+      end = std::min(end, it.block_end);
+    }
+
+    return exceeds(sum);
+  }
+
+  // @returns true if score of the 'doc' exceeds threshold, score is
+  //          accumulated into the score buffer
+  bool evaluate(doc_id_t doc) {
+    auto* score = score_.data();
+    score_.clear();
+
+    for (size_t i = essential_; i < itrs_.size(); ++i) {
+      auto& it = itrs_[i];
+
+      if (it.value() == doc && !it.score->is_default()) {
+        merger_(score, it.score->evaluate());
+      }
+    }
+
+    if (!essential_) {
+      return true;
+    }
+
+    auto* estimation = &tmp_[0];
+
+    for (size_t i = essential_; i; --i) {
+      // current score + max scores of the rest non-essential iterators
+      std::memcpy(estimation, score, tmp_.size());
+      merger_(estimation, bound(i));
+
+      if (!exceeds(estimation)) {
+        return false;
+      }
+
+      auto& it = itrs_[i - 1];
+
+      if (it.value() < doc) {
+        it->seek(doc);
+      }
+
+      if (it.value() == doc && !it.score->is_default()) {
+        merger_(score, it.score->evaluate());
+      }
+    }
+
+    return exceeds(score);
+  }
+
+  doc_id_t advance(doc_id_t target) {
+    for (;;) {
+      refresh_threshold();
+
+      if (essential_ == itrs_.size()) {
+        // no document can exceed threshold
+        return doc_.value = doc_limits::eof();
+      }
+
+      doc_id_t doc = doc_limits::eof();
+      for (size_t i = essential_; i < itrs_.size(); ++i) {
+        auto& it = itrs_[i];
+        const auto value = it.value() < target ? it->seek(target) : it.value();
+        doc = std::min(doc, value);
+      }
+
+      if (doc_limits::eof(doc)) {
+        // non-essential iterators alone can't exceed threshold
+        return doc_.value = doc_limits::eof();
+      }
+
+      if (!threshold_.empty()) {
+        doc_id_t end;
+
+        if (!competitive_block(doc, end)) {
+          if (doc_limits::eof(end)) {
+            return doc_.value = doc_limits::eof();
+          }
+
+          target = end + 1;
+          continue;
+        }
+      }
+
+      if (evaluate(doc)) {
+        return doc_.value = doc;
+      }
+
+      target = doc + 1;
+    }
+  }
+
+  std::vector<adapter> itrs_;
+  bstring bounds_; // prefix sums of max scores
+  bstring tmp_; // temporary score buffer
+  bstring last_threshold_; // threshold used to partition 'itrs_'
+  size_t essential_{}; // index of the first essential sub-iterator
+  document doc_;
+  score score_;
+  cost cost_;
+  score_threshold threshold_;
+  const order::prepared* ord_;
+  order::prepared::merger merger_;
+}; // max_score_disjunction
+
+NS_END // ROOT
+
+#endif // IRESEARCH_MAX_SCORE_DISJUNCTION_H
@@ -22,6 +22,7 @@
 
 #include "phrase_filter.hpp"
 
+#include "analysis/token_streams.hpp"
 #include "index/field_meta.hpp"
 #include "search/collectors.hpp"
 #include "search/filter_visitor.hpp"
@@ -183,6 +184,121 @@ struct prepare : util::noncopyable {
   const boost_t boost;
 }; // prepare
 
+//////////////////////////////////////////////////////////////////////////////
+/// @returns total number of documents containing a specified term in a
+///          specified field, i.e. an estimated cost of intersecting term
+///          postings
+//////////////////////////////////////////////////////////////////////////////
+uint64_t docs_count(
+    const index_reader& index,
+    const string_ref& field,
+    const bytes_ref& term) {
+  uint64_t docs_count = 0;
+
+  for (auto& segment : index) {
+    const auto* reader = segment.field(field);
+
+    if (!reader) {
+      continue;
+    }
+
+    auto terms = reader->iterator();
+
+    if (!terms->seek(term)) {
+      continue;
+    }
+
+    terms->read();
+
+    const auto* meta = irs::get<term_meta>(*terms);
+
+    if (meta) {
+      docs_count += meta->docs_count;
+    }
+  }
+
+  return docs_count;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief rewrites a phrase composed of adjacent simple terms into a phrase
+///        of bigram shingles covering every term of the original phrase,
+///        e.g. "a b c d e" may turn into "a_b" at 0, "c_d" at 2, "d_e" at 3,
+///        out of all covers the one with the least number of documents
+///        to intersect is chosen
+/// @returns false if a phrase can't be covered by shingles or shingles
+///          aren't cheaper to evaluate than the terms themselves
+//////////////////////////////////////////////////////////////////////////////
+bool make_shingle_phrase(
+    const index_reader& index,
+    const string_ref& field,
+    const by_phrase_options& phrase,
+    by_phrase_options& shingles) {
+  assert(phrase.simple());
+  const size_t size = phrase.size();
+
+  if (size < 2) {
+    return false;
+  }
+
+  std::vector<std::pair<size_t, bytes_ref>> terms;
+  terms.reserve(size);
+
+  for (auto& part : phrase) {
+    const auto* term = std::get_if<by_term_options>(&part.second);
+    assert(term);
+
+    if (!terms.empty() && terms.back().first + 1 != part.first) {
+      return false; // terms aren't adjacent
+    }
+
+    terms.emplace_back(part.first, term->term);
+  }
+
+  uint64_t terms_cost = 0;
+  for (auto& term : terms) {
+    terms_cost += docs_count(index, field, term.second);
+  }
+
+  // i-th shingle covers i-th and (i+1)-th terms of a phrase, each term
+  // must be covered, hence there are no 2 skipped shingles in a row
+  std::vector<bstring> bigrams(size - 1);
+  std::vector<uint64_t> costs(size - 1); // min cost of a cover ending with i-th shingle
+  std::vector<size_t> prev(size - 1); // previous shingle of such a cover
+
+  for (size_t i = 0; i < bigrams.size(); ++i) {
+    bigrams[i] = shingle_token_stream::shingle(terms[i].second, terms[i + 1].second);
+    costs[i] = docs_count(index, phrase.shingle_field(), bigrams[i]);
+    prev[i] = i;
+
+    if (i > 1 && costs[i - 2] < costs[i - 1]) {
+      prev[i] = i - 2;
+    } else if (i > 0) {
+      prev[i] = i - 1;
+    }
+
+    if (prev[i] != i) {
+      costs[i] += costs[prev[i]];
+    }
+  }
+
+  if (costs.back() >= terms_cost) {
+    return false;
+  }
+
+  shingles.clear();
+
+  for (size_t i = bigrams.size() - 1;; i = prev[i]) {
+    shingles.insert(by_term_options{std::move(bigrams[i])}, terms[i].first);
+
+    if (prev[i] == i) {
+      break;
+    }
+  }
+
+  return true;
+}
+
 NS_END
 
 NS_ROOT
@@ -510,6 +626,17 @@ filter::prepared::ptr by_phrase::prepare(
     }
   }
 
+  if (options().simple() && !options().shingle_field().empty()) {
+    by_phrase shingles;
+
+    if (make_shingle_phrase(index, field(), options(), *shingles.mutable_options())) {
+      *shingles.mutable_field() = options().shingle_field();
+      shingles.boost(this->boost());
+
+      return shingles.prepare(index, ord, boost);
+    }
+  }
+
   // prepare phrase stats (collector for each term)
   if (options().simple()) {
     return fixed_prepare_collect(index, ord, boost);
@@ -120,14 +120,14 @@ class IRESEARCH_API by_phrase_options {
   /// @returns true is options are equal, false - otherwise
   //////////////////////////////////////////////////////////////////////////////
   bool operator==(const by_phrase_options& rhs) const noexcept {
-    return phrase_ == rhs.phrase_;
+    return phrase_ == rhs.phrase_ && shingle_field_ == rhs.shingle_field_;
   }
 
   //////////////////////////////////////////////////////////////////////////////
   /// @returns hash value
   //////////////////////////////////////////////////////////////////////////////
   size_t hash() const noexcept {
-    size_t hash = 0;
+    size_t hash = std::hash<std::string>()(shingle_field_);
     for (auto& part : phrase_) {
       hash = hash_combine(hash, part.first);
       hash = hash_combine(hash, part.second);
@@ -135,6 +135,22 @@ class IRESEARCH_API by_phrase_options {
     return hash;
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief sets name of a field indexed with bigram shingles of the filtered
+  ///        field (see shingle_token_stream), if set then a phrase composed
+  ///        of simple terms is evaluated against the shingle field whenever
+  ///        its shingles are cheaper to intersect than the terms themselves
+  /// @note scores are then computed using statistics of the shingle field
+  //////////////////////////////////////////////////////////////////////////////
+  void shingle_field(std::string field) {
+    shingle_field_ = std::move(field);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns name of a field indexed with bigram shingles, empty if none
+  //////////////////////////////////////////////////////////////////////////////
+  const std::string& shingle_field() const noexcept { return shingle_field_; }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief clear phrase contents
   //////////////////////////////////////////////////////////////////////////////
@@ -174,6 +190,7 @@ class IRESEARCH_API by_phrase_options {
   }
 
   phrase_type phrase_;
+  std::string shingle_field_;
   bool is_simple_term_only_{true};
 }; // by_phrase_options
 
@@ -101,6 +101,102 @@ class fixed_phrase_frequency {
   bool order_empty_;
 }; // fixed_phrase_frequency
 
+////////////////////////////////////////////////////////////////////////////////
+/// @class proximity_frequency
+/// @brief evaluates a number of windows of at most 'max_distance' positions
+///        containing all terms in any order, each window is counted once
+///        along with its leftmost position
+/// @note positions are accessed only for documents matched by an underlying
+///       conjunction, hence position blocks of other documents are skipped
+///       without being decoded
+////////////////////////////////////////////////////////////////////////////////
+class proximity_frequency {
+ public:
+  using term_position_t = std::pair<
+    position::ref, // position attribute
+    bool>; // term is the same as the previous one
+
+  proximity_frequency(
+      std::vector<term_position_t>&& pos,
+      const order::prepared& ord,
+      position::value_t max_distance)
+    : pos_(std::move(pos)),
+      max_distance_(max_distance),
+      order_empty_(ord.empty()) {
+    assert(!pos_.empty()); // must not be empty
+    assert(!pos_.front().second); // first term has no predecessor
+  }
+
+  frequency* freq() noexcept {
+    return order_empty_ ? nullptr : &freq_;
+  }
+
+  filter_boost* boost() noexcept {
+    return nullptr;
+  }
+
+  // returns number of matched windows
+  uint32_t operator()() {
+    freq_.value = 0;
+
+    for (auto& pos : pos_) {
+      position& p = pos.first;
+      if (pos_limits::eof(p.next())) {
+        return freq_.value;
+      }
+    }
+
+    for (;;) {
+      position* min = nullptr;
+      auto min_value = pos_limits::eof();
+      auto max_value = pos_limits::min();
+      auto prev_value = pos_limits::invalid();
+
+      for (auto& pos : pos_) {
+        position& p = pos.first;
+        auto value = p.value();
+
+        // occurrences of a repeated term must be distinct
+        if (pos.second && value <= prev_value) {
+          value = p.seek(prev_value + 1);
+        }
+
+        if (pos_limits::eof(value)) {
+          return freq_.value;
+        }
+
+        if (value < min_value) {
+          min = &p;
+          min_value = value;
+        }
+
+        max_value = std::max(max_value, value);
+        prev_value = value;
+      }
+
+      assert(min);
+
+      if (max_value - min_value <= max_distance_) {
+        if (order_empty_) {
+          return (freq_.value = 1);
+        }
+
+        ++freq_.value;
+        min->next();
+      } else {
+        // any window containing the leftmost position is too wide
+        min->seek(max_value - max_distance_);
+      }
+    }
+  }
+
+ private:
+  std::vector<term_position_t> pos_; // list of positions along with corresponding attributes
+  frequency freq_; // number of matched windows in a document
+  const position::value_t max_distance_;
+  const bool order_empty_;
+}; // proximity_frequency
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @class doc_iterator_adapter
 /// @brief adapter to use doc_iterator with positions for disjunction
@@ -434,6 +530,7 @@ class variadic_phrase_frequency_overlapped {
 template<typename Conjunction, typename Frequency>
 class phrase_iterator final : public doc_iterator {
  public:
+  template<typename... Args>
   phrase_iterator(
       typename Conjunction::doc_iterators_t&& itrs,
       std::vector<typename Frequency::term_position_t>&& pos,
@@ -441,9 +538,10 @@ class phrase_iterator final : public doc_iterator {
       const term_reader& field,
       const byte_type* stats,
       const order::prepared& ord,
-      boost_t boost)
+      boost_t boost,
+      Args&&... args) // additional arguments of a frequency evaluator
     : approx_(std::move(itrs)),
-      freq_(std::move(pos), ord),
+      freq_(std::move(pos), ord, std::forward<Args>(args)...),
       doc_(irs::get_mutable<document>(&approx_)),
       attrs_{{
         { type<document>::id(),     doc_          },
@@ -0,0 +1,259 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "proximity_filter.hpp"
+
+#include "shared.hpp"
+#include "collectors.hpp"
+#include "conjunction.hpp"
+#include "phrase_iterator.hpp"
+#include "term_filter.hpp"
+#include "index/field_meta.hpp"
+#include "analysis/token_attributes.hpp"
+
+NS_LOCAL
+
+using namespace irs;
+
+//////////////////////////////////////////////////////////////////////////////
+/// @struct proximity_state
+/// @brief cached per reader proximity state
+//////////////////////////////////////////////////////////////////////////////
+struct proximity_state {
+  std::vector<seek_term_iterator::cookie_ptr> terms;
+  const term_reader* reader{};
+}; // proximity_state
+
+//////////////////////////////////////////////////////////////////////////////
+/// @class proximity_query
+/// @brief prepared proximity query implementation
+//////////////////////////////////////////////////////////////////////////////
+class proximity_query final : public filter::prepared {
+ public:
+  using states_t = states_cache<proximity_state>;
+
+  proximity_query(
+      states_t&& states,
+      std::vector<bool>&& repeated,
+      bstring&& stats,
+      position::value_t max_distance,
+      boost_t boost) noexcept
+    : prepared(boost),
+      states_(std::move(states)),
+      repeated_(std::move(repeated)),
+      stats_(std::move(stats)),
+      max_distance_(max_distance) {
+  }
+
+  using filter::prepared::execute;
+
+  virtual doc_iterator::ptr execute(
+      const sub_reader& rdr,
+      const order::prepared& ord,
+      const attribute_provider* /*ctx*/) const override {
+    using conjunction_t = conjunction<doc_iterator::ptr>;
+    using proximity_iterator_t = phrase_iterator<
+      conjunction_t,
+      proximity_frequency>;
+
+    // get proximity state for the specified reader
+    auto state = states_.find(rdr);
+
+    if (!state) {
+      // invalid state
+      return doc_iterator::empty();
+    }
+
+    // get features required for query & order
+    auto features = ord.features() | by_proximity::required();
+
+    conjunction_t::doc_iterators_t itrs;
+    itrs.reserve(state->terms.size());
+
+    std::vector<proximity_frequency::term_position_t> positions;
+    positions.reserve(state->terms.size());
+
+    // find term using cached state
+    auto terms = state->reader->iterator();
+    auto repeated = repeated_.begin();
+
+    for (const auto& cookie : state->terms) {
+      assert(cookie);
+
+      // use bytes_ref::NIL here since we do not need just to "jump"
+      // to cached state, and we are not interested in term value itself
+      if (!terms->seek(bytes_ref::NIL, *cookie)) {
+        return doc_iterator::empty();
+      }
+
+      auto docs = terms->postings(features); // postings
+
+      auto* pos = irs::get_mutable<irs::position>(docs.get());
+
+      if (!pos) {
+        // positions not found
+        return doc_iterator::empty();
+      }
+
+      positions.emplace_back(std::ref(*pos), *repeated);
+
+      // add base iterator
+      itrs.emplace_back(std::move(docs));
+
+      ++repeated;
+    }
+
+    return memory::make_managed<proximity_iterator_t>(
+      std::move(itrs),
+      std::move(positions),
+      rdr,
+      *state->reader,
+      stats_.c_str(),
+      ord,
+      boost(),
+      max_distance_);
+  }
+
+ private:
+  states_t states_;
+  std::vector<bool> repeated_; // term is the same as the previous one
+  bstring stats_;
+  position::value_t max_distance_;
+}; // proximity_query
+
+NS_END
+
+NS_ROOT
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                       by_proximity implementation
+// -----------------------------------------------------------------------------
+
+/* static */ const flags& by_proximity::required() {
+  static const flags req{ irs::type<frequency>::get(), irs::type<position>::get() };
+  return req;
+}
+
+DEFINE_FACTORY_DEFAULT(by_proximity)
+
+filter::prepared::ptr by_proximity::prepare(
+    const index_reader& index,
+    const order::prepared& ord,
+    boost_t boost,
+    const attribute_provider* /*ctx*/) const {
+  if (field().empty() || options().terms.empty()) {
+    // empty field or terms
+    return filter::prepared::empty();
+  }
+
+  boost *= this->boost();
+
+  if (1 == options().terms.size()) {
+    return by_term::prepare(index, ord, boost, field(), options().terms.front());
+  }
+
+  // repeated terms are placed next to each other in order to
+  // make their occurrences distinct while evaluating windows
+  std::vector<bytes_ref> terms(options().terms.begin(), options().terms.end());
+  std::sort(terms.begin(), terms.end());
+
+  const size_t size = terms.size();
+  const bool is_ord_empty = ord.empty();
+
+  // stats collectors
+  field_collectors field_stats(ord);
+  term_collectors term_stats(ord, size);
+
+  // per segment proximity states
+  proximity_query::states_t states(index.size());
+
+  // per segment terms states
+  std::vector<seek_term_iterator::cookie_ptr> term_states;
+  term_states.reserve(size);
+
+  const string_ref field = this->field();
+
+  for (const auto& segment : index) {
+    // get term dictionary for field
+    const auto* reader = segment.field(field);
+
+    if (!reader) {
+      continue;
+    }
+
+    // check required features
+    if (!required().is_subset_of(reader->meta().features)) {
+      continue;
+    }
+
+    field_stats.collect(segment, *reader); // collect field statistics once per segment
+
+    auto it = reader->iterator();
+
+    for (size_t term_idx = 0; term_idx < size; ++term_idx) {
+      if (!it->seek(terms[term_idx])) {
+        if (is_ord_empty) {
+          break;
+        }
+        // continue here because we should collect
+        // stats for other terms
+        continue;
+      }
+
+      it->read(); // read term attributes
+      term_stats.collect(segment, *reader, term_idx, *it);
+      term_states.emplace_back(it->cookie());
+    }
+
+    // we have not found all needed terms
+    if (term_states.size() != size) {
+      term_states.clear();
+      continue;
+    }
+
+    auto& state = states.insert(segment);
+    state.terms = std::move(term_states);
+    state.reader = reader;
+
+    term_states.reserve(size);
+  }
+
+  // finish stats
+  bstring stats(ord.stats_size(), 0); // aggregated stats
+  auto* stats_buf = const_cast<byte_type*>(stats.data());
+
+  std::vector<bool> repeated(size);
+
+  for (size_t term_idx = 0; term_idx < size; ++term_idx) {
+    repeated[term_idx] = term_idx && terms[term_idx - 1] == terms[term_idx];
+    term_stats.finish(stats_buf, term_idx, field_stats, index);
+  }
+
+  return memory::make_managed<proximity_query>(
+    std::move(states),
+    std::move(repeated),
+    std::move(stats),
+    options().max_distance,
+    boost);
+}
+
+NS_END // ROOT
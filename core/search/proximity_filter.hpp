@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_PROXIMITY_FILTER_H
+#define IRESEARCH_PROXIMITY_FILTER_H
+
+#include "search/filter.hpp"
+#include "utils/string.hpp"
+
+NS_ROOT
+
+class by_proximity;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @struct by_proximity_options
+/// @brief options for proximity filter
+////////////////////////////////////////////////////////////////////////////////
+struct IRESEARCH_API by_proximity_options {
+  using filter_type = by_proximity;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief terms to find, order of terms doesn't matter,
+  ///        repeated terms have to occur at distinct positions
+  //////////////////////////////////////////////////////////////////////////////
+  std::vector<bstring> terms;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief max distance between the first and the last term positions
+  ///        of a match, e.g. 1 matches adjacent terms in any order
+  //////////////////////////////////////////////////////////////////////////////
+  uint32_t max_distance{0};
+
+  bool operator==(const by_proximity_options& rhs) const noexcept {
+    return terms == rhs.terms && max_distance == rhs.max_distance;
+  }
+
+  size_t hash() const noexcept {
+    size_t hash = std::hash<uint32_t>()(max_distance);
+    for (auto& term : terms) {
+      hash = hash_combine(hash, term);
+    }
+    return hash;
+  }
+}; // by_proximity_options
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class by_proximity
+/// @brief user-side filter matching documents containing all of the specified
+///        terms within a window of 'max_distance' positions in any order,
+///        a number of such windows in a document is exposed to scorers
+///        as a term frequency
+////////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API by_proximity : public filter_base<by_proximity_options> {
+ public:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns features required for filter
+  //////////////////////////////////////////////////////////////////////////////
+  static const flags& required();
+
+  static constexpr string_ref type_name() noexcept {
+    return "iresearch::by_proximity";
+  }
+
+  DECLARE_FACTORY();
+
+  using filter::prepare;
+
+  virtual filter::prepared::ptr prepare(
+    const index_reader& index,
+    const order::prepared& ord,
+    boost_t boost,
+    const attribute_provider* ctx) const override;
+}; // by_proximity
+
+NS_END // ROOT
+
+#endif // IRESEARCH_PROXIMITY_FILTER_H
@@ -131,4 +131,149 @@ void reset(irs::score& score, order::prepared::scorers&& scorers) {
   }
 }
 
+// ----------------------------------------------------------------------------
+// --SECTION--                                                score_upper_bound
+// ----------------------------------------------------------------------------
+
+void score_upper_bound::reset(frequency_bound& freq, score_function&& func) {
+  assert(func);
+  assert(max_.size() == value_.size());
+  func_ = std::move(func);
+  freq_ = &freq;
+
+  // iterator isn't positioned yet, evaluate bound over the whole list
+  func_();
+  max_ = value_;
+}
+
+void score_upper_bound::clear() noexcept {
+  max_.clear();
+  value_.clear();
+  func_.reset(nullptr, nullptr);
+  freq_ = nullptr;
+}
+
+bool reset(
+    score_upper_bound& bound,
+    frequency_bound& freq,
+    const order::prepared& ord,
+    const sub_reader& segment,
+    const term_reader& field,
+    const byte_type* stats_buf,
+    const attribute_provider& doc,
+    boost_t boost) {
+  bound.clear();
+
+  if (ord.empty()) {
+    return false;
+  }
+
+  auto* bound_buf = bound.realloc(ord);
+
+  std::vector<score_function> funcs;
+  funcs.reserve(ord.size());
+
+  for (auto& entry : ord) {
+    assert(stats_buf);
+    assert(entry.bucket); // ensured by order::prepared
+
+    if (!entry.reverse) {
+      // lower scores are preferred, upper bound doesn't help
+      bound.clear();
+      return false;
+    }
+
+    auto func = entry.bucket->prepare_bound(
+      segment, field,
+      stats_buf + entry.stats_offset,
+      bound_buf + entry.score_offset,
+      doc, boost);
+
+    if (!func) {
+      bound.clear();
+      return false;
+    }
+
+    funcs.emplace_back(std::move(func));
+  }
+
+  if (1 == funcs.size()) {
+    bound.reset(freq, std::move(funcs.front()));
+  } else {
+    struct ctx : score_ctx {
+      explicit ctx(std::vector<score_function>&& funcs) noexcept
+        : funcs(std::move(funcs)) {
+      }
+
+      std::vector<score_function> funcs;
+    };
+
+    bound.reset(freq, {
+      memory::make_unique<ctx>(std::move(funcs)),
+      [](score_ctx* ctx) -> const byte_type* {
+        auto& funcs = static_cast<struct ctx*>(ctx)->funcs;
+        for (auto& func : funcs) {
+          func();
+        }
+        return nullptr;
+    }});
+  }
+
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+// --SECTION--                                                      score_block
+// ----------------------------------------------------------------------------
+
+void score_block::reset(
+    std::vector<std::pair<block_score_function, size_t>>&& funcs,
+    size_t score_size) noexcept {
+  funcs_ = std::move(funcs);
+  score_size_ = score_size;
+}
+
+void score_block::clear() noexcept {
+  funcs_.clear();
+  score_size_ = 0;
+}
+
+bool reset(
+    score_block& block,
+    const order::prepared& ord,
+    const sub_reader& segment,
+    const term_reader& field,
+    const byte_type* stats_buf,
+    const attribute_provider& doc,
+    boost_t boost) {
+  block.clear();
+
+  if (ord.empty()) {
+    return false;
+  }
+
+  std::vector<std::pair<block_score_function, size_t>> funcs;
+  funcs.reserve(ord.size());
+
+  for (auto& entry : ord) {
+    assert(stats_buf);
+    assert(entry.bucket); // ensured by order::prepared
+
+    auto func = entry.bucket->prepare_block_scorer(
+      segment, field,
+      stats_buf + entry.stats_offset,
+      doc, boost);
+
+    if (!func) {
+      return false;
+    }
+
+    funcs.emplace_back(std::move(func), entry.score_offset);
+  }
+
+  block.reset(std::move(funcs), ord.score_size());
+
+  return true;
+}
+
 NS_END // ROOT
@@ -24,6 +24,7 @@
 #define IRESEARCH_SCORE_H
 
 #include "sort.hpp"
+#include "analysis/token_attributes.hpp"
 #include "utils/attributes.hpp"
 
 NS_ROOT
@@ -112,6 +113,181 @@ class IRESEARCH_API score : public attribute {
 IRESEARCH_API void reset(
   irs::score& score, order::prepared::scorers&& scorers);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @class score_upper_bound
+/// @brief represents an upper bound of the scores of the documents produced
+///        by an iterator, both for the whole iterator and for a block of
+///        documents, used for dynamic pruning of top-k queries
+////////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API score_upper_bound : public attribute {
+ public:
+  static constexpr string_ref type_name() noexcept {
+    return "iresearch::score_upper_bound";
+  }
+
+  score_upper_bound() = default;
+  score_upper_bound(score_upper_bound&&) = default;
+  score_upper_bound& operator=(score_upper_bound&&) = default;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns true if bound isn't available
+  //////////////////////////////////////////////////////////////////////////////
+  bool empty() const noexcept {
+    return !freq_;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns upper bound of the scores of all documents
+  //////////////////////////////////////////////////////////////////////////////
+  const byte_type* max() const noexcept {
+    assert(!empty());
+    return max_.c_str();
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns upper bound of the scores of the documents in the current block
+  //////////////////////////////////////////////////////////////////////////////
+  const byte_type* value() const noexcept {
+    assert(!empty());
+    return value_.c_str();
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief evaluate an upper bound for the block containing 'target',
+  ///        subsequent targets must not decrease
+  /// @returns last document of the block
+  //////////////////////////////////////////////////////////////////////////////
+  doc_id_t shallow_seek(doc_id_t target) {
+    assert(!empty());
+    const auto end = freq_->shallow_seek(target);
+    func_();
+    return end;
+  }
+
+  byte_type* realloc(const order::prepared& order) {
+    max_.resize(order.score_size());
+    value_.resize(order.score_size());
+    return const_cast<byte_type*>(value_.data());
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief set function evaluating block bound into the buffer returned by
+  ///        'realloc(...)', bound over the whole iterator is evaluated
+  ///        immediately since 'freq' isn't positioned yet
+  //////////////////////////////////////////////////////////////////////////////
+  void reset(frequency_bound& freq, score_function&& func);
+
+  void clear() noexcept;
+
+ private:
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  bstring max_; // bound over the whole iterator
+  bstring value_; // bound over the current block
+  score_function func_; // evaluates block bound into 'value_'
+  frequency_bound* freq_{}; // block navigation
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // score_upper_bound
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief prepare score upper bound for the specified order
+/// @returns false if at least one of the buckets doesn't support bounds or
+///          doesn't prefer higher scores, 'bound' is left empty in this case
+////////////////////////////////////////////////////////////////////////////////
+IRESEARCH_API bool reset(
+  score_upper_bound& bound,
+  frequency_bound& freq,
+  const order::prepared& ord,
+  const sub_reader& segment,
+  const term_reader& field,
+  const byte_type* stats,
+  const attribute_provider& doc,
+  boost_t boost);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class score_block
+/// @brief scores a batch of documents of a single term in one call, exposed
+///        by term iterators along with 'frequency', so that consumers may
+///        score a batch of collected documents at once instead of evaluating
+///        'score' document by document
+////////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API score_block : public attribute {
+ public:
+  static constexpr string_ref type_name() noexcept {
+    return "iresearch::score_block";
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns true if block scoring isn't available
+  //////////////////////////////////////////////////////////////////////////////
+  bool empty() const noexcept {
+    return funcs_.empty();
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief evaluate scores of 'count' documents with the specified term
+  ///        frequencies, the score of the i-th document is written to
+  ///        'scores + i*order::prepared::score_size()'
+  /// @note documents must be in ascending order
+  //////////////////////////////////////////////////////////////////////////////
+  void evaluate(
+      const doc_id_t* docs,
+      const uint32_t* freqs,
+      size_t count,
+      byte_type* scores) const {
+    assert(!empty());
+    for (auto& func : funcs_) {
+      func.first(docs, freqs, count, scores + func.second, score_size_);
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief set functions scoring order buckets at the specified offsets
+  //////////////////////////////////////////////////////////////////////////////
+  void reset(
+    std::vector<std::pair<block_score_function, size_t>>&& funcs,
+    size_t score_size) noexcept;
+
+  void clear() noexcept;
+
+ private:
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  std::vector<std::pair<block_score_function, size_t>> funcs_; // function + score offset
+  size_t score_size_{};
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // score_block
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief prepare block scoring for the specified order
+/// @returns false if at least one of the buckets doesn't support block
+///          scoring, 'block' is left empty in this case
+////////////////////////////////////////////////////////////////////////////////
+IRESEARCH_API bool reset(
+  score_block& block,
+  const order::prepared& ord,
+  const sub_reader& segment,
+  const term_reader& field,
+  const byte_type* stats,
+  const attribute_provider& doc,
+  boost_t boost);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class score_threshold
+/// @brief score a document has to exceed in order to be considered as
+///        competitive, updated by the consumer of the iterator (e.g. top-k
+///        collector) and used by the iterator to skip non-competitive docs
+////////////////////////////////////////////////////////////////////////////////
+struct IRESEARCH_API score_threshold final : attribute {
+  static constexpr string_ref type_name() noexcept {
+    return "iresearch::score_threshold";
+  }
+
+  bool empty() const noexcept {
+    return value.empty();
+  }
+
+  bstring value; // empty == no threshold
+}; // score_threshold
+
 NS_END // ROOT
 
 #endif // IRESEARCH_SCORE_H
@@ -29,6 +29,7 @@
   #include "tfidf.hpp"
   #include "bm25.hpp"
   #include "boost_sort.hpp"
+  #include "column_sort.hpp"
 #endif
 #include "utils/register.hpp"
 #include "utils/hash_utils.hpp"
@@ -127,6 +128,7 @@ NS_ROOT
     irs::bm25_sort::init();
     irs::tfidf_sort::init();
     irs::boost_sort::init();
+    irs::column_sort::init();
   #endif
 }
 
@@ -0,0 +1,203 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "search_executor.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+#include "index/index_reader.hpp"
+#include "search/top_docs_collector.hpp"
+#include "utils/log.hpp"
+#include "utils/thread_utils.hpp"
+
+NS_LOCAL
+
+using namespace irs;
+
+using hit = search_executor::hit;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief strict weak ordering of hits, better hits go first
+////////////////////////////////////////////////////////////////////////////////
+class hit_less {
+ public:
+  explicit hit_less(const order::prepared& ord) noexcept
+    : ord_(&ord) {
+  }
+
+  bool operator()(const hit& lhs, const hit& rhs) const noexcept {
+    if (!ord_->empty()) {
+      const auto* lhs_score = lhs.score.empty() ? nullptr : lhs.score.c_str();
+      const auto* rhs_score = rhs.score.empty() ? nullptr : rhs.score.c_str();
+
+      if (ord_->less(lhs_score, rhs_score)) {
+        return true;
+      }
+
+      if (ord_->less(rhs_score, lhs_score)) {
+        return false;
+      }
+    }
+
+    return lhs.segment == rhs.segment
+      ? lhs.doc < rhs.doc
+      : lhs.segment < rhs.segment;
+  }
+
+ private:
+  const order::prepared* ord_;
+}; // hit_less
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief collect at most 'limit' best live documents of a segment
+////////////////////////////////////////////////////////////////////////////////
+void collect(
+    const sub_reader& segment,
+    size_t segment_id,
+    const filter::prepared& filter,
+    const order::prepared& ord,
+    size_t limit,
+    const attribute_provider* ctx,
+    std::vector<hit>& hits) {
+  top_docs_collector collector(limit, ord);
+  collector.collect(segment, segment_id, filter, ctx);
+
+  for (auto& top : collector.top()) {
+    hits.push_back({ bstring(top.key.c_str(), top.key.size()), top.segment, top.doc });
+  }
+}
+
+NS_END
+
+NS_ROOT
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   search_executor
+// -----------------------------------------------------------------------------
+
+std::vector<search_executor::hit> search_executor::execute(
+    const index_reader& rdr,
+    const filter::prepared& filter,
+    const order::prepared& ord,
+    size_t limit,
+    const attribute_provider* ctx /*= nullptr*/) const {
+  const size_t count = rdr.size();
+
+  if (!limit || !count) {
+    return {};
+  }
+
+  // state shared with helper tasks, it may outlive the call in case a helper
+  // task gets started after all segments have been processed
+  struct state_t {
+    const index_reader* rdr;
+    const filter::prepared* query;
+    const order::prepared* ord;
+    const attribute_provider* ctx;
+    size_t limit;
+    std::vector<std::vector<hit>> hits; // per segment
+    std::atomic<size_t> next{}; // next segment to process
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::exception_ptr error;
+    size_t done{}; // number of processed segments
+  };
+
+  auto state = std::make_shared<state_t>();
+  state->rdr = &rdr;
+  state->query = &filter;
+  state->ord = &ord;
+  state->ctx = ctx;
+  state->limit = limit;
+  state->hits.resize(count);
+
+  // process segments until there are none left, referenced arguments are
+  // only accessed while there's an unprocessed segment, i.e. while the
+  // calling thread is still waiting
+  auto worker = [state, count]() noexcept {
+    for (size_t i; (i = state->next.fetch_add(1)) < count;) {
+      std::exception_ptr error;
+
+      try {
+        collect((*state->rdr)[i], i, *state->query, *state->ord,
+                state->limit, state->ctx, state->hits[i]);
+      } catch (...) {
+        error = std::current_exception();
+      }
+
+      SCOPED_LOCK(state->mutex);
+
+      if (error && !state->error) {
+        state->error = std::move(error);
+      }
+
+      if (++state->done == count) {
+        state->cond.notify_all();
+      }
+    }
+  };
+
+  if (pool_ && count > 1) {
+    const size_t helpers = std::min(count - 1, std::max(size_t(1), pool_->max_threads()));
+
+    for (size_t i = 0; i < helpers; ++i) {
+      if (!pool_->run(worker)) {
+        break; // pool isn't active, remaining segments are processed in place
+      }
+    }
+  }
+
+  worker();
+
+  {
+    SCOPED_LOCK_NAMED(state->mutex, lock);
+
+    while (state->done != count) {
+      state->cond.wait(lock);
+    }
+
+    if (state->error) {
+      std::rethrow_exception(state->error);
+    }
+  }
+
+  // merge per-segment results
+  std::vector<hit> result;
+
+  for (auto& hits : state->hits) {
+    std::move(hits.begin(), hits.end(), std::back_inserter(result));
+  }
+
+  const hit_less less(ord);
+
+  if (result.size() > limit) {
+    std::partial_sort(result.begin(), result.begin() + limit, result.end(), less);
+    result.resize(limit);
+  } else {
+    std::sort(result.begin(), result.end(), less);
+  }
+
+  return result;
+}
+
+NS_END
@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_SEARCH_EXECUTOR_H
+#define IRESEARCH_SEARCH_EXECUTOR_H
+
+#include <vector>
+
+#include "filter.hpp"
+#include "utils/async_utils.hpp"
+#include "utils/noncopyable.hpp"
+
+NS_ROOT
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class search_executor
+/// @brief executes a prepared filter over all segments of an index reader,
+///        segments are processed concurrently on a thread pool, top-k
+///        documents are collected per segment and merged afterwards
+/// @note hits are ordered by score, ties are broken by segment and document
+///       id, i.e. the result doesn't depend on the number of threads
+/// @note the calling thread takes part in the execution, so it's safe to
+///       execute queries from within tasks of the same thread pool
+////////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API search_executor : private util::noncopyable {
+ public:
+  struct hit {
+    bstring score; // empty for unscored queries
+    size_t segment; // offset of the segment in the index reader
+    doc_id_t doc;
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @param pool thread pool to run segments on,
+  ///        nullptr == execute segments sequentially by the calling thread
+  //////////////////////////////////////////////////////////////////////////////
+  explicit search_executor(async_utils::thread_pool* pool = nullptr) noexcept
+    : pool_(pool) {
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief execute the specified filter and collect at most 'limit' best
+  ///        live documents according to the specified order, for an empty
+  ///        order the first 'limit' documents in index order are returned
+  /// @note the filter and the order must be prepared against 'rdr'
+  //////////////////////////////////////////////////////////////////////////////
+  std::vector<hit> execute(
+    const index_reader& rdr,
+    const filter::prepared& filter,
+    const order::prepared& ord,
+    size_t limit,
+    const attribute_provider* ctx = nullptr) const;
+
+ private:
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  async_utils::thread_pool* pool_;
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // search_executor
+
+NS_END
+
+#endif // IRESEARCH_SEARCH_EXECUTOR_H
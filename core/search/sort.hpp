@@ -146,6 +146,51 @@ class score_function : util::noncopyable {
   score_f func_;
 }; // score_function
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief score a block of 'count' documents denoted by 'docs' having term
+///        frequencies 'freqs', the score of the i-th document is written to
+///        'scores + i*stride'
+/// @note documents are in ascending order
+////////////////////////////////////////////////////////////////////////////////
+using score_block_f = void(*)(score_ctx* ctx,
+                              const doc_id_t* docs,
+                              const uint32_t* freqs,
+                              size_t count,
+                              byte_type* scores,
+                              size_t stride);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class block_score_function
+/// @brief a convenient wrapper around score_block_f and score_ctx
+////////////////////////////////////////////////////////////////////////////////
+class block_score_function : util::noncopyable {
+ public:
+  block_score_function() = default;
+  block_score_function(std::unique_ptr<score_ctx>&& ctx, const score_block_f func) noexcept
+    : ctx_(std::move(ctx)), func_(func) {
+  }
+  block_score_function(block_score_function&&) = default;
+  block_score_function& operator=(block_score_function&&) = default;
+
+  void operator()(
+      const doc_id_t* docs,
+      const uint32_t* freqs,
+      size_t count,
+      byte_type* scores,
+      size_t stride) const {
+    assert(func_);
+    func_(ctx_.get(), docs, freqs, count, scores, stride);
+  }
+
+  explicit operator bool() const noexcept {
+    return nullptr != func_;
+  }
+
+ private:
+  std::unique_ptr<score_ctx> ctx_;
+  score_block_f func_{};
+}; // block_score_function
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @class sort
 /// @brief base class for all user-side sort entries
@@ -384,6 +429,40 @@ class IRESEARCH_API sort {
       const attribute_provider& doc_attrs,
       boost_t boost) const = 0;
 
+    ////////////////////////////////////////////////////////////////////////////////
+    /// @brief create a stateful function computing an upper bound of the scores
+    ///        produced by a scorer prepared with the same arguments, the bound
+    ///        is evaluated for the block denoted by 'frequency_bound' attribute
+    /// @return empty function if the bound can't be computed
+    /// @note the default implementation doesn't support bounds
+    ////////////////////////////////////////////////////////////////////////////////
+    virtual score_function prepare_bound(
+        const sub_reader& /*segment*/,
+        const term_reader& /*field*/,
+        const byte_type* /*stats*/,
+        byte_type* /*bound*/,
+        const attribute_provider& /*doc_attrs*/,
+        boost_t /*boost*/) const {
+      return { nullptr, nullptr };
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// @brief create a function scoring blocks of documents of a single term
+    ///        given their frequencies, unlike a scorer it doesn't depend on
+    ///        the current iterator position but must produce the same scores
+    ///        as a scorer prepared with the same arguments
+    /// @return empty function if block scoring isn't supported
+    /// @note the default implementation doesn't support block scoring
+    ////////////////////////////////////////////////////////////////////////////////
+    virtual block_score_function prepare_block_scorer(
+        const sub_reader& /*segment*/,
+        const term_reader& /*field*/,
+        const byte_type* /*stats*/,
+        const attribute_provider& /*doc_attrs*/,
+        boost_t /*boost*/) const {
+      return {};
+    }
+
     ////////////////////////////////////////////////////////////////////////////
     /// @brief create an object to be used for collecting index statistics, one
     ///        instance per matched term
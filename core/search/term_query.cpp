@@ -79,6 +79,21 @@ doc_iterator::ptr term_query::execute(
 
       irs::reset(*score, std::move(scorers));
     }
+
+    auto* bound = irs::get_mutable<score_upper_bound>(docs.get());
+    auto* freq_bound = irs::get_mutable<frequency_bound>(docs.get());
+
+    if (bound && freq_bound) {
+      irs::reset(*bound, *freq_bound, ord, rdr, *state->reader,
+                 stats_.c_str(), *docs, boost());
+    }
+
+    auto* block = irs::get_mutable<score_block>(docs.get());
+
+    if (block) {
+      irs::reset(*block, ord, rdr, *state->reader,
+                 stats_.c_str(), *docs, boost());
+    }
   }
 
   return docs;
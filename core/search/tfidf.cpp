@@ -30,6 +30,10 @@
 #include "index/field_meta.hpp"
 #include "utils/math_utils.hpp"
 
+#ifdef IRESEARCH_SSE2
+#include <emmintrin.h>
+#endif
+
 NS_LOCAL
 
 const irs::math::sqrt<uint32_t, float_t, 1024> SQRT;
@@ -290,6 +294,89 @@ struct norm_score_ctx final : public score_ctx {
   irs::norm norm_;
 }; // norm_score_ctx
 
+struct bound_ctx final : public irs::score_ctx {
+  bound_ctx(
+      byte_type* score_buf,
+      irs::boost_t boost,
+      const tfidf::idf& idf,
+      const frequency_bound* freq) noexcept
+    : score_buf(score_buf),
+      freq(freq),
+      idf(boost * idf.value) {
+    assert(freq);
+  }
+
+  byte_type* score_buf;
+  const frequency_bound* freq; // block frequency bound
+  float_t idf; // precomputed : boost * idf
+}; // bound_ctx
+
+struct block_ctx final : public irs::score_ctx {
+  block_ctx(
+      irs::norm&& norm,
+      irs::boost_t boost,
+      const tfidf::idf& idf) noexcept
+    : norm_(std::move(norm)),
+      idf(boost * idf.value) {
+  }
+
+  irs::norm norm_;
+  float_t idf; // precomputed : boost * idf
+}; // block_ctx
+
+// number of documents scored at once by 'score_block'
+constexpr size_t SCORE_BLOCK_SIZE = 64;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief scores a block of documents, evaluates the same expression as the
+///        per-document scorers, the 'idf * tf' part is vectorized, norms are
+///        read one by one
+////////////////////////////////////////////////////////////////////////////////
+void score_block(
+    irs::score_ctx* ctx,
+    const doc_id_t* docs,
+    const uint32_t* freqs,
+    size_t count,
+    byte_type* scores,
+    size_t stride) {
+  auto& state = *static_cast<tfidf::block_ctx*>(ctx);
+
+  float_t values[SCORE_BLOCK_SIZE];
+
+  while (count) {
+    const size_t size = std::min(count, SCORE_BLOCK_SIZE);
+    size_t i = 0;
+
+#ifdef IRESEARCH_SSE2
+    const __m128 idf = _mm_set1_ps(state.idf);
+
+    for (; i + 4 <= size; i += 4) {
+      const __m128i freq = _mm_loadu_si128(reinterpret_cast<const __m128i*>(freqs + i));
+      const __m128 tf = _mm_sqrt_ps(_mm_cvtepi32_ps(freq));
+      _mm_storeu_ps(values + i, _mm_mul_ps(idf, tf));
+    }
+#endif
+
+    for (; i < size; ++i) {
+      values[i] = ::tfidf(freqs[i], state.idf);
+    }
+
+    if (!state.norm_.empty()) {
+      for (i = 0; i < size; ++i) {
+        values[i] *= state.norm_.read(docs[i]);
+      }
+    }
+
+    for (i = 0; i < size; ++i, scores += stride) {
+      irs::sort::score_cast<score_t>(scores) = values[i];
+    }
+
+    docs += size;
+    freqs += size;
+    count -= size;
+  }
+}
+
 class sort final: public irs::prepared_sort_basic<tfidf::score_t, tfidf::idf> {
  public:
   explicit sort(bool normalize) noexcept
@@ -427,6 +514,65 @@ class sort final: public irs::prepared_sort_basic<tfidf::score_t, tfidf::idf> {
     }
   }
 
+  virtual score_function prepare_bound(
+      const sub_reader& /*segment*/,
+      const term_reader& /*field*/,
+      const byte_type* stats_buf,
+      byte_type* bound_buf,
+      const attribute_provider& doc_attrs,
+      boost_t boost) const override {
+    auto* freq = irs::get<frequency_bound>(doc_attrs);
+
+    if (!freq || boost < 0.f || irs::get<irs::filter_boost>(doc_attrs)) {
+      // unbounded
+      return { nullptr, nullptr };
+    }
+
+    // norm value doesn't exceed 1, so it's safe to ignore it
+    return {
+      memory::make_unique<tfidf::bound_ctx>(bound_buf, boost, stats_cast(stats_buf), freq),
+      [](irs::score_ctx* ctx) noexcept -> const byte_type* {
+        auto& state = *static_cast<tfidf::bound_ctx*>(ctx);
+        irs::sort::score_cast<score_t>(state.score_buf) = ::tfidf(state.freq->value(), state.idf);
+
+        return state.score_buf;
+      }
+    };
+  }
+
+  virtual block_score_function prepare_block_scorer(
+      const sub_reader& segment,
+      const term_reader& field,
+      const byte_type* stats_buf,
+      const attribute_provider& doc_attrs,
+      boost_t boost) const override {
+    if (!irs::get<frequency>(doc_attrs) || irs::get<irs::filter_boost>(doc_attrs)) {
+      // scores don't depend on frequency or depend on
+      // a per-document boost, see 'prepare_scorer'
+      return {};
+    }
+
+    irs::norm norm;
+
+    if (normalize_) {
+      auto* doc = irs::get<document>(doc_attrs);
+
+      if (!doc) {
+        // we need 'document' attribute to be exposed
+        return {};
+      }
+
+      if (!norm.reset(segment, field.meta().norm, *doc)) {
+        norm.clear();
+      }
+    }
+
+    return {
+      memory::make_unique<tfidf::block_ctx>(std::move(norm), boost, stats_cast(stats_buf)),
+      &tfidf::score_block
+    };
+  }
+
   virtual irs::sort::term_collector::ptr prepare_term_collector() const override {
     return irs::memory::make_unique<term_collector>();
   }
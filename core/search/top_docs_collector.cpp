@@ -0,0 +1,304 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "top_docs_collector.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "index/index_reader.hpp"
+#include "search/score.hpp"
+
+NS_LOCAL
+
+// max number of documents scored at once via 'score_block'
+constexpr size_t SCORE_BATCH_SIZE = 128;
+
+NS_END
+
+NS_ROOT
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                top_docs_collector
+// -----------------------------------------------------------------------------
+
+top_docs_collector::top_docs_collector(size_t limit, const order::prepared& ord)
+  : ord_(&ord),
+    no_score_(ord.score_size(), 0),
+    limit_(limit),
+    score_size_(ord.score_size()) {
+}
+
+top_docs_collector::top_docs_collector(
+    size_t limit,
+    const string_ref& column,
+    bool reverse /*= false*/)
+  : ord_(&order::prepared::unordered()),
+    column_(column),
+    limit_(limit),
+    score_size_(0),
+    by_column_(true),
+    reverse_(reverse) {
+}
+
+void top_docs_collector::collect(
+    const index_reader& rdr,
+    const filter::prepared& filter,
+    const attribute_provider* ctx /*= nullptr*/) {
+  for (size_t i = 0, count = rdr.size(); i < count; ++i) {
+    collect(rdr[i], i, filter, ctx);
+  }
+}
+
+void top_docs_collector::collect(
+    const sub_reader& segment,
+    size_t segment_id,
+    const filter::prepared& filter,
+    const attribute_provider* ctx /*= nullptr*/) {
+  if (!limit_) {
+    return;
+  }
+
+  auto docs = segment.mask(filter.execute(segment, *ord_, ctx));
+  assert(docs);
+
+  if (by_column_) {
+    collect_by_column(*docs, segment, segment_id);
+  } else {
+    collect_by_score(*docs, segment_id);
+  }
+}
+
+void top_docs_collector::collect_by_column(
+    doc_iterator& docs,
+    const sub_reader& segment,
+    size_t segment_id) {
+  const auto* column = segment.column_reader(column_);
+  const auto values = column
+    ? column->values()
+    : columnstore_reader::empty_reader();
+  bytes_ref value;
+
+  while (docs.next()) {
+    ++visited_;
+    const doc_id_t doc = docs.value();
+
+    if (!values(doc, value)) {
+      value = bytes_ref::EMPTY;
+    }
+
+    push(segment_id, doc, value);
+  }
+}
+
+void top_docs_collector::collect_by_score(doc_iterator& docs, size_t segment_id) {
+  const auto& score = irs::score::get(docs);
+  const bool has_score = score_size_ && !score.is_default();
+  auto* threshold = has_score
+    ? irs::get_mutable<score_threshold>(&docs)
+    : nullptr;
+
+  // documents not exceeding the worst collected one can be skipped
+  auto update_threshold = [this, threshold]() {
+    if (threshold && full()) {
+      const auto worst = key(heap_.front().slot);
+      threshold->value.assign(worst.c_str(), worst.size());
+    }
+  };
+
+  update_threshold();
+
+  const auto* block = has_score ? irs::get<score_block>(docs) : nullptr;
+  const auto* freq = irs::get<frequency>(docs);
+
+  if (block && !block->empty() && freq) {
+    // score documents in batches, the threshold is updated once per batch
+    doc_id_t batch_docs[SCORE_BATCH_SIZE];
+    uint32_t batch_freqs[SCORE_BATCH_SIZE];
+    block_scores_.resize(SCORE_BATCH_SIZE*score_size_);
+
+    for (size_t count = SCORE_BATCH_SIZE; count == SCORE_BATCH_SIZE;) {
+      for (count = 0; count < SCORE_BATCH_SIZE && docs.next(); ++count) {
+        batch_docs[count] = docs.value();
+        batch_freqs[count] = freq->value;
+      }
+
+      if (!count) {
+        break;
+      }
+
+      visited_ += count;
+      block->evaluate(batch_docs, batch_freqs, count, &block_scores_[0]);
+
+      bool collected = false;
+
+      for (size_t i = 0; i < count; ++i) {
+        const bytes_ref value(block_scores_.c_str() + i*score_size_, score_size_);
+        collected |= push(segment_id, batch_docs[i], value);
+      }
+
+      if (collected) {
+        update_threshold();
+      }
+    }
+
+    return;
+  }
+
+  while (docs.next()) {
+    ++visited_;
+
+    if (!has_score) {
+      if (!push(segment_id, docs.value(), no_score_)) {
+        break; // subsequent documents have equal keys and greater ids
+      }
+
+      continue;
+    }
+
+    if (push(segment_id, docs.value(), bytes_ref(score.evaluate(), score_size_))) {
+      update_threshold();
+    }
+  }
+}
+
+bytes_ref top_docs_collector::key(size_t slot) const noexcept {
+  if (by_column_) {
+    assert(slot < values_.size());
+    return values_[slot];
+  }
+
+  assert((slot + 1)*score_size_ <= scores_.size());
+  return bytes_ref(scores_.c_str() + slot*score_size_, score_size_);
+}
+
+bool top_docs_collector::key_less(
+    const bytes_ref& lhs,
+    const bytes_ref& rhs) const noexcept {
+  if (by_column_) {
+    return reverse_ ? rhs < lhs : lhs < rhs;
+  }
+
+  return score_size_ && ord_->less(lhs.c_str(), rhs.c_str());
+}
+
+bool top_docs_collector::less(const entry& lhs, const entry& rhs) const noexcept {
+  const auto lhs_key = key(lhs.slot);
+  const auto rhs_key = key(rhs.slot);
+
+  if (key_less(lhs_key, rhs_key)) {
+    return true;
+  }
+
+  if (key_less(rhs_key, lhs_key)) {
+    return false;
+  }
+
+  return lhs.segment == rhs.segment
+    ? lhs.doc < rhs.doc
+    : lhs.segment < rhs.segment;
+}
+
+bool top_docs_collector::push(
+    size_t segment_id,
+    doc_id_t doc,
+    const bytes_ref& value) {
+  auto less = [this](const entry& lhs, const entry& rhs) noexcept {
+    return this->less(lhs, rhs);
+  };
+
+  size_t slot;
+
+  if (heap_.size() < limit_) {
+    slot = heap_.size();
+
+    if (by_column_) {
+      if (slot == values_.size()) {
+        values_.emplace_back();
+      }
+    } else if (scores_.size() < (slot + 1)*score_size_) {
+      scores_.resize((slot + 1)*score_size_);
+    }
+
+    heap_.push_back({ segment_id, doc, slot });
+  } else {
+    const auto& worst = heap_.front();
+    const auto worst_key = key(worst.slot);
+
+    if (!key_less(value, worst_key)
+        && (key_less(worst_key, value)
+            || (worst.segment == segment_id ? worst.doc < doc : worst.segment < segment_id))) {
+      return false; // doesn't rank better than the worst collected hit
+    }
+
+    std::pop_heap(heap_.begin(), heap_.end(), less);
+    auto& back = heap_.back();
+    back.segment = segment_id;
+    back.doc = doc;
+    slot = back.slot;
+  }
+
+  if (by_column_) {
+    auto& stored = values_[slot];
+    stored.clear();
+    stored.append(value.c_str(), value.size());
+  } else if (score_size_) {
+    assert(value.size() == score_size_);
+    std::memcpy(&scores_[slot*score_size_], value.c_str(), score_size_);
+  }
+
+  std::push_heap(heap_.begin(), heap_.end(), less);
+
+  return true;
+}
+
+void top_docs_collector::reset() noexcept {
+  heap_.clear();
+  visited_ = 0;
+}
+
+bytes_ref top_docs_collector::threshold() const noexcept {
+  return !heap_.empty() && full()
+    ? key(heap_.front().slot)
+    : bytes_ref::NIL;
+}
+
+std::vector<top_docs_collector::hit> top_docs_collector::top() const {
+  auto entries = heap_;
+
+  std::sort(
+    entries.begin(), entries.end(),
+    [this](const entry& lhs, const entry& rhs) noexcept {
+      return less(lhs, rhs);
+  });
+
+  std::vector<hit> hits;
+  hits.reserve(entries.size());
+
+  for (auto& entry : entries) {
+    hits.push_back({ key(entry.slot), entry.segment, entry.doc });
+  }
+
+  return hits;
+}
+
+NS_END
@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_TOP_DOCS_COLLECTOR_H
+#define IRESEARCH_TOP_DOCS_COLLECTOR_H
+
+#include <vector>
+
+#include "filter.hpp"
+#include "utils/noncopyable.hpp"
+
+NS_ROOT
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class top_docs_collector
+/// @brief collects the best 'limit' live documents produced by a prepared
+///        filter over one or more segments, documents are ranked either by
+///        score or by the value of a stored column
+/// @note hits with equal keys are ordered by segment and document id
+/// @note the collector keeps a fixed-size heap of (key, segment, doc) where
+///       fixed-size score keys are stored in a single contiguous buffer
+/// @note when ranking by score the key of the worst collected hit is
+///       exposed to iterators via 'score_threshold' once the heap is full,
+///       so that non-competitive documents may be skipped
+/// @note term iterators exposing 'score_block' get scored in batches of
+///       documents rather than document by document
+/// @note not thread-safe, use one collector per thread
+////////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API top_docs_collector : private util::noncopyable {
+ public:
+  struct hit {
+    bytes_ref key; // score or column value, valid until the next collection
+    size_t segment; // segment identifier supplied to 'collect(...)'
+    doc_id_t doc;
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief rank documents by score according to the specified order, for
+  ///        an empty order the first 'limit' documents are collected,
+  ///        documents without score rank as having a zero-initialized score
+  /// @note the order must outlive the collector
+  //////////////////////////////////////////////////////////////////////////////
+  top_docs_collector(size_t limit, const order::prepared& ord);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief rank documents by the value of the specified stored column,
+  ///        values are compared lexicographically, documents without a value
+  ///        are treated as having an empty value
+  /// @param reverse prefer greater values
+  //////////////////////////////////////////////////////////////////////////////
+  top_docs_collector(size_t limit, const string_ref& column, bool reverse = false);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief collect documents of all segments of the specified reader,
+  ///        segments are identified by their offset in the reader
+  //////////////////////////////////////////////////////////////////////////////
+  void collect(
+    const index_reader& rdr,
+    const filter::prepared& filter,
+    const attribute_provider* ctx = nullptr);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief collect documents of the specified segment
+  //////////////////////////////////////////////////////////////////////////////
+  void collect(
+    const sub_reader& segment,
+    size_t segment_id,
+    const filter::prepared& filter,
+    const attribute_provider* ctx = nullptr);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns key of the worst collected hit if the collector is full,
+  ///          i.e. a document has to rank better to be collected,
+  ///          empty reference otherwise
+  //////////////////////////////////////////////////////////////////////////////
+  bytes_ref threshold() const noexcept;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns collected hits, best first
+  //////////////////////////////////////////////////////////////////////////////
+  std::vector<hit> top() const;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief drop collected hits, allocated memory is retained
+  //////////////////////////////////////////////////////////////////////////////
+  void reset() noexcept;
+
+  size_t limit() const noexcept { return limit_; }
+  size_t size() const noexcept { return heap_.size(); }
+  bool full() const noexcept { return heap_.size() == limit_; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns number of documents visited by the collector, may be less than
+  ///          the number of matching documents due to early termination
+  //////////////////////////////////////////////////////////////////////////////
+  size_t visited() const noexcept { return visited_; }
+
+ private:
+  struct entry {
+    size_t segment;
+    doc_id_t doc;
+    size_t slot; // offset of the key storage
+  };
+
+  void collect_by_column(doc_iterator& docs, const sub_reader& segment, size_t segment_id);
+  void collect_by_score(doc_iterator& docs, size_t segment_id);
+  bytes_ref key(size_t slot) const noexcept;
+  bool key_less(const bytes_ref& lhs, const bytes_ref& rhs) const noexcept;
+  bool less(const entry& lhs, const entry& rhs) const noexcept;
+  bool push(size_t segment_id, doc_id_t doc, const bytes_ref& key);
+
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  const order::prepared* ord_;
+  std::string column_;
+  std::vector<entry> heap_; // worst collected hit on top
+  bstring scores_; // 'limit_' fixed-size score slots
+  bstring no_score_; // key of documents without score
+  bstring block_scores_; // scores of a batch of documents
+  std::vector<bstring> values_; // 'limit_' column value slots
+  size_t limit_;
+  size_t score_size_;
+  size_t visited_{};
+  bool by_column_{};
+  bool reverse_{};
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // top_docs_collector
+
+NS_END
+
+#endif // IRESEARCH_TOP_DOCS_COLLECTOR_H
@@ -91,6 +91,35 @@ inline auto executeWildcard(
   }
 }
 
+// returns a part of a specified pattern following leading '%', if the part
+// starts with a literal, i.e. the pattern is matched by some suffix of a term
+// iff the part is matched by that suffix, empty reference otherwise
+bytes_ref suffix_pattern(const bytes_ref& pattern) noexcept {
+  const auto* begin = pattern.begin();
+  const auto* end = pattern.end();
+  const auto* pos = std::find_if(begin, end, [](byte_type c) {
+    return c != WildcardMatch::ANY_STRING;
+  });
+
+  if (pos == begin || pos == end || WildcardMatch::ANY_CHAR == *pos) {
+    return bytes_ref::NIL;
+  }
+
+  return bytes_ref(pos, size_t(end - pos));
+}
+
+// returns automaton accepting a specified wildcard pattern,
+// cached one is preferred
+compiled_automaton::ptr compile_wildcard(const bytes_ref& pattern) {
+  automaton_cache_key key;
+  key.type = irs::type<by_wildcard>::id();
+  key.pattern = pattern;
+
+  return compile_automaton(key, [&pattern]() {
+    return from_wildcard(pattern);
+  });
+}
+
 NS_END
 
 NS_ROOT
@@ -127,18 +156,7 @@ field_visitor by_wildcard::visitor(const bytes_ref& term) {
       };
     },
     [](const bytes_ref& term) -> field_visitor{
-      struct automaton_context : util::noncopyable {
-        automaton_context(const bytes_ref& term)
-          : acceptor(from_wildcard(term)),
-            matcher(make_automaton_matcher(acceptor)) {
-        }
-
-        automaton acceptor;
-        automaton_table_matcher matcher;
-      };
-
-      // FIXME
-      auto ctx = memory::make_shared<automaton_context>(term);
+      auto ctx = compile_wildcard(term);
 
       if (!validate(ctx->acceptor)) {
         return [](const sub_reader&, const term_reader&, filter_visitor&) { };
@@ -147,7 +165,7 @@ field_visitor by_wildcard::visitor(const bytes_ref& term) {
       return [ctx](
           const sub_reader& segment,
           const term_reader& field,
-          filter_visitor& visitor) mutable {
+          filter_visitor& visitor) {
         return irs::visit(segment, field, ctx->matcher, visitor);
       };
     }
@@ -160,7 +178,19 @@ field_visitor by_wildcard::visitor(const bytes_ref& term) {
     boost_t boost,
     const string_ref& field,
     const bytes_ref& term,
-    size_t scored_terms_limit) {
+    size_t scored_terms_limit,
+    const string_ref& suffix_field /*= string_ref::NIL*/) {
+  if (!suffix_field.empty()) {
+    const auto suffix = suffix_pattern(term);
+
+    if (!suffix.null()) {
+      // e.g. '%foo%' turns into a prefix query 'foo%' over the suffixes
+      // of the terms, and '%.log' into a term query '.log'
+      return prepare(index, order, boost, suffix_field,
+                     suffix, scored_terms_limit);
+    }
+  }
+
   bstring buf;
   return executeWildcard(
     buf, term,
@@ -174,7 +204,7 @@ field_visitor by_wildcard::visitor(const bytes_ref& term) {
       return by_prefix::prepare(index, order, boost, field, term, scored_terms_limit);
     },
     [&index, &order, boost, &field, scored_terms_limit](const bytes_ref& term) -> filter::prepared::ptr {
-      return prepare_automaton_filter(field, from_wildcard(term), scored_terms_limit,
+      return prepare_automaton_filter(field, *compile_wildcard(term), scored_terms_limit,
                                       index, order, boost);
     }
   );
@@ -59,13 +59,25 @@ struct IRESEARCH_API by_wildcard_options : by_wildcard_filter_options {
   //////////////////////////////////////////////////////////////////////////////
   size_t scored_terms_limit{1024};
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief name of a field indexed with all suffixes of the terms of the
+  ///        filter field (see suffix_token_stream), if not empty patterns
+  ///        starting with '%' followed by a literal, e.g. '%.log' or '%foo%',
+  ///        are evaluated against it instead of traversing the whole term
+  ///        dictionary of the filter field
+  //////////////////////////////////////////////////////////////////////////////
+  std::string suffix_field;
+
   bool operator==(const by_wildcard_options& rhs) const noexcept {
     return filter_options::operator==(rhs) &&
-      scored_terms_limit == rhs.scored_terms_limit;
+      scored_terms_limit == rhs.scored_terms_limit &&
+      suffix_field == rhs.suffix_field;
   }
 
   size_t hash() const noexcept {
-    return hash_combine(filter_options::hash(), scored_terms_limit);
+    return hash_combine(
+      hash_combine(filter_options::hash(), scored_terms_limit),
+      suffix_field);
   }
 }; // by_wildcard_options
 
@@ -88,7 +100,8 @@ class IRESEARCH_API by_wildcard final
     boost_t boost,
     const string_ref& field,
     const bytes_ref& term,
-    size_t scored_terms_limit);
+    size_t scored_terms_limit,
+    const string_ref& suffix_field = string_ref::NIL);
 
   static field_visitor visitor(const bytes_ref& term);
 
@@ -101,7 +114,8 @@ class IRESEARCH_API by_wildcard final
       const attribute_provider* /*ctx*/) const override {
     return prepare(index, order, this->boost()*boost,
                    field(), options().term,
-                   options().scored_terms_limit);
+                   options().scored_terms_limit,
+                   options().suffix_field);
   }
 }; // by_wildcard
 
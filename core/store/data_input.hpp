@@ -122,6 +122,10 @@ struct IRESEARCH_API index_input : public data_input {
   // specified offset without changing current position
   virtual int64_t checksum(size_t offset) const = 0;
 
+  // hints that the specified range is going to be read soon, implementation
+  // may start loading it asynchronously, does nothing by default
+  virtual void prefetch(size_t /*offset*/, size_t /*size*/) noexcept { }
+
  private:
   index_input& operator=( const index_input& ) = delete;
 }; // index_input
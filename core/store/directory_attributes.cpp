@@ -54,22 +54,6 @@ memory_allocator::memory_allocator(size_t pool_size)
   : allocator_(pool_size) {
 }
 
-// -----------------------------------------------------------------------------
-// --SECTION--                                                      fd_pool_size
-// -----------------------------------------------------------------------------
-
-DEFINE_FACTORY_DEFAULT(fd_pool_size)
-
-const size_t FD_POOL_DEFAULT_SIZE = 8;
-
-fd_pool_size::fd_pool_size() noexcept
-  : size(FD_POOL_DEFAULT_SIZE) { // arbitrary size
-}
-
-void fd_pool_size::clear() noexcept {
-  size = FD_POOL_DEFAULT_SIZE;
-}
-
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   index_file_refs
 // -----------------------------------------------------------------------------
@@ -66,24 +66,6 @@ class IRESEARCH_API memory_allocator : public stored_attribute {
   allocator_type allocator_;
 }; // memory_allocator
 
-//////////////////////////////////////////////////////////////////////////////
-/// @class fd_pool_size
-/// @brief the size of file descriptor pools
-///        where applicable, e.g. fs_directory
-//////////////////////////////////////////////////////////////////////////////
-struct IRESEARCH_API fd_pool_size: public stored_attribute {
-  static constexpr string_ref type_name() noexcept {
-    return "iresearch::fd_pool_size";
-  }
-
-  DECLARE_FACTORY();
-
-  fd_pool_size() noexcept;
-  void clear() noexcept;
-
-  size_t size;
-}; // fd_pool_size
-
 //////////////////////////////////////////////////////////////////////////////
 /// @class index_file_refs
 /// @brief represents a ref_counter for index related files
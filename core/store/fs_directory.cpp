@@ -27,7 +27,6 @@
 #include "error/error.hpp"
 #include "utils/locale_utils.hpp"
 #include "utils/log.hpp"
-#include "utils/object_pool.hpp"
 #include "utils/string_utils.hpp"
 #include "utils/utf8_path.hpp"
 #include "utils/file_utils.hpp"
@@ -247,14 +246,17 @@ class fs_index_output : public buffered_index_output {
 
 //////////////////////////////////////////////////////////////////////////////
 /// @class fs_index_input
+/// @brief reads data by means of positional reads of a shared file handle,
+///        i.e. neither seeking nor a separate handle is required, that makes
+///        both 'dup()' and 'reopen()' cheap and lets many threads read the
+///        same file concurrently
 //////////////////////////////////////////////////////////////////////////////
-class pooled_fs_index_input; // predeclaration used by fs_index_input
-class fs_index_input : public buffered_index_input {
+class fs_index_input final : public buffered_index_input {
  public:
   using buffered_index_input::read_internal;
 
-  virtual int64_t checksum(size_t offset) const override final {
-    const auto begin = handle_->pos;
+  virtual int64_t checksum(size_t offset) const override {
+    const auto begin = file_pointer();
     const auto end = (std::min)(begin + offset, handle_->size);
 
     crc32c crc;
@@ -262,7 +264,7 @@ class fs_index_input : public buffered_index_input {
 
     for (auto pos = begin; pos < end; ) {
       const auto to_read = (std::min)(end - pos, sizeof buf);
-      pos += const_cast<fs_index_input*>(this)->read_internal(buf, to_read);
+      pos += read_at(pos, buf, to_read);
       crc.process_bytes(buf, to_read);
     }
 
@@ -273,8 +275,7 @@ class fs_index_input : public buffered_index_input {
     return ptr(new fs_index_input(*this));
   }
 
-  static index_input::ptr open(
-      const file_path_t name, size_t pool_size, IOAdvice advice) noexcept {
+  static index_input::ptr open(const file_path_t name, IOAdvice advice) noexcept {
     assert(name);
 
     auto handle = file_handle::make();
@@ -322,10 +323,7 @@ class fs_index_input : public buffered_index_input {
     const auto buf_size = ::buffer_size(handle->handle.get());
 
     try {
-      return ptr(new fs_index_input(
-        std::move(handle),
-        buf_size,
-        pool_size));
+      return ptr(new fs_index_input(std::move(handle), buf_size));
     } catch(...) {
       IR_LOG_EXCEPTION();
     }
@@ -337,7 +335,15 @@ class fs_index_input : public buffered_index_input {
     return handle_->size;
   }
 
-  virtual ptr reopen() const override;
+  virtual ptr reopen() const override {
+    // positional reads don't depend on a state of the shared handle
+    return dup();
+  }
+
+  virtual void prefetch(size_t offset, size_t size) noexcept override {
+    // let the kernel read ahead asynchronously
+    irs::file_utils::fadvise(*handle_, offset, size, IR_FADVICE_WILLNEED);
+  }
 
  protected:
   virtual void seek_internal(size_t pos) override {
@@ -351,46 +357,11 @@ class fs_index_input : public buffered_index_input {
   }
 
   virtual size_t read_internal(byte_type* b, size_t len) override {
-    assert(b);
-    assert(handle_->handle);
-
-    void* fd = *handle_;
-
-    if (handle_->pos != pos_) {
-      if (irs::file_utils::fseek(fd, static_cast<long>(pos_), SEEK_SET) != 0) {
-        throw io_error(string_utils::to_string(
-          "failed to seek to '" IR_SIZE_T_SPECIFIER "' for input file, error '%d'",
-          pos_, irs::file_utils::ferror(fd)));
-      }
-      handle_->pos = pos_;
-    }
-
-    size_t read = irs::file_utils::fread(fd, b, sizeof(byte_type) * len);
-    pos_ = handle_->pos += read;
-
-    if (read != len) {
-      if (0 == read) {
-        //eof(true);
-        // read past eof
-        throw eof_error();
-      }
-
-      // read error
-      throw io_error(string_utils::to_string(
-        "failed to read from input file, read '" IR_SIZE_T_SPECIFIER "' out of '" IR_SIZE_T_SPECIFIER "' bytes, error '%d'",
-        read, len, irs::file_utils::ferror(fd)));
-    }
-
-    assert(handle_->pos == pos_);
-    return read;
+    pos_ += read_at(pos_, b, len);
+    return len;
   }
 
  private:
-  friend pooled_fs_index_input;
-
-  /* use shared wrapper here since we don't want to
-  * call "ftell" every time we need to know current 
-  * position */
   struct file_handle {
     using ptr = std::shared_ptr<file_handle>;
     static ptr make();
@@ -399,113 +370,47 @@ class fs_index_input : public buffered_index_input {
 
     file_utils::handle_t handle; /* native file handle */
     size_t size{}; /* file size */
-    size_t pos{}; /* current file position*/
     int posix_open_advice{ IR_FADVICE_NORMAL };
   }; // file_handle
 
-  fs_index_input(
-      file_handle::ptr&& handle,
-      size_t buffer_size,
-      size_t pool_size) noexcept
+  fs_index_input(file_handle::ptr&& handle, size_t buffer_size) noexcept
     : buffered_index_input(buffer_size),
       handle_(std::move(handle)),
-      pool_size_(pool_size),
       pos_(0) {
     assert(handle_);
   }
 
+  fs_index_input(const fs_index_input&) = default;
   fs_index_input& operator=(const fs_index_input&) = delete;
 
-  file_handle::ptr handle_; // shared file handle
-  size_t pool_size_; // size of pool for instances of pooled_fs_index_input
-  size_t pos_; // current input stream position
-}; // fs_index_input
-
-DEFINE_FACTORY_DEFAULT(fs_index_input::file_handle)
-
-class pooled_fs_index_input final : public fs_index_input {
- public:
-  explicit pooled_fs_index_input(const fs_index_input& in);
-  virtual ~pooled_fs_index_input() noexcept;
-  virtual index_input::ptr dup() const override {
-    return ptr(new pooled_fs_index_input(*this));
-  }
-  virtual index_input::ptr reopen() const override;
-
- private:
-  typedef unbounded_object_pool<file_handle> fd_pool_t;
-  std::shared_ptr<fd_pool_t> fd_pool_;
-
-  pooled_fs_index_input(const pooled_fs_index_input& in) = default;
-  file_handle::ptr reopen(const file_handle& src) const;
-}; // pooled_fs_index_input
-
-index_input::ptr fs_index_input::reopen() const {
-  return memory::make_unique<pooled_fs_index_input>(*this);
-}
-
-pooled_fs_index_input::pooled_fs_index_input(const fs_index_input& in)
-  : fs_index_input(in),
-    fd_pool_(memory::make_shared<fd_pool_t>(pool_size_)) {
-  handle_ = reopen(*handle_);
-}
-
-pooled_fs_index_input::~pooled_fs_index_input() noexcept {
-  handle_.reset(); // release handle before the fs_pool_ is deallocated
-}
-
-index_input::ptr pooled_fs_index_input::reopen() const {
-  auto ptr = dup();
-  assert(ptr);
-
-  auto& in = static_cast<pooled_fs_index_input&>(*ptr);
-  in.handle_ = reopen(*handle_); // reserve a new handle from pool
-  assert(in.handle_ && in.handle_->handle);
-
-  return ptr;
-}
+  // read exactly 'len' bytes starting at the specified position
+  size_t read_at(size_t pos, byte_type* b, size_t len) const {
+    assert(b);
+    assert(handle_->handle);
 
-fs_index_input::file_handle::ptr pooled_fs_index_input::reopen(
-  const file_handle& src
-) const {
-  // reserve a new handle from the pool
-  auto handle = const_cast<pooled_fs_index_input*>(this)->fd_pool_->emplace().release();
+    void* fd = *handle_;
+    const size_t read = irs::file_utils::pread(fd, b, sizeof(byte_type) * len, pos);
 
-  if (!handle->handle) {
-    handle->handle = irs::file_utils::open(src, irs::file_utils::OpenMode::Read, src.posix_open_advice); // same permission as in fs_index_input::open(...)
+    if (read != len) {
+      if (0 == read) {
+        // read past eof
+        throw eof_error();
+      }
 
-    if (!handle->handle) {
-      // even win32 uses 'errno' for error codes in calls to file_open(...)
+      // read error
       throw io_error(string_utils::to_string(
-        "Failed to reopen input file, error: %d",
-#ifdef _WIN32
-        GetLastError()
-#else
-        errno
-#endif
-      ));
+        "failed to read from input file, read '" IR_SIZE_T_SPECIFIER "' out of '" IR_SIZE_T_SPECIFIER "' bytes, error '%d'",
+        read, len, irs::file_utils::ferror(fd)));
     }
-    handle->posix_open_advice = src.posix_open_advice;
-  }
-
-  const auto pos = irs::file_utils::ftell(handle->handle.get()); // match position of file descriptor
 
-  if (pos < 0) {
-    throw io_error(string_utils::to_string(
-      "Failed to obtain current position of input file, error: %d",
-#ifdef _WIN32
-      GetLastError()
-#else
-      errno
-#endif
-    ));
+    return read;
   }
 
-  handle->pos = pos;
-  handle->size = src.size;
+  file_handle::ptr handle_; // shared file handle
+  size_t pos_; // current input stream position
+}; // fs_index_input
 
-  return handle;
-}
+DEFINE_FACTORY_DEFAULT(fs_index_input::file_handle)
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                       fs_directory implementation
@@ -584,12 +489,10 @@ index_input::ptr fs_directory::open(
     IOAdvice advice) const noexcept {
   try {
     utf8_path path;
-    auto pool_size =
-      const_cast<attribute_store&>(attributes()).emplace<fd_pool_size>()->size;
 
     (path/=dir_)/=name;
 
-    return fs_index_input::open(path.c_str(), pool_size, advice);
+    return fs_index_input::open(path.c_str(), advice);
   } catch(...) {
     IR_LOG_EXCEPTION();
   }
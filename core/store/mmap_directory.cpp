@@ -108,6 +108,12 @@ class mmap_index_input : public irs::bytes_ref_input {
     return dup();
   }
 
+  virtual void prefetch(size_t offset, size_t size) noexcept override {
+    if (handle_) {
+      handle_->advise(offset, size, IR_MADVICE_WILLNEED);
+    }
+  }
+
  private:
   mmap_index_input(mmap_handle_ptr&& handle) noexcept
     : handle_(std::move(handle)) {
@@ -21,6 +21,7 @@
 /// @author Vasiliy Nabatchikov
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <cassert>
 
 #include "log.hpp"
@@ -423,5 +424,58 @@ void thread_pool::run() {
   }
 }
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                      rate_limiter
+// -----------------------------------------------------------------------------
+
+rate_limiter::rate_limiter(uint64_t bytes_per_sec /*= 0*/) noexcept
+  : next_(clock_t::now()),
+    rate_(bytes_per_sec) {
+}
+
+void rate_limiter::acquire(uint64_t bytes) {
+  bytes_.fetch_add(bytes, std::memory_order_relaxed);
+
+  const auto rate = rate_.load(std::memory_order_relaxed);
+
+  if (!rate || !bytes) {
+    return; // unlimited
+  }
+
+  const auto duration = std::chrono::duration_cast<clock_t::duration>(
+    std::chrono::duration<double>(double(bytes) / double(rate)));
+
+  std::unique_lock<std::mutex> lock(lock_);
+  const auto start = clock_t::now();
+
+  // do not accumulate credit while nobody writes
+  next_ = std::max(next_, start) + duration;
+  const auto until = next_ - duration;
+
+  if (until <= start) {
+    return; // bytes fit into the rate
+  }
+
+  // changing the rate wakes up delayed callers
+  cond_.wait_until(lock, until, [this, rate]()->bool {
+    return rate != rate_.load(std::memory_order_relaxed);
+  });
+
+  throttled_.fetch_add(
+    uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(
+      clock_t::now() - start).count()),
+    std::memory_order_relaxed);
+}
+
+void rate_limiter::bytes_per_sec(uint64_t value) noexcept {
+  {
+    SCOPED_LOCK(lock_);
+    rate_.store(value, std::memory_order_relaxed);
+    next_ = std::min(next_, clock_t::now()); // forget the debt of the old rate
+  }
+
+  cond_.notify_all();
+}
+
 NS_END
 NS_END
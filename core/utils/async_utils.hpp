@@ -25,8 +25,10 @@
 #define IRESEARCH_ASYNC_UTILS_H
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
+#include <mutex>
 #include <queue>
 #include <thread>
 
@@ -153,6 +155,59 @@ class IRESEARCH_API thread_pool {
   void run();
 }; // thread_pool
 
+//////////////////////////////////////////////////////////////////////////////
+/// @brief limits the aggregate rate of bytes accounted by concurrent callers,
+///        a caller accounts bytes it has just processed and is delayed until
+///        the accounted amount fits into the configured rate or the rate is
+///        changed
+//////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API rate_limiter final {
+ public:
+  using clock_t = std::chrono::steady_clock;
+
+  // @param bytes_per_sec 0 == unlimited
+  explicit rate_limiter(uint64_t bytes_per_sec = 0) noexcept;
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief account 'bytes' and block the calling thread if the rate exceeds
+  ///        the configured limit
+  ////////////////////////////////////////////////////////////////////////////
+  void acquire(uint64_t bytes);
+
+  uint64_t bytes_per_sec() const noexcept {
+    return rate_.load(std::memory_order_relaxed);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief change the rate limit, 0 == unlimited
+  ////////////////////////////////////////////////////////////////////////////
+  void bytes_per_sec(uint64_t value) noexcept;
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @returns total number of bytes accounted so far
+  ////////////////////////////////////////////////////////////////////////////
+  uint64_t bytes() const noexcept {
+    return bytes_.load(std::memory_order_relaxed);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @returns total time callers were delayed for
+  ////////////////////////////////////////////////////////////////////////////
+  std::chrono::microseconds throttled() const noexcept {
+    return std::chrono::microseconds(throttled_.load(std::memory_order_relaxed));
+  }
+
+ private:
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  std::mutex lock_;
+  std::condition_variable cond_; // notified on rate change
+  clock_t::time_point next_; // time the already accounted bytes fit the rate
+  std::atomic<uint64_t> rate_;
+  std::atomic<uint64_t> bytes_{0};
+  std::atomic<uint64_t> throttled_{0}; // in microseconds
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // rate_limiter
+
 NS_END // async_utils
 NS_END // NS_ROOT
 
@@ -25,11 +25,77 @@
 #include "index/index_reader.hpp"
 #include "search/limited_sample_collector.hpp"
 #include "utils/fst_table_matcher.hpp"
+#include "utils/lru_cache.hpp"
 
 NS_LOCAL
 
 using namespace irs;
 
+struct automaton_cache_key_hash {
+  size_t operator()(const automaton_cache_key& key) const noexcept {
+    return key.hash();
+  }
+}; // automaton_cache_key_hash
+
+typedef sharded_lru_cache<
+  automaton_cache_key,
+  compiled_automaton::ptr,
+  automaton_cache_key_hash
+> automaton_cache_t;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief process-wide cache of compiled automata shared by all automaton
+///        based filters, e.g. autocompletion keeps issuing the same fuzzy
+///        and wildcard queries, while compiling an automaton dominates the
+///        time spent in prepare
+////////////////////////////////////////////////////////////////////////////////
+automaton_cache_t& automaton_cache() {
+  static automaton_cache_t CACHE; // disabled by default
+  return CACHE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief instantiate compiled filter based on a specified matcher, the
+///        matcher isn't modified, hence may be shared between queries
+////////////////////////////////////////////////////////////////////////////////
+filter::prepared::ptr prepare_filter(
+    const string_ref& field,
+    const automaton_table_matcher& matcher,
+    size_t scored_terms_limit,
+    const index_reader& index,
+    const order::prepared& order,
+    boost_t boost) {
+  if (fst::kError == matcher.Properties(0)) {
+    IR_FRMT_ERROR("Expected deterministic, epsilon-free acceptor, "
+                  "got the following properties " IR_UINT64_T_SPECIFIER "",
+                  matcher.GetFst().Properties(automaton_table_matcher::FST_PROPERTIES, false));
+
+    return filter::prepared::empty();
+  }
+
+  limited_sample_collector<term_frequency> collector(order.empty() ? 0 : scored_terms_limit); // object for collecting order stats
+  multiterm_query::states_t states(index.size());
+  multiterm_visitor<multiterm_query::states_t> mtv(collector, states);
+
+  for (const auto& segment : index) {
+    // get term dictionary for field
+    const auto* reader = segment.field(field);
+
+    if (!reader) {
+      continue;
+    }
+
+    visit(segment, *reader, matcher, mtv);
+  }
+
+  std::vector<bstring> stats;
+  collector.score(index, order, stats);
+
+  return memory::make_managed<multiterm_query>(
+    std::move(states), std::move(stats),
+    boost, sort::MergeType::AGGREGATE);
+}
+
 // table contains indexes of states in
 // utf8_transitions_builder::rho_states_ table
 const automaton::Arc::Label UTF8_RHO_STATE_TABLE[] {
@@ -324,44 +390,84 @@ void utf8_transitions_builder::finish(automaton& a, automaton::StateId from) {
   a.EmplaceArc(rho_states_[3], fst::fsa::kRho, rho_states_[2]);
 }
 
-filter::prepared::ptr prepare_automaton_filter(
-    const string_ref& field,
-    const automaton& acceptor,
-    size_t scored_terms_limit,
-    const index_reader& index,
-    const order::prepared& order,
-    boost_t boost) {
-  auto matcher = make_automaton_matcher(acceptor);
+size_t compiled_automaton::memory() const noexcept {
+  // rough estimation of a state footprint in a vector fst
+  constexpr size_t STATE_SIZE = sizeof(automaton::State) + 2*sizeof(void*);
 
-  if (fst::kError == matcher.Properties(0)) {
-    IR_FRMT_ERROR("Expected deterministic, epsilon-free acceptor, "
-                  "got the following properties " IR_UINT64_T_SPECIFIER "",
-                  matcher.GetFst().Properties(automaton_table_matcher::FST_PROPERTIES, false));
+  const size_t num_states = size_t(acceptor.NumStates());
+  size_t size = sizeof(*this) + num_states*STATE_SIZE;
 
-    return filter::prepared::empty();
+  for (automaton::StateId s = 0; s < acceptor.NumStates(); ++s) {
+    size += acceptor.NumArcs(s)*sizeof(automaton::Arc);
   }
 
-  limited_sample_collector<term_frequency> collector(order.empty() ? 0 : scored_terms_limit); // object for collecting order stats
-  multiterm_query::states_t states(index.size());
-  multiterm_visitor<multiterm_query::states_t> mtv(collector, states);
+  // transition table of the matcher
+  return size + num_states*matcher.NumLabels()*sizeof(automaton::StateId);
+}
 
-  for (const auto& segment : index) {
-    // get term dictionary for field
-    const auto* reader = segment.field(field);
+void automaton_cache_capacity(size_t capacity) {
+  automaton_cache().capacity(capacity);
+}
 
-    if (!reader) {
-      continue;
-    }
+size_t automaton_cache_capacity() {
+  return automaton_cache().capacity();
+}
 
-    visit(segment, *reader, matcher, mtv);
+automaton_cache_stats get_automaton_cache_stats() {
+  const auto stats = automaton_cache().get_stats();
+
+  automaton_cache_stats result;
+  result.capacity = stats.capacity;
+  result.size = stats.charge;
+  result.automata = stats.count;
+  result.hits = stats.hits;
+  result.misses = stats.misses;
+
+  return result;
+}
+
+compiled_automaton::ptr get_cached_automaton(const automaton_cache_key& key) {
+  auto& cache = automaton_cache();
+  compiled_automaton::ptr compiled;
+
+  if (cache.capacity()) {
+    cache.get(key, compiled);
   }
 
-  std::vector<bstring> stats;
-  collector.score(index, order, stats);
+  return compiled;
+}
 
-  return memory::make_managed<multiterm_query>(
-    std::move(states), std::move(stats),
-    boost, sort::MergeType::AGGREGATE);
+void cache_automaton(
+    const automaton_cache_key& key,
+    const compiled_automaton::ptr& automaton) {
+  assert(automaton);
+  auto& cache = automaton_cache();
+
+  if (cache.capacity()) {
+    cache.put(key, automaton, key.pattern.size() + automaton->memory());
+  }
+}
+
+filter::prepared::ptr prepare_automaton_filter(
+    const string_ref& field,
+    const automaton& acceptor,
+    size_t scored_terms_limit,
+    const index_reader& index,
+    const order::prepared& order,
+    boost_t boost) {
+  return prepare_filter(field, make_automaton_matcher(acceptor),
+                        scored_terms_limit, index, order, boost);
+}
+
+filter::prepared::ptr prepare_automaton_filter(
+    const string_ref& field,
+    const compiled_automaton& acceptor,
+    size_t scored_terms_limit,
+    const index_reader& index,
+    const order::prepared& order,
+    boost_t boost) {
+  return prepare_filter(field, acceptor.matcher,
+                        scored_terms_limit, index, order, boost);
 }
 
 NS_END
@@ -40,6 +40,118 @@ inline automaton_table_matcher make_automaton_matcher(const automaton& a) {
   return automaton_table_matcher(a, fst::fsa::kRho);
 }
 
+//////////////////////////////////////////////////////////////////////////////
+/// @struct compiled_automaton
+/// @brief an automaton along with its transition table, immutable once
+///        constructed, hence may be shared between queries
+/// @note term dictionaries walk the table via 'Transition(...)' and keep
+///       the current state on their own, hence concurrent queries may use
+///       the same matcher
+//////////////////////////////////////////////////////////////////////////////
+struct IRESEARCH_API compiled_automaton : private util::noncopyable {
+  using ptr = std::shared_ptr<const compiled_automaton>;
+
+  explicit compiled_automaton(automaton&& acceptor)
+    : acceptor(std::move(acceptor)),
+      matcher(make_automaton_matcher(this->acceptor)) {
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns approximate amount of memory occupied by the automaton
+  //////////////////////////////////////////////////////////////////////////////
+  size_t memory() const noexcept;
+
+  const automaton acceptor;
+  const automaton_table_matcher matcher;
+}; // compiled_automaton
+
+//////////////////////////////////////////////////////////////////////////////
+/// @struct automaton_cache_key
+/// @brief identifies an automaton compiled for a filter of a particular type
+//////////////////////////////////////////////////////////////////////////////
+struct IRESEARCH_API automaton_cache_key {
+  bool operator==(const automaton_cache_key& rhs) const noexcept {
+    return type == rhs.type &&
+      description == rhs.description &&
+      max_distance == rhs.max_distance &&
+      with_transpositions == rhs.with_transpositions &&
+      pattern == rhs.pattern;
+  }
+
+  size_t hash() const noexcept {
+    return hash_combine(
+      hash_combine(std::hash<bstring>()(pattern), type),
+      (size_t(max_distance) << 1) | size_t(with_transpositions));
+  }
+
+  type_info::type_id type{}; // type of the filter
+  bstring pattern;
+  const void* description{}; // levenshtein specific, parametric description
+  byte_type max_distance{}; // levenshtein specific
+  bool with_transpositions{}; // levenshtein specific
+}; // automaton_cache_key
+
+//////////////////////////////////////////////////////////////////////////////
+/// @struct automaton_cache_stats
+/// @brief statistics of the process-wide cache of compiled automata shared
+///        by all automaton based filters
+//////////////////////////////////////////////////////////////////////////////
+struct automaton_cache_stats {
+  size_t capacity{}; // max size of cached automata in bytes
+  size_t size{}; // size of cached automata in bytes
+  size_t automata{}; // number of cached automata
+  uint64_t hits{};
+  uint64_t misses{};
+};
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief sets max size (in bytes) of compiled automata cached across
+///        queries, automata are evicted in LRU order
+/// @note 0 disables the cache (default)
+//////////////////////////////////////////////////////////////////////////////
+IRESEARCH_API void automaton_cache_capacity(size_t capacity);
+
+//////////////////////////////////////////////////////////////////////////////
+/// @returns max size (in bytes) of the automata cache
+//////////////////////////////////////////////////////////////////////////////
+IRESEARCH_API size_t automaton_cache_capacity();
+
+//////////////////////////////////////////////////////////////////////////////
+/// @returns current statistics of the automata cache
+//////////////////////////////////////////////////////////////////////////////
+IRESEARCH_API automaton_cache_stats get_automaton_cache_stats();
+
+//////////////////////////////////////////////////////////////////////////////
+/// @returns automaton cached under a specified key, nullptr if not found
+//////////////////////////////////////////////////////////////////////////////
+IRESEARCH_API compiled_automaton::ptr get_cached_automaton(
+  const automaton_cache_key& key);
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief caches a specified automaton under a specified key
+//////////////////////////////////////////////////////////////////////////////
+IRESEARCH_API void cache_automaton(
+  const automaton_cache_key& key,
+  const compiled_automaton::ptr& automaton);
+
+//////////////////////////////////////////////////////////////////////////////
+/// @returns automaton cached under a specified key, or the one produced by
+///          a specified 'compile' functor if there is no such automaton
+//////////////////////////////////////////////////////////////////////////////
+template<typename Compile>
+compiled_automaton::ptr compile_automaton(
+    const automaton_cache_key& key,
+    Compile&& compile) {
+  auto compiled = get_cached_automaton(key);
+
+  if (!compiled) {
+    compiled = memory::make_shared<compiled_automaton>(compile());
+    cache_automaton(key, compiled);
+  }
+
+  return compiled;
+}
+
 template<typename Char, typename Matcher>
 inline automaton::Weight match(
     Matcher& matcher,
@@ -405,7 +517,7 @@ template<typename Visitor>
 void visit(
     const sub_reader& segment,
     const term_reader& reader,
-    automaton_table_matcher& matcher,
+    const automaton_table_matcher& matcher,
     Visitor& visitor) {
   assert(fst::kError != matcher.Properties(0));
   auto terms = reader.iterator(matcher);
@@ -508,6 +620,25 @@ IRESEARCH_API filter::prepared::ptr prepare_automaton_filter(
   const order::prepared& order,
   boost_t boost);
 
+//////////////////////////////////////////////////////////////////////////////
+/// @brief instantiate compiled filter based on a specified compiled
+///        automaton, field and other properties
+/// @param field field name
+/// @param acceptor compiled automaton
+/// @param scored_terms_limit score as many terms
+/// @param index index reader
+/// @param order compiled order
+/// @param bool query boost
+/// @returns compiled filter
+//////////////////////////////////////////////////////////////////////////////
+IRESEARCH_API filter::prepared::ptr prepare_automaton_filter(
+  const string_ref& field,
+  const compiled_automaton& acceptor,
+  size_t scored_terms_limit,
+  const index_reader& index,
+  const order::prepared& order,
+  boost_t boost);
+
 NS_END
 
 #endif
@@ -28,6 +28,10 @@
 #ifndef IRESEARCH_DLL
   #include "lz4compression.hpp"
   #include "delta_compression.hpp"
+
+  #ifdef USE_ZSTD
+    #include "zstd_compression.hpp"
+  #endif
 #endif
 
 NS_LOCAL
@@ -171,6 +175,11 @@ void init() {
   lz4::init();
   delta::init();
   none::init();
+
+  #ifdef USE_ZSTD
+    zstd::init();
+    zstd_dict::init();
+  #endif
 #endif
 }
 
@@ -25,8 +25,110 @@
 #include "index/index_meta.hpp"
 #include "formats/formats.hpp"
 #include "utils/attributes.hpp"
+#include "utils/bytes_utils.hpp"
 #include "utils/log.hpp"
 
+NS_LOCAL
+
+using namespace irs;
+
+//////////////////////////////////////////////////////////////////////////////
+/// @class throttled_output
+/// @brief accounts bytes written to the underlying stream in the specified
+///        rate limiter once per 'chunk_size' bytes
+//////////////////////////////////////////////////////////////////////////////
+class throttled_output final : public index_output {
+ public:
+  throttled_output(
+      index_output::ptr&& out,
+      async_utils::rate_limiter& limiter,
+      size_t chunk_size) noexcept
+    : out_(std::move(out)),
+      limiter_(&limiter),
+      chunk_size_(chunk_size) {
+    assert(out_);
+  }
+
+  virtual ~throttled_output() {
+    try {
+      account();
+    } catch (...) {
+      IR_LOG_EXCEPTION();
+    }
+  }
+
+  virtual void close() override {
+    out_->close();
+    account();
+  }
+
+  virtual void flush() override {
+    out_->flush();
+  }
+
+  virtual size_t file_pointer() const override {
+    return out_->file_pointer();
+  }
+
+  virtual int64_t checksum() const override {
+    return out_->checksum();
+  }
+
+  virtual void write_byte(byte_type b) override {
+    out_->write_byte(b);
+    written(1);
+  }
+
+  virtual void write_bytes(const byte_type* b, size_t len) override {
+    out_->write_bytes(b, len);
+    written(len);
+  }
+
+  virtual void write_int(int32_t v) override {
+    out_->write_int(v);
+    written(sizeof(uint32_t));
+  }
+
+  virtual void write_long(int64_t v) override {
+    out_->write_long(v);
+    written(sizeof(uint64_t));
+  }
+
+  virtual void write_vint(uint32_t v) override {
+    out_->write_vint(v);
+    written(bytes_io<uint32_t>::vsize(v));
+  }
+
+  virtual void write_vlong(uint64_t v) override {
+    out_->write_vlong(v);
+    written(bytes_io<uint64_t>::vsize(v));
+  }
+
+ private:
+  FORCE_INLINE void written(size_t size) {
+    pending_ += size;
+
+    if (pending_ >= chunk_size_) {
+      account();
+    }
+  }
+
+  void account() {
+    if (pending_) {
+      const auto size = pending_;
+      pending_ = 0;
+      limiter_->acquire(size);
+    }
+  }
+
+  index_output::ptr out_;
+  async_utils::rate_limiter* limiter_;
+  size_t chunk_size_;
+  size_t pending_{}; // number of bytes not yet accounted in 'limiter_'
+}; // throttled_output
+
+NS_END
+
 NS_ROOT
 NS_BEGIN(directory_utils)
 
@@ -347,6 +449,39 @@ void tracking_directory::flush_tracked(file_set& other) noexcept {
   other = std::move(files_);
 }
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                               throttled_directory
+// -----------------------------------------------------------------------------
+
+throttled_directory::throttled_directory(
+    directory& impl,
+    async_utils::rate_limiter& limiter,
+    size_t chunk_size /*= 65536*/
+) noexcept
+  : impl_(impl),
+    limiter_(limiter),
+    chunk_size_(chunk_size) {
+}
+
+index_output::ptr throttled_directory::create(
+    const std::string& name
+) noexcept {
+  auto out = impl_.create(name);
+
+  if (!out) {
+    return nullptr;
+  }
+
+  try {
+    return index_output::make<::throttled_output>(
+      std::move(out), limiter_, chunk_size_);
+  } catch (...) {
+    IR_LOG_EXCEPTION();
+  }
+
+  return nullptr;
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                            ref_tracking_directory
 // -----------------------------------------------------------------------------
@@ -25,6 +25,7 @@
 #define IRESEARCH_DIRECTORY_UTILS_H
 
 #include "shared.hpp"
+#include "async_utils.hpp"
 #include "store/data_input.hpp"
 #include "store/data_output.hpp"
 #include "store/directory.hpp"
@@ -261,6 +262,88 @@ struct IRESEARCH_API ref_tracking_directory: public directory {
   IRESEARCH_API_PRIVATE_VARIABLES_END
 }; // ref_tracking_directory
 
+//////////////////////////////////////////////////////////////////////////////
+/// @class throttled_directory
+/// @brief limit write bandwidth of files created via the directory by the
+///        specified rate limiter, reads are not throttled
+//////////////////////////////////////////////////////////////////////////////
+struct IRESEARCH_API throttled_directory final : public directory {
+  // @param chunk_size - number of bytes written to a file between
+  //                     consecutive calls to the rate limiter
+  throttled_directory(
+    directory& impl,
+    async_utils::rate_limiter& limiter,
+    size_t chunk_size = 65536
+  ) noexcept;
+
+  directory& operator*() noexcept {
+    return impl_;
+  }
+
+  using directory::attributes;
+  virtual attribute_store& attributes() noexcept override {
+    return impl_.attributes();
+  }
+
+  virtual index_output::ptr create(const std::string& name) noexcept override;
+
+  virtual bool exists(
+      bool& result, const std::string& name
+  ) const noexcept override {
+    return impl_.exists(result, name);
+  }
+
+  virtual bool length(
+      uint64_t& result, const std::string& name
+  ) const noexcept override {
+    return impl_.length(result, name);
+  }
+
+  virtual index_lock::ptr make_lock(
+      const std::string& name
+  ) noexcept override {
+    return impl_.make_lock(name);
+  }
+
+  virtual bool mtime(
+      std::time_t& result, const std::string& name
+  ) const noexcept override {
+    return impl_.mtime(result, name);
+  }
+
+  virtual index_input::ptr open(
+      const std::string& name,
+      IOAdvice advice
+  ) const noexcept override {
+    return impl_.open(name, advice);
+  }
+
+  virtual bool remove(const std::string& name) noexcept override {
+    return impl_.remove(name);
+  }
+
+  virtual bool rename(
+      const std::string& src, const std::string& dst
+  ) noexcept override {
+    return impl_.rename(src, dst);
+  }
+
+  virtual bool sync(const std::string& name) noexcept override {
+    return impl_.sync(name);
+  }
+
+  virtual bool visit(const visitor_f& visitor) const override {
+    return impl_.visit(visitor);
+  }
+
+ private:
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  directory& impl_;
+  async_utils::rate_limiter& limiter_;
+  size_t chunk_size_;
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // throttled_directory
+
 NS_END
 
 #endif
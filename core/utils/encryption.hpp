@@ -200,6 +200,11 @@ class IRESEARCH_API encrypted_input : public buffered_index_input, util::noncopy
 
   virtual int64_t checksum(size_t offset) const override final;
 
+  virtual void prefetch(size_t offset, size_t size) noexcept override final {
+    // encrypted data has the same layout as the plain one
+    in_->prefetch(start_ + offset, size);
+  }
+
   const index_input& stream() const noexcept {
     return *in_;
   }
@@ -203,6 +203,61 @@ size_t fread(void* fd, void* buf, size_t size) {
 }
 
 
+size_t pread(void* fd, void* buf, size_t size, uint64_t offset) {
+  size_t left = size;
+  auto current = static_cast<byte_type*>(buf);
+#ifdef _WIN32
+  constexpr size_t maxRead = MAXDWORD;
+  while (left > 0) {
+    DWORD to_read = static_cast<DWORD>((std::min)(maxRead, left));
+    DWORD read{ 0 };
+    OVERLAPPED ov{};
+    ov.Offset = static_cast<DWORD>(offset);
+    ov.OffsetHigh = static_cast<DWORD>(offset >> 32);
+    if (ReadFile(fd, current, to_read, &read, &ov) && read > 0) {
+      left -= read;
+      current += read;
+      offset += read;
+    } else {
+      break;
+    }
+  }
+#else
+  constexpr size_t readLimit = 0x7ffff000;
+  const int descriptor = handle_cast(fd);
+  while (left > 0) {
+    size_t to_read = (std::min)(left, readLimit);
+    const ssize_t read = ::pread(descriptor, current, to_read, static_cast<off_t>(offset));
+    if (read < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;
+    } else if (read > 0) {
+      left -= read;
+      current += read;
+      offset += read;
+    } else {
+      break; // EOF reached
+    }
+  }
+#endif
+  return size - left;
+}
+
+bool fadvise(
+    [[maybe_unused]] void* fd,
+    [[maybe_unused]] uint64_t offset,
+    [[maybe_unused]] uint64_t size,
+    [[maybe_unused]] int advice) noexcept {
+#if !defined(_WIN32) && (_XOPEN_SOURCE >= 600 || _POSIX_C_SOURCE >= 200112L) && !defined(__APPLE__)
+  return 0 == posix_fadvise(
+    handle_cast(fd), static_cast<off_t>(offset), static_cast<off_t>(size), advice);
+#else
+  return false;
+#endif
+}
+
 int fseek(void* fd, long pos, int origin) {
 #ifdef _WIN32
   LARGE_INTEGER li;
@@ -53,6 +53,7 @@
   #define IR_FADVICE_RANDOM FILE_FLAG_RANDOM_ACCESS
   #define IR_FADVICE_DONTNEED 0
   #define IR_FADVICE_NOREUSE 0
+  #define IR_FADVICE_WILLNEED 0
 #else
   #include <unistd.h> // close
   #include <sys/types.h> // for blksize_t
@@ -75,12 +76,14 @@
   #define IR_FADVICE_RANDOM POSIX_FADV_RANDOM
   #define IR_FADVICE_DONTNEED POSIX_FADV_DONTNEED
   #define IR_FADVICE_NOREUSE POSIX_FADV_NOREUSE
+  #define IR_FADVICE_WILLNEED POSIX_FADV_WILLNEED
 #else
   #define IR_FADVICE_NORMAL 0
   #define IR_FADVICE_SEQUENTIAL 0
   #define IR_FADVICE_RANDOM 0
   #define IR_FADVICE_DONTNEED 0
   #define IR_FADVICE_NOREUSE 0
+  #define IR_FADVICE_WILLNEED 0
 #endif
 #endif
 
@@ -147,6 +150,12 @@ bool mkdir(const file_path_t path, bool createNew) noexcept;  // recursive direc
 bool move(const file_path_t src_path, const file_path_t dst_path) noexcept;
 
 size_t fread(void* fd, void* buf, size_t size);
+// reads up to 'size' bytes starting at the specified 'offset' without
+// changing the file position, safe to call concurrently for the same 'fd'
+size_t pread(void* fd, void* buf, size_t size, uint64_t offset);
+// announces an intention to access the specified range of a file,
+// returns false if the advice isn't supported or failed
+bool fadvise(void* fd, uint64_t offset, uint64_t size, int advice) noexcept;
 size_t fwrite(void* fd, const void* buf, size_t size);
 FORCE_INLINE bool write(void* fd, const void* buf, size_t size) { return fwrite(fd, buf, size) == size; }
 int fseek(void* fd, long pos, int origin);
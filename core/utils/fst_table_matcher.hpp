@@ -127,6 +127,12 @@ class TableMatcher final : public MatcherBase<typename F::Arc> {
     // for (size_t i = 0; i < CacheSize; ++i) {
     //   cached_label_offsets_[i] = find_label_offset(i);
     // }
+    // labels without explicit transitions are resolved to a rho column
+    // (if any) in advance, so that Transition(...) doesn't need to
+    rho_offset_ = (numLabels && start_labels_.back() == rho_)
+      ? numLabels - 1
+      : numLabels;
+
     auto begin = start_labels_.begin();
     auto end = start_labels_.end();
     for (size_t i = 0, offset = 0;
@@ -136,7 +142,7 @@ class TableMatcher final : public MatcherBase<typename F::Arc> {
         ++offset;
         ++begin;
       } else {
-        cached_label_offsets_[i] = numLabels;
+        cached_label_offsets_[i] = rho_offset_;
       }
     }
   }
@@ -243,6 +249,36 @@ class TableMatcher final : public MatcherBase<typename F::Arc> {
     return inprops | (error_ ? kError : 0);
   }
 
+  // number of distinct labels, i.e. size of a transition table row
+  size_t NumLabels() const noexcept {
+    return start_labels_.size();
+  }
+
+  // returns a state reachable from a specified state 's' by a specified
+  // 'label' or kNoStateId if there is no such state, unlike a pair of
+  // SetState(...)/Find(...) it neither changes the matcher nor goes through
+  // a virtual call, i.e. it's a single table lookup for a cached 'label'
+  StateId Transition(StateId s, Label label) const noexcept {
+    assert(!error_);
+    const size_t numLabels = start_labels_.size();
+    size_t label_offset;
+
+    if (size_t(label) < IRESEARCH_COUNTOF(cached_label_offsets_)) {
+      label_offset = cached_label_offsets_[size_t(label)];
+    } else {
+      label_offset = find_label_offset(label);
+
+      if (label_offset == numLabels) {
+        label_offset = rho_offset_;
+      }
+    }
+
+    assert(s*numLabels < transitions_.size());
+    return label_offset < numLabels
+      ? transitions_[s*numLabels + label_offset]
+      : kNoStateId;
+  }
+
  private:
   template<typename Arc>
   static typename irs::irstd::adjust_const<Arc, typename Arc::Label>::reference& get_label(Arc& arc) {
@@ -266,6 +302,7 @@ class TableMatcher final : public MatcherBase<typename F::Arc> {
   std::vector<StateId> transitions_;
   Arc arc_;
   Label rho_;
+  size_t rho_offset_;                // offset of a rho column if any
   const FST* fst_;                   // FST for matching
   const Label* state_begin_{};       // Matcher state begin
   const Label* state_end_{};         // Matcher state end
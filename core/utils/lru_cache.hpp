@@ -0,0 +1,211 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_LRU_CACHE_H
+#define IRESEARCH_LRU_CACHE_H
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "shared.hpp"
+#include "thread_utils.hpp"
+#include "noncopyable.hpp"
+
+NS_ROOT
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class sharded_lru_cache
+/// @brief thread-safe cache bounded by a total charge of its entries,
+///        keys are distributed among independently locked shards each
+///        evicting its least recently used entries
+/// @note capacity is evenly split among shards
+////////////////////////////////////////////////////////////////////////////////
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+class sharded_lru_cache : private util::noncopyable {
+ public:
+  typedef Key key_type;
+  typedef Value value_type;
+
+  struct stats {
+    size_t capacity{}; // max total charge
+    size_t charge{}; // total charge of cached entries
+    size_t count{}; // number of cached entries
+    uint64_t hits{};
+    uint64_t misses{};
+  };
+
+  explicit sharded_lru_cache(size_t capacity = 0, size_t shards_count = 16)
+    : shards_(new shard[std::max(size_t(1), shards_count)]),
+      shards_count_(std::max(size_t(1), shards_count)) {
+    this->capacity(capacity);
+  }
+
+  size_t capacity() const noexcept {
+    return capacity_.load(std::memory_order_relaxed);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief sets max total charge of cached entries, evicts entries exceeding
+  ///        new capacity, 0 - disables the cache
+  //////////////////////////////////////////////////////////////////////////////
+  void capacity(size_t capacity) {
+    capacity_.store(capacity, std::memory_order_relaxed);
+
+    const auto shard_capacity = capacity / shards_count_;
+    for (auto* begin = shards_.get(), *end = begin + shards_count_; begin != end; ++begin) {
+      SCOPED_LOCK(begin->mutex);
+      begin->capacity = shard_capacity;
+      begin->evict();
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief find value associated with the specified 'key'
+  /// @returns true if entry was found
+  //////////////////////////////////////////////////////////////////////////////
+  bool get(const key_type& key, value_type& value) {
+    auto& shard = get_shard(key);
+    SCOPED_LOCK(shard.mutex);
+
+    const auto it = shard.map.find(key);
+
+    if (it == shard.map.end()) {
+      ++shard.misses;
+      return false;
+    }
+
+    // mark entry as the most recently used one
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    value = it->second->value;
+    ++shard.hits;
+
+    return true;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief associate 'value' with the specified 'key', existing entry is
+  ///        replaced, entries with charge exceeding capacity of a shard
+  ///        aren't cached
+  /// @returns true if entry was cached
+  //////////////////////////////////////////////////////////////////////////////
+  bool put(const key_type& key, value_type value, size_t charge) {
+    auto& shard = get_shard(key);
+    SCOPED_LOCK(shard.mutex);
+
+    if (charge > shard.capacity) {
+      return false;
+    }
+
+    auto it = shard.map.find(key);
+
+    if (it != shard.map.end()) {
+      shard.charge -= it->second->charge;
+      shard.lru.erase(it->second);
+      shard.map.erase(it);
+    }
+
+    shard.lru.push_front(entry{ key, std::move(value), charge });
+
+    try {
+      shard.map.emplace(key, shard.lru.begin());
+    } catch (...) {
+      shard.lru.pop_front();
+      throw;
+    }
+
+    shard.charge += charge;
+    shard.evict();
+
+    return true;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief remove all cached entries
+  //////////////////////////////////////////////////////////////////////////////
+  void clear() {
+    for (auto* begin = shards_.get(), *end = begin + shards_count_; begin != end; ++begin) {
+      SCOPED_LOCK(begin->mutex);
+      begin->map.clear();
+      begin->lru.clear();
+      begin->charge = 0;
+    }
+  }
+
+  stats get_stats() const {
+    stats stats;
+    stats.capacity = capacity();
+
+    for (auto* begin = shards_.get(), *end = begin + shards_count_; begin != end; ++begin) {
+      SCOPED_LOCK(begin->mutex);
+      stats.charge += begin->charge;
+      stats.count += begin->map.size();
+      stats.hits += begin->hits;
+      stats.misses += begin->misses;
+    }
+
+    return stats;
+  }
+
+ private:
+  struct entry {
+    key_type key;
+    value_type value;
+    size_t charge;
+  };
+
+  typedef std::list<entry> lru_t; // front - the most recently used entry
+
+  struct shard {
+    void evict() noexcept {
+      while (charge > capacity) {
+        assert(!lru.empty());
+        auto& last = lru.back();
+        charge -= last.charge;
+        map.erase(last.key);
+        lru.pop_back();
+      }
+    }
+
+    mutable std::mutex mutex;
+    lru_t lru;
+    std::unordered_map<key_type, typename lru_t::iterator, Hash> map;
+    size_t capacity{};
+    size_t charge{};
+    uint64_t hits{};
+    uint64_t misses{};
+  };
+
+  shard& get_shard(const key_type& key) const noexcept {
+    return shards_[Hash()(key) % shards_count_];
+  }
+
+  std::unique_ptr<shard[]> shards_;
+  const size_t shards_count_;
+  std::atomic<size_t> capacity_{};
+}; // sharded_lru_cache
+
+NS_END
+
+#endif // IRESEARCH_LRU_CACHE_H
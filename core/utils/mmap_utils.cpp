@@ -24,6 +24,7 @@
 #include "mmap_utils.hpp"
 #include "utils/log.hpp"
 
+#include <algorithm>
 #include <cassert>
 
 NS_ROOT
@@ -71,6 +72,27 @@ void mmap_handle::close() noexcept {
   }
 }
 
+bool mmap_handle::advise(size_t offset, size_t size, int advice) noexcept {
+  if (MAP_FAILED == addr_ || offset >= size_) {
+    return false;
+  }
+
+  static const size_t page_size = [](){
+#ifdef _MSC_VER
+    return size_t(4096);
+#else
+    const auto size = ::sysconf(_SC_PAGESIZE);
+    return size > 0 ? size_t(size) : size_t(4096);
+#endif
+  }();
+
+  // mmapped region starts at a page boundary
+  const size_t begin = offset - offset % page_size;
+  const size_t end = (std::min)(size_, offset + size);
+
+  return 0 == ::madvise(static_cast<char*>(addr_) + begin, end - begin, advice);
+}
+
 void mmap_handle::init() noexcept {
   fd_ = -1;
   addr_ = MAP_FAILED;
@@ -121,6 +121,12 @@ class IRESEARCH_API mmap_handle : private util::noncopyable {
     return 0 == ::madvise(addr_, size_, advice);
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief gives advice about the specified range of the mapped region,
+  ///        the range is extended to page boundaries
+  //////////////////////////////////////////////////////////////////////////////
+  bool advise(size_t offset, size_t size, int advice) noexcept;
+
   void dontneed(bool value) noexcept {
     dontneed_ = value;
   }
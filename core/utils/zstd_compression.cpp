@@ -0,0 +1,223 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "shared.hpp"
+#include "zstd_compression.hpp"
+#include "error/error.hpp"
+#include "store/store_utils.hpp"
+#include "utils/string_utils.hpp"
+#include "utils/misc.hpp"
+
+#include <zstd.h>
+#include <zdict.h>
+
+#include <vector>
+
+NS_LOCAL
+
+// data used for training is split into samples of this size
+constexpr size_t DICT_SAMPLE_SIZE = 256;
+
+// do not train a dictionary on less than that number of samples
+constexpr size_t DICT_MIN_SAMPLES = 16;
+
+// upper limit for a size of a trained dictionary
+constexpr size_t DICT_MAX_SIZE = 16384;
+
+inline int level(const irs::compression::options::Hint hint) noexcept {
+  static const int LEVELS[] { ZSTD_CLEVEL_DEFAULT, 1, 9 };
+  assert(static_cast<size_t>(hint) < IRESEARCH_COUNTOF(LEVELS));
+
+  return LEVELS[static_cast<size_t>(hint)];
+}
+
+struct ZSTD_DCtx_deleter {
+  void operator()(ZSTD_DCtx* p) noexcept {
+    ZSTD_freeDCtx(p);
+  }
+};
+
+// decompressors are shared between readers of a column,
+// so reuse a decompression context per thread instead
+ZSTD_DCtx* decompression_context() {
+  thread_local std::unique_ptr<ZSTD_DCtx, ZSTD_DCtx_deleter> ctx(ZSTD_createDCtx());
+
+  return ctx.get();
+}
+
+NS_END
+
+NS_ROOT
+NS_BEGIN(compression)
+
+void ZSTD_CCtx_deleter::operator()(ZSTD_CCtx_s* p) noexcept {
+  ZSTD_freeCCtx(p);
+}
+
+void ZSTD_CDict_deleter::operator()(ZSTD_CDict_s* p) noexcept {
+  ZSTD_freeCDict(p);
+}
+
+void ZSTD_DDict_deleter::operator()(ZSTD_DDict_s* p) noexcept {
+  ZSTD_freeDDict(p);
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  zstd compression
+// -----------------------------------------------------------------------------
+
+zstd::zstd_compressor::zstd_compressor(int level, bool train_dictionary)
+  : ctx_(ZSTD_createCCtx()),
+    level_(level),
+    train_(train_dictionary) {
+  if (!ctx_) {
+    throw std::bad_alloc();
+  }
+}
+
+void zstd::zstd_compressor::train(const byte_type* src, size_t size) {
+  const size_t samples_count = size / DICT_SAMPLE_SIZE;
+
+  if (samples_count < DICT_MIN_SAMPLES) {
+    // not enough data to train a meaningful dictionary
+    return;
+  }
+
+  const std::vector<size_t> samples(samples_count, DICT_SAMPLE_SIZE);
+
+  dict_.resize(std::min(DICT_MAX_SIZE, size / 8));
+
+  const auto dict_size = ZDICT_trainFromBuffer(
+    &dict_[0], dict_.size(),
+    src, samples.data(), unsigned(samples.size()));
+
+  if (ZDICT_isError(dict_size)) {
+    // data can't be trained on, e.g. it's too small or too random,
+    // fallback to plain compression
+    dict_.clear();
+    return;
+  }
+
+  dict_.resize(dict_size);
+  cdict_.reset(ZSTD_createCDict(dict_.c_str(), dict_.size(), level_));
+
+  if (!cdict_) {
+    dict_.clear();
+  }
+}
+
+bytes_ref zstd::zstd_compressor::compress(byte_type* src, size_t size, bstring& out) {
+  if (train_) {
+    // train dictionary on the first block
+    train_ = false;
+    train(src, size);
+  }
+
+  // ensure we have enough space to store compressed data
+  string_utils::oversize(out, ZSTD_compressBound(size));
+
+  const auto zstd_size = cdict_
+    ? ZSTD_compress_usingCDict(ctx_.get(), &out[0], out.size(), src, size, cdict_.get())
+    : ZSTD_compressCCtx(ctx_.get(), &out[0], out.size(), src, size, level_);
+
+  if (IRS_UNLIKELY(ZSTD_isError(zstd_size))) {
+    throw index_error(string_utils::to_string(
+      "while compressing, error: %s", ZSTD_getErrorName(zstd_size)));
+  }
+
+  return bytes_ref(out.c_str(), zstd_size);
+}
+
+void zstd::zstd_compressor::flush(data_output& out) {
+  write_string(out, dict_);
+}
+
+bytes_ref zstd::zstd_decompressor::decompress(
+    const byte_type* src, size_t src_size,
+    byte_type* dst, size_t dst_size) {
+  auto* ctx = decompression_context();
+
+  if (IRS_UNLIKELY(!ctx)) {
+    return bytes_ref::NIL;
+  }
+
+  const auto zstd_size = ddict_
+    ? ZSTD_decompress_usingDDict(ctx, dst, dst_size, src, src_size, ddict_.get())
+    : ZSTD_decompressDCtx(ctx, dst, dst_size, src, src_size);
+
+  if (IRS_UNLIKELY(ZSTD_isError(zstd_size))) {
+    return bytes_ref::NIL; // corrupted index
+  }
+
+  return bytes_ref(dst, zstd_size);
+}
+
+bool zstd::zstd_decompressor::prepare(data_input& in) {
+  const auto dict = read_string<bstring>(in);
+
+  if (dict.empty()) {
+    ddict_.reset();
+    return true;
+  }
+
+  ddict_.reset(ZSTD_createDDict(dict.c_str(), dict.size()));
+
+  return nullptr != ddict_;
+}
+
+compressor::ptr zstd::compressor(const options& opts) {
+  return memory::make_shared<zstd_compressor>(::level(opts.hint));
+}
+
+decompressor::ptr zstd::decompressor() {
+  // decompressor holds a dictionary of a particular column
+  return memory::make_shared<zstd_decompressor>();
+}
+
+void zstd::init() {
+  // match registration below
+  REGISTER_COMPRESSION(zstd, &zstd::compressor, &zstd::decompressor);
+}
+
+REGISTER_COMPRESSION(zstd, &zstd::compressor, &zstd::decompressor);
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                       zstd compression with dict
+// -----------------------------------------------------------------------------
+
+compressor::ptr zstd_dict::compressor(const options& opts) {
+  return memory::make_shared<zstd::zstd_compressor>(::level(opts.hint), true);
+}
+
+decompressor::ptr zstd_dict::decompressor() {
+  return zstd::decompressor();
+}
+
+void zstd_dict::init() {
+  // match registration below
+  REGISTER_COMPRESSION(zstd_dict, &zstd_dict::compressor, &zstd_dict::decompressor);
+}
+
+REGISTER_COMPRESSION(zstd_dict, &zstd_dict::compressor, &zstd_dict::decompressor);
+
+NS_END // compression
+NS_END
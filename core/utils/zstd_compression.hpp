@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_ZSTD_COMPRESSION_H
+#define IRESEARCH_ZSTD_COMPRESSION_H
+
+#include "string.hpp"
+#include "compression.hpp"
+#include "noncopyable.hpp"
+
+#include <memory>
+
+struct ZSTD_CCtx_s;
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
+NS_ROOT
+NS_BEGIN(compression)
+
+struct ZSTD_CCtx_deleter {
+  void operator()(ZSTD_CCtx_s* p) noexcept;
+};
+
+struct ZSTD_CDict_deleter {
+  void operator()(ZSTD_CDict_s* p) noexcept;
+};
+
+struct ZSTD_DDict_deleter {
+  void operator()(ZSTD_DDict_s* p) noexcept;
+};
+
+typedef std::unique_ptr<ZSTD_CCtx_s, ZSTD_CCtx_deleter> zstd_cctx;
+typedef std::unique_ptr<ZSTD_CDict_s, ZSTD_CDict_deleter> zstd_cdict;
+typedef std::unique_ptr<ZSTD_DDict_s, ZSTD_DDict_deleter> zstd_ddict;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @struct zstd
+/// @brief zstd compression, every column gets its own compressor instance
+////////////////////////////////////////////////////////////////////////////////
+struct IRESEARCH_API zstd {
+  static constexpr string_ref type_name() noexcept {
+    return "iresearch::compression::zstd";
+  }
+
+  class IRESEARCH_API zstd_compressor final
+      : public compression::compressor,
+        private util::noncopyable {
+   public:
+    ////////////////////////////////////////////////////////////////////////////
+    /// @param level zstd compression level
+    /// @param train_dictionary train a dictionary on the first block
+    ///        and use it for compressing all blocks of a column
+    ////////////////////////////////////////////////////////////////////////////
+    explicit zstd_compressor(int level, bool train_dictionary = false);
+
+    int level() const noexcept { return level_; }
+    const bstring& dictionary() const noexcept { return dict_; }
+
+    virtual bytes_ref compress(byte_type* src, size_t size, bstring& out) override;
+
+    /// @brief writes trained dictionary (if any)
+    virtual void flush(data_output& out) override;
+
+   private:
+    void train(const byte_type* src, size_t size);
+
+    zstd_cctx ctx_;
+    zstd_cdict cdict_;
+    bstring dict_;
+    const int level_;
+    bool train_;
+  };
+
+  class IRESEARCH_API zstd_decompressor final
+      : public compression::decompressor,
+        private util::noncopyable {
+   public:
+    /// @returns bytes_ref::NIL in case of error
+    virtual bytes_ref decompress(const byte_type* src, size_t src_size,
+                                 byte_type* dst, size_t dst_size) override;
+
+    /// @brief reads dictionary (if any) written by 'zstd_compressor::flush'
+    virtual bool prepare(data_input& in) override;
+
+   private:
+    zstd_ddict ddict_;
+  };
+
+  static void init();
+  static compression::compressor::ptr compressor(const options& opts);
+  static compression::decompressor::ptr decompressor();
+}; // zstd
+
+////////////////////////////////////////////////////////////////////////////////
+/// @struct zstd_dict
+/// @brief zstd compression with a per-column dictionary trained on the first
+///        data block of a column and stored in the column header, suitable
+///        for columns with many small similar values, e.g. JSON documents
+/// @note works best in conjunction with a larger 'column_info::block_size()'
+////////////////////////////////////////////////////////////////////////////////
+struct IRESEARCH_API zstd_dict {
+  static constexpr string_ref type_name() noexcept {
+    return "iresearch::compression::zstd_dict";
+  }
+
+  static void init();
+  static compression::compressor::ptr compressor(const options& opts);
+  static compression::decompressor::ptr decompressor();
+}; // zstd_dict
+
+NS_END // compression
+NS_END // NS_ROOT
+
+#endif // IRESEARCH_ZSTD_COMPRESSION_H
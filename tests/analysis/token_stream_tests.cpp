@@ -135,6 +135,113 @@ TEST( string_token_stream_tests, next_end) {
   ASSERT_FALSE(ts.next());
 }
 
+TEST(suffix_token_stream_tests, next_end) {
+  suffix_token_stream stream;
+  auto* inc = irs::get<increment>(stream);
+  ASSERT_FALSE(!inc);
+  auto* term = irs::get<term_attribute>(stream);
+  ASSERT_FALSE(!term);
+
+  // empty stream
+  ASSERT_FALSE(stream.next());
+
+  // ASCII value
+  {
+    stream.reset(irs::string_ref("a.log"));
+
+    for (auto& expected : { "a.log", ".log", "log", "og", "g" }) {
+      ASSERT_TRUE(stream.next());
+      ASSERT_EQ(irs::ref_cast<irs::byte_type>(irs::string_ref(expected)), term->value);
+      ASSERT_EQ(irs::string_ref("a.log") == expected ? 1 : 0, inc->value);
+    }
+    ASSERT_FALSE(stream.next());
+  }
+
+  // UTF-8 value, suffixes start at code point boundaries
+  {
+    stream.reset(irs::string_ref("\xD0\xBF\xD1\x80\xD0\xB8"));
+
+    for (auto& expected : { "\xD0\xBF\xD1\x80\xD0\xB8", "\xD1\x80\xD0\xB8", "\xD0\xB8" }) {
+      ASSERT_TRUE(stream.next());
+      ASSERT_EQ(irs::ref_cast<irs::byte_type>(irs::string_ref(expected)), term->value);
+    }
+    ASSERT_FALSE(stream.next());
+  }
+
+  // empty value
+  stream.reset(irs::string_ref::EMPTY);
+  ASSERT_FALSE(stream.next());
+}
+
+TEST(shingle_token_stream_tests, next_end) {
+  // emits specified terms with specified position increments
+  class tokens_stream final : public basic_token_stream {
+   public:
+    explicit tokens_stream(std::vector<std::pair<irs::string_ref, uint32_t>>&& tokens)
+      : tokens_(std::move(tokens)) {
+    }
+
+    virtual bool next() override {
+      if (next_ == tokens_.size()) {
+        return false;
+      }
+
+      term_.value = irs::ref_cast<irs::byte_type>(tokens_[next_].first);
+      inc_.value = tokens_[next_].second;
+      ++next_;
+      return true;
+    }
+
+   private:
+    std::vector<std::pair<irs::string_ref, uint32_t>> tokens_;
+    size_t next_{};
+  };
+
+  shingle_token_stream stream;
+  auto* inc = irs::get<increment>(stream);
+  ASSERT_FALSE(!inc);
+  auto* term = irs::get<term_attribute>(stream);
+  ASSERT_FALSE(!term);
+
+  // not initialized stream
+  ASSERT_FALSE(stream.next());
+
+  // there is a gap between 'fox' and 'jumps'
+  {
+    tokens_stream tokens({ {"quick", 1}, {"brown", 1}, {"fox", 1}, {"jumps", 2}, {"over", 1} });
+    ASSERT_TRUE(stream.reset(tokens));
+
+    const std::pair<irs::bstring, uint32_t> expected[] {
+      { shingle_token_stream::shingle(irs::ref_cast<irs::byte_type>(irs::string_ref("quick")),
+                                      irs::ref_cast<irs::byte_type>(irs::string_ref("brown"))), 1 },
+      { shingle_token_stream::shingle(irs::ref_cast<irs::byte_type>(irs::string_ref("brown")),
+                                      irs::ref_cast<irs::byte_type>(irs::string_ref("fox"))), 1 },
+      { shingle_token_stream::shingle(irs::ref_cast<irs::byte_type>(irs::string_ref("jumps")),
+                                      irs::ref_cast<irs::byte_type>(irs::string_ref("over"))), 3 },
+    };
+
+    for (auto& shingle : expected) {
+      ASSERT_TRUE(stream.next());
+      ASSERT_EQ(shingle.first, term->value);
+      ASSERT_EQ(shingle.second, inc->value);
+    }
+    ASSERT_FALSE(stream.next());
+    ASSERT_FALSE(stream.next());
+  }
+
+  // shingle is composed of terms joined by a separator
+  ASSERT_EQ(irs::bstring(irs::ref_cast<irs::byte_type>(irs::string_ref("a\xFF" "b"))),
+            shingle_token_stream::shingle(irs::ref_cast<irs::byte_type>(irs::string_ref("a")),
+                                          irs::ref_cast<irs::byte_type>(irs::string_ref("b"))));
+
+  // single token
+  {
+    tokens_stream tokens({ {"fox", 1} });
+    ASSERT_TRUE(stream.reset(tokens));
+    ASSERT_FALSE(stream.next());
+  }
+}
+
 TEST(numeric_token_stream_tests, value) {
   // int
   {
@@ -479,6 +479,43 @@ TEST_P(format_11_test_case, formats_10_11) {
   }
 }
 
+TEST_P(format_11_test_case, term_index_version) {
+  tests::json_doc_generator gen(
+    resource("simple_sequential.json"),
+    &tests::generic_json_field_factory);
+  tests::document const* doc = gen.next();
+
+  // formats prior to 1_4 keep writing term index of version 1
+  // in order to remain readable by previous releases, version 2
+  // (each term index is prefixed with its size) is written by 1_4
+  for (auto& entry : { std::make_pair("1_1", 1), std::make_pair("1_2", 1),
+                       std::make_pair("1_3", 1), std::make_pair("1_4", 2) }) {
+    SCOPED_TRACE(entry.first);
+    auto codec = irs::formats::get(entry.first, "1_0");
+    ASSERT_NE(nullptr, codec);
+
+    {
+      auto writer = irs::index_writer::make(dir(), codec, irs::OM_CREATE);
+      ASSERT_NE(nullptr, writer);
+
+      ASSERT_TRUE(insert(*writer,
+        doc->indexed.begin(), doc->indexed.end(),
+        doc->stored.begin(), doc->stored.end()));
+
+      writer->commit();
+    }
+
+    ASSERT_EQ(entry.second, tests::header_version(dir(), "ti"));
+
+    // segment is readable
+    auto reader = irs::directory_reader::open(dir());
+    ASSERT_EQ(1, reader.size());
+    auto* field = reader[0].field("same");
+    ASSERT_NE(nullptr, field);
+    ASSERT_TRUE(field->iterator()->next());
+  }
+}
+
 INSTANTIATE_TEST_CASE_P(
   format_11_test,
   format_11_test_case,
@@ -477,6 +477,46 @@ TEST_P(format_12_test_case, formats_10_12) {
   }
 }
 
+TEST_P(format_12_test_case, columnstore_version) {
+  tests::json_doc_generator gen(
+    resource("simple_sequential.json"),
+    &tests::generic_json_field_factory);
+  tests::document const* doc = gen.next();
+
+  // formats prior to 1_4 keep writing columnstore of version 1
+  // in order to remain readable by previous releases, version 2
+  // (min/max values per block) is written by 1_4
+  for (auto& entry : { std::make_pair("1_2", 1), std::make_pair("1_3", 1),
+                       std::make_pair("1_4", 2) }) {
+    SCOPED_TRACE(entry.first);
+    auto codec = irs::formats::get(entry.first, "1_0");
+    ASSERT_NE(nullptr, codec);
+
+    {
+      auto writer = irs::index_writer::make(dir(), codec, irs::OM_CREATE);
+      ASSERT_NE(nullptr, writer);
+
+      ASSERT_TRUE(insert(*writer,
+        doc->indexed.begin(), doc->indexed.end(),
+        doc->stored.begin(), doc->stored.end()));
+
+      writer->commit();
+    }
+
+    ASSERT_EQ(entry.second, tests::header_version(dir(), "cs"));
+
+    // segment is readable
+    auto reader = irs::directory_reader::open(dir());
+    ASSERT_EQ(1, reader.size());
+    auto* column = reader[0].column_reader("name");
+    ASSERT_NE(nullptr, column);
+    auto values = column->values();
+    irs::bytes_ref actual_value;
+    ASSERT_TRUE(values(irs::doc_limits::min(), actual_value));
+    ASSERT_EQ("A", irs::to_string<irs::string_ref>(actual_value.c_str()));
+  }
+}
+
 INSTANTIATE_TEST_CASE_P(
   format_12_test,
   format_12_test_case,
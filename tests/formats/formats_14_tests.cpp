@@ -0,0 +1,330 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "formats_test_case_base.hpp"
+#include "analysis/delimited_token_stream.hpp"
+#include "store/directory_attributes.hpp"
+#include "search/bm25.hpp"
+#include "search/boolean_filter.hpp"
+#include "search/score.hpp"
+#include "search/term_filter.hpp"
+
+NS_LOCAL
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                          format 14 specific tests
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class delimited_field
+/// @brief space separated terms with frequencies
+////////////////////////////////////////////////////////////////////////////////
+class delimited_field : public tests::field_base {
+ public:
+  delimited_field(const irs::string_ref& name, std::string&& value)
+    : stream_(irs::analysis::delimited_token_stream::make(" ")),
+      value_(std::move(value)) {
+    this->name(name);
+    this->features() = irs::flags{ irs::type<irs::frequency>::get() };
+  }
+
+  virtual irs::token_stream& get_tokens() const override {
+    stream_->reset(value_);
+    return *stream_;
+  }
+
+  virtual bool write(irs::data_output&) const override {
+    return false;
+  }
+
+ private:
+  irs::analysis::analyzer::ptr stream_;
+  std::string value_;
+}; // delimited_field
+
+// frequency of the term 'a' in the specified document
+uint32_t freq_a(size_t i) {
+  return 1 + (i / 128) % 5 + (0 == i % 97 ? 20 : 0);
+}
+
+// frequency of the term 'b' in the specified document, 0 if absent
+uint32_t freq_b(size_t i) {
+  return 0 == i % 3 ? 1 + i % 11 : 0;
+}
+
+// frequency of the term 'c' in the specified document, 0 if absent
+uint32_t freq_c(size_t i) {
+  return 0 == i % 5 ? 1 + (i * 7) % 13 : 0;
+}
+
+class format_14_test_case : public tests::directory_test_case_base {
+ protected:
+  void write_segment(const irs::string_ref& format, size_t docs_count) {
+    auto codec = irs::formats::get(format, "1_0");
+    ASSERT_NE(nullptr, codec);
+    auto writer = irs::index_writer::make(dir(), codec, irs::OM_CREATE);
+    ASSERT_NE(nullptr, writer);
+
+    for (size_t i = 0; i < docs_count; ++i) {
+      std::string value;
+      for (auto freq = freq_a(i); freq; --freq) {
+        value += "a ";
+      }
+      for (auto freq = freq_b(i); freq; --freq) {
+        value += "b ";
+      }
+      for (auto freq = freq_c(i); freq; --freq) {
+        value += "c ";
+      }
+      value.pop_back();
+
+      tests::document doc;
+      doc.insert(std::make_shared<delimited_field>("body", std::move(value)));
+
+      ASSERT_TRUE(tests::insert(*writer, doc.indexed.begin(), doc.indexed.end()));
+    }
+
+    writer->commit();
+  }
+};
+
+TEST_P(format_14_test_case, postings_block_max) {
+  constexpr size_t DOCS_COUNT = 1500;
+
+  write_segment("1_4", DOCS_COUNT);
+
+  auto reader = irs::directory_reader::open(dir());
+  ASSERT_EQ(1, reader.size());
+  auto& segment = reader[0];
+  ASSERT_EQ(DOCS_COUNT, segment.docs_count());
+  auto* field = segment.field("body");
+  ASSERT_NE(nullptr, field);
+
+  const irs::flags features{ irs::type<irs::frequency>::get() };
+
+  for (auto& term : { std::make_pair("a", &freq_a), std::make_pair("b", &freq_b) }) {
+    SCOPED_TRACE(term.first);
+    auto terms = field->iterator();
+    ASSERT_TRUE(terms->seek(irs::ref_cast<irs::byte_type>(irs::string_ref(term.first))));
+
+    // expected frequencies
+    std::vector<std::pair<irs::doc_id_t, uint32_t>> expected;
+    uint32_t expected_max = 0;
+    for (size_t i = 0; i < DOCS_COUNT; ++i) {
+      const auto freq = term.second(i);
+      if (freq) {
+        expected.emplace_back(irs::doc_id_t(irs::doc_limits::min() + i), freq);
+        expected_max = std::max(expected_max, freq);
+      }
+    }
+
+    // iterate over postings
+    {
+      auto docs = terms->postings(features);
+      auto* freq = irs::get<irs::frequency>(*docs);
+      ASSERT_NE(nullptr, freq);
+      auto* bound = irs::get<irs::frequency_bound>(*docs);
+      ASSERT_NE(nullptr, bound);
+      ASSERT_EQ(expected_max, bound->max());
+
+      for (auto& entry : expected) {
+        ASSERT_TRUE(docs->next());
+        ASSERT_EQ(entry.first, docs->value());
+        ASSERT_EQ(entry.second, freq->value);
+      }
+      ASSERT_FALSE(docs->next());
+    }
+
+    // shallow seek over the blocks
+    {
+      auto docs = terms->postings(features);
+      auto* bound = irs::get_mutable<irs::frequency_bound>(docs.get());
+      ASSERT_NE(nullptr, bound);
+      ASSERT_EQ(expected_max, bound->value());
+
+      size_t blocks = 0;
+      uint32_t block_max = 0;
+      irs::doc_id_t end = irs::doc_limits::invalid();
+
+      for (auto& entry : expected) {
+        if (entry.first > end) {
+          if (blocks) {
+            ASSERT_EQ(block_max, bound->value());
+          }
+
+          end = bound->shallow_seek(entry.first);
+          ASSERT_LE(entry.first, end);
+          block_max = 0;
+          ++blocks;
+        }
+
+        block_max = std::max(block_max, entry.second);
+        ASSERT_LE(entry.second, bound->value());
+      }
+
+      ASSERT_TRUE(irs::doc_limits::eof(end)); // trailing block
+      ASSERT_LE(block_max, bound->value());
+      ASSERT_LT(1, blocks);
+
+      // shallow seek doesn't move iterator
+      ASSERT_FALSE(irs::doc_limits::valid(docs->value()));
+      ASSERT_TRUE(docs->next());
+      ASSERT_EQ(expected.front().first, docs->value());
+    }
+  }
+}
+
+TEST_P(format_14_test_case, postings_no_block_max) {
+  write_segment("1_3", 300);
+
+  auto reader = irs::directory_reader::open(dir());
+  ASSERT_EQ(1, reader.size());
+  auto* field = reader[0].field("body");
+  ASSERT_NE(nullptr, field);
+  auto terms = field->iterator();
+  ASSERT_TRUE(terms->seek(irs::ref_cast<irs::byte_type>(irs::string_ref("a"))));
+
+  // previous format doesn't store block max
+  auto docs = terms->postings(irs::flags{ irs::type<irs::frequency>::get() });
+  ASSERT_NE(nullptr, irs::get<irs::frequency>(*docs));
+  ASSERT_EQ(nullptr, irs::get<irs::frequency_bound>(*docs));
+  ASSERT_EQ(nullptr, irs::get<irs::score_upper_bound>(*docs));
+}
+
+TEST_P(format_14_test_case, top_k_pruning) {
+  constexpr size_t DOCS_COUNT = 3000;
+  constexpr size_t TOP_K = 10;
+
+  write_segment("1_4", DOCS_COUNT);
+
+  auto reader = irs::directory_reader::open(dir());
+  ASSERT_EQ(1, reader.size());
+  auto& segment = reader[0];
+
+  irs::order order;
+  order.add<irs::bm25_sort>(true);
+  auto prepared_order = order.prepare();
+
+  irs::Or filter;
+  for (auto* term : { "a", "b", "c" }) {
+    auto& sub = filter.add<irs::by_term>();
+    *sub.mutable_field() = "body";
+    sub.mutable_options()->term = irs::ref_cast<irs::byte_type>(irs::string_ref(term));
+  }
+
+  auto prepared = filter.prepare(reader, prepared_order);
+  ASSERT_NE(nullptr, prepared);
+
+  // exhaustive evaluation
+  std::vector<float_t> expected;
+  {
+    auto docs = prepared->execute(segment, prepared_order);
+    auto* score = irs::get<irs::score>(*docs);
+    ASSERT_NE(nullptr, score);
+
+    while (docs->next()) {
+      expected.emplace_back(*reinterpret_cast<const float_t*>(score->evaluate()));
+    }
+
+    ASSERT_EQ(DOCS_COUNT, expected.size());
+    std::sort(expected.begin(), expected.end(), std::greater<>());
+    expected.resize(TOP_K);
+  }
+
+  // evaluation with threshold
+  std::vector<float_t> actual;
+  {
+    auto docs = prepared->execute(segment, prepared_order);
+    auto* score = irs::get<irs::score>(*docs);
+    ASSERT_NE(nullptr, score);
+    auto* threshold = irs::get_mutable<irs::score_threshold>(docs.get());
+    ASSERT_NE(nullptr, threshold);
+
+    size_t count = 0;
+    while (docs->next()) {
+      ++count;
+      const auto value = *reinterpret_cast<const float_t*>(score->evaluate());
+
+      if (actual.size() < TOP_K) {
+        actual.emplace_back(value);
+        std::push_heap(actual.begin(), actual.end(), std::greater<>());
+      } else if (actual.front() < value) {
+        std::pop_heap(actual.begin(), actual.end(), std::greater<>());
+        actual.back() = value;
+        std::push_heap(actual.begin(), actual.end(), std::greater<>());
+      } else {
+        continue;
+      }
+
+      if (actual.size() == TOP_K) {
+        threshold->value.assign(
+          reinterpret_cast<const irs::byte_type*>(&actual.front()),
+          sizeof(float_t));
+      }
+    }
+
+    ASSERT_LT(count, DOCS_COUNT); // some documents were skipped
+    std::sort(actual.begin(), actual.end(), std::greater<>());
+  }
+
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    ASSERT_FLOAT_EQ(expected[i], actual[i]);
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(
+  format_14_test,
+  format_14_test_case,
+  ::testing::Values(
+    &tests::rot13_cipher_directory<&tests::memory_directory, 16>,
+    &tests::rot13_cipher_directory<&tests::fs_directory, 16>,
+    &tests::rot13_cipher_directory<&tests::mmap_directory, 16>
+  ),
+  tests::directory_test_case_base::to_string
+);
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                     generic tests
+// -----------------------------------------------------------------------------
+
+using tests::format_test_case;
+
+INSTANTIATE_TEST_CASE_P(
+  format_14_test,
+  format_test_case,
+  ::testing::Combine(
+    ::testing::Values(
+      &tests::rot13_cipher_directory<&tests::memory_directory, 16>,
+      &tests::rot13_cipher_directory<&tests::fs_directory, 16>,
+      &tests::rot13_cipher_directory<&tests::mmap_directory, 16>,
+      &tests::rot13_cipher_directory<&tests::memory_directory, 7>,
+      &tests::rot13_cipher_directory<&tests::fs_directory, 7>,
+      &tests::rot13_cipher_directory<&tests::mmap_directory, 7>
+    ),
+    ::testing::Values(tests::format_info{"1_4", "1_0"})
+  ),
+  tests::to_string
+);
+
+NS_END
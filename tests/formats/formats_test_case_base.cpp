@@ -22,10 +22,27 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "formats_test_case_base.hpp"
+#include "index/file_names.hpp"
+#include "store/store_utils.hpp"
 #include "utils/lz4compression.hpp"
 
 namespace tests {
 
+int32_t header_version(const irs::directory& dir, const irs::string_ref& ext) {
+  auto reader = irs::directory_reader::open(dir);
+  auto& segment = reader.meta().meta.segment(0).meta;
+  auto in = dir.open(irs::file_name(segment.name, ext), irs::IOAdvice::NORMAL);
+
+  if (!in) {
+    return -1;
+  }
+
+  // see format_utils::write_header(...)
+  in->read_int(); // magic
+  irs::read_string<std::string>(*in); // format name
+  return in->read_int();
+}
+
 TEST_P(format_test_case, directory_artifact_cleaner) {
   tests::json_doc_generator gen(
     resource("simple_sequential.json"),
@@ -456,6 +473,90 @@ TEST_P(format_test_case, fields_seek_ge) {
   }
 }
 
+TEST_P(format_test_case, fields_read_concurrently) {
+  tests::json_doc_generator gen(
+    resource("simple_sequential.json"),
+    &tests::generic_json_field_factory);
+  add_segment(gen);
+
+  // collect expected terms of each field
+  std::map<std::string, std::vector<irs::bstring>> expected;
+
+  {
+    auto reader = open_reader();
+    ASSERT_EQ(1, reader->size());
+    auto fields = reader[0].fields();
+
+    while (fields->next()) {
+      auto& terms = expected[fields->value().meta().name];
+      auto it = fields->value().iterator();
+
+      while (it->next()) {
+        terms.emplace_back(it->value());
+      }
+    }
+  }
+  ASSERT_FALSE(expected.empty());
+
+  // term indices of a freshly opened reader are accessed concurrently
+  auto reader = open_reader();
+  auto& segment = reader[0];
+
+  std::mutex mutex;
+  bool ready = false;
+  std::condition_variable ready_cv;
+
+  auto read_fields = [&]() {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      while (!ready) {
+        ready_cv.wait(lock);
+      }
+    }
+
+    for (auto& entry : expected) {
+      auto* field = segment.field(entry.first);
+
+      if (!field) {
+        return false;
+      }
+
+      auto it = field->iterator();
+
+      for (auto& term : entry.second) {
+        if (!it->seek(term) || term != it->value()) {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  };
+
+  constexpr size_t THREAD_COUNT = 8;
+  std::vector<int> results(THREAD_COUNT, 0);
+  std::vector<std::thread> pool;
+
+  for (size_t i = 0; i < THREAD_COUNT; ++i) {
+    pool.emplace_back([&read_fields, &result = results[i]]() {
+      result = static_cast<int>(read_fields());
+    });
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    ready = true;
+    ready_cv.notify_all();
+  }
+
+  for (auto& thread : pool) {
+    thread.join();
+  }
+
+  ASSERT_TRUE(std::all_of(
+    results.begin(), results.end(), [](int res) { return 1 == res; }));
+}
+
 TEST_P(format_test_case, fields_read_write) {
   /*
     Term dictionary structure:
@@ -3174,7 +3275,7 @@ TEST_P(format_test_case, document_mask_rw) {
   {
     auto writer = codec()->get_document_mask_writer();
 
-    writer->write(dir(), meta, mask_set);
+    writer->write(dir(), meta, irs::document_mask(mask_set.begin(), mask_set.end()));
   }
 
   // read document_mask
@@ -3189,4 +3290,31 @@ TEST_P(format_test_case, document_mask_rw) {
   }
 }
 
+TEST_P(format_test_case, document_mask_rw_dense) {
+  irs::document_mask mask;
+  for (irs::doc_id_t doc = irs::doc_limits::min(); doc < 10000; ++doc) {
+    if (doc % 3 || 0 == doc % 1000) {
+      mask.insert(doc);
+    }
+  }
+  irs::segment_meta meta("_1", nullptr);
+  meta.version = 42;
+
+  // write document_mask
+  {
+    auto writer = codec()->get_document_mask_writer();
+
+    writer->write(dir(), meta, mask);
+  }
+
+  // read document_mask
+  {
+    auto reader = codec()->get_document_mask_reader();
+    irs::document_mask actual;
+    EXPECT_TRUE(reader->read(dir(), meta, actual));
+    ASSERT_EQ(mask.size(), actual.size());
+    ASSERT_TRUE(std::equal(mask.begin(), mask.end(), actual.begin()));
+  }
+}
+
 }
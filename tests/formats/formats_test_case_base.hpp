@@ -256,6 +256,12 @@ class format_test_case : public index_test_base {
   }
 }; // format_test_case
 
+////////////////////////////////////////////////////////////////////////////////
+/// @returns format version recorded in the header of the specified file
+///          of the first segment of an index stored in 'dir'
+////////////////////////////////////////////////////////////////////////////////
+int32_t header_version(const irs::directory& dir, const irs::string_ref& ext);
+
 } // tests
 
 NS_ROOT
@@ -262,7 +262,7 @@ void document_mask_writer::write(
 ) {
   EXPECT_EQ(data_.doc_mask().size(), docs_mask.size());
   for (auto doc_id : docs_mask) {
-    EXPECT_EQ(true, data_.doc_mask().find(doc_id) != data_.doc_mask().end());
+    EXPECT_TRUE(data_.doc_mask().contains(doc_id));
   }
 }
 
@@ -552,7 +552,7 @@ irs::seek_term_iterator::ptr term_reader::iterator() const {
   return irs::memory::make_managed<term_iterator>(data_);
 }
 
-irs::seek_term_iterator::ptr term_reader::iterator(irs::automaton_table_matcher& matcher) const {
+irs::seek_term_iterator::ptr term_reader::iterator(const irs::automaton_table_matcher& matcher) const {
   return irs::memory::make_managed<irs::automaton_term_iterator>(matcher.GetFst(), iterator());
 }
 
@@ -245,7 +245,7 @@ class term_reader : public irs::term_reader {
   }
 
   virtual irs::seek_term_iterator::ptr iterator() const override;
-  virtual irs::seek_term_iterator::ptr iterator(irs::automaton_table_matcher& a) const override;
+  virtual irs::seek_term_iterator::ptr iterator(const irs::automaton_table_matcher& a) const override;
   virtual const irs::field_meta& meta() const override { return data_; }
   virtual size_t size() const override { return data_.terms.size(); }
   virtual uint64_t docs_count() const override { return data_.docs.size(); }
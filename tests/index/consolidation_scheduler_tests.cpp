@@ -0,0 +1,179 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "index/doc_generator.hpp"
+#include "index/consolidation_scheduler.hpp"
+#include "index/index_tests.hpp"
+#include "store/memory_directory.hpp"
+#include "utils/index_utils.hpp"
+
+#include <thread>
+
+NS_LOCAL
+
+class consolidation_scheduler_test : public test_base {
+ protected:
+  irs::index_writer::ptr populate(size_t segments) {
+    tests::json_doc_generator gen(
+      resource("simple_sequential.json"),
+      [] (tests::document& doc, const std::string& name, const tests::json_doc_generator::json_value& data) {
+        if (data.is_string()) {
+          doc.insert(std::make_shared<tests::templates::string_field>(
+            irs::string_ref(name),
+            data.str
+          ));
+        }
+    });
+
+    auto codec = irs::formats::get("1_0");
+    EXPECT_NE(nullptr, codec);
+    auto writer = irs::index_writer::make(dir_, codec, irs::OM_CREATE);
+    EXPECT_NE(nullptr, writer);
+
+    for (size_t i = 0; i < segments; ++i) {
+      auto* doc = gen.next();
+      EXPECT_NE(nullptr, doc);
+      EXPECT_TRUE(tests::insert(*writer,
+        doc->indexed.begin(), doc->indexed.end(),
+        doc->stored.begin(), doc->stored.end()));
+      writer->commit(); // create segmentN
+    }
+
+    return writer;
+  }
+
+  // @returns true if 'cond' was satisfied within a timeout
+  template<typename Condition>
+  static bool wait_for(Condition cond) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+
+    while (!cond()) {
+      if (std::chrono::steady_clock::now() > deadline) {
+        return false;
+      }
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    return true;
+  }
+
+  irs::memory_directory dir_;
+};
+
+NS_END
+
+TEST_F(consolidation_scheduler_test, consolidate) {
+  auto writer = populate(5);
+  ASSERT_EQ(5, irs::directory_reader::open(dir_).size());
+
+  irs::consolidation_scheduler::options opts;
+  opts.policies.emplace_back(
+    irs::index_utils::consolidation_policy(irs::index_utils::consolidate_count()));
+  opts.interval = std::chrono::milliseconds(10);
+  opts.max_merges = 2;
+
+  irs::consolidation_scheduler scheduler(writer, std::move(opts));
+
+  ASSERT_TRUE(wait_for([&scheduler]() {
+    const auto stats = scheduler.metrics();
+    return stats.merges && !stats.active;
+  }));
+
+  writer->commit(); // apply consolidation
+
+  auto stats = scheduler.metrics();
+  ASSERT_EQ(1, stats.merges);
+  ASSERT_EQ(0, stats.failures);
+  ASSERT_LT(0, stats.bytes_written);
+  ASSERT_EQ(std::chrono::microseconds(0), stats.throttled);
+
+  auto reader = irs::directory_reader::open(dir_);
+  ASSERT_EQ(1, reader.size());
+  ASSERT_EQ(5, reader.docs_count());
+  ASSERT_EQ(5, reader.live_docs_count());
+
+  // nothing to consolidate
+  scheduler.trigger();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  stats = scheduler.metrics();
+  ASSERT_EQ(1, stats.merges);
+  ASSERT_EQ(0, stats.failures);
+
+  scheduler.stop();
+  stats = scheduler.metrics();
+  ASSERT_EQ(0, stats.pending);
+  ASSERT_EQ(0, stats.active);
+}
+
+TEST_F(consolidation_scheduler_test, consolidate_throttled) {
+  auto writer = populate(5);
+
+  irs::consolidation_scheduler::options opts;
+  opts.policies.emplace_back(
+    irs::index_utils::consolidation_policy(irs::index_utils::consolidate_count()));
+  opts.interval = std::chrono::milliseconds(10);
+  opts.max_write_bytes_per_sec = 4096;
+
+  irs::consolidation_scheduler scheduler(writer, std::move(opts));
+
+  ASSERT_TRUE(wait_for([&scheduler]() {
+    const auto stats = scheduler.metrics();
+    return stats.merges && !stats.active;
+  }));
+
+  const auto stats = scheduler.metrics();
+  ASSERT_EQ(1, stats.merges);
+  ASSERT_LT(0, stats.bytes_written);
+  ASSERT_LT(std::chrono::microseconds(0), stats.throttled);
+
+  writer->commit(); // apply consolidation
+
+  auto reader = irs::directory_reader::open(dir_);
+  ASSERT_EQ(1, reader.size());
+  ASSERT_EQ(5, reader.docs_count());
+}
+
+TEST_F(consolidation_scheduler_test, stop_throttled) {
+  auto writer = populate(5);
+
+  irs::consolidation_scheduler::options opts;
+  opts.policies.emplace_back(
+    irs::index_utils::consolidation_policy(irs::index_utils::consolidate_count()));
+  opts.max_write_bytes_per_sec = 1; // merge would take hours
+
+  irs::consolidation_scheduler scheduler(writer, std::move(opts));
+
+  ASSERT_TRUE(wait_for([&scheduler]() {
+    return scheduler.metrics().throttled.count() > 0 || scheduler.metrics().active;
+  }));
+
+  scheduler.stop(); // must not wait for the throttled merge
+
+  const auto stats = scheduler.metrics();
+  ASSERT_EQ(0, stats.active);
+  ASSERT_EQ(0, stats.merges);
+
+  writer->commit();
+  ASSERT_EQ(5, irs::directory_reader::open(dir_).size()); // nothing consolidated
+}
@@ -0,0 +1,134 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "index/doc_id_map.hpp"
+
+#include <random>
+
+namespace {
+
+struct vector_iterator {
+  explicit vector_iterator(const std::vector<irs::doc_id_t>& docs) noexcept
+    : it(docs.begin()), end(docs.end()) {
+  }
+
+  bool next() noexcept {
+    if (it == end) {
+      return false;
+    }
+
+    doc = *it++;
+    return true;
+  }
+
+  irs::doc_id_t value() const noexcept { return doc; }
+
+  std::vector<irs::doc_id_t>::const_iterator it;
+  std::vector<irs::doc_id_t>::const_iterator end;
+  irs::doc_id_t doc{};
+};
+
+}
+
+TEST(doc_id_map_test, ctor) {
+  const irs::doc_id_map map;
+  ASSERT_EQ(irs::doc_limits::eof(), map(0));
+  ASSERT_EQ(irs::doc_limits::eof(), map(irs::doc_limits::min()));
+  ASSERT_EQ(irs::doc_limits::eof(), map(irs::doc_limits::eof()));
+  ASSERT_EQ(0, map.memory());
+}
+
+TEST(doc_id_map_test, offset) {
+  irs::doc_id_map map;
+  map.reset(100, 42);
+  ASSERT_EQ(0, map.memory());
+
+  for (irs::doc_id_t doc = irs::doc_limits::min(); doc <= 100; ++doc) {
+    ASSERT_EQ(41 + doc, map(doc));
+  }
+  ASSERT_EQ(irs::doc_limits::eof(), map(101));
+  ASSERT_EQ(irs::doc_limits::eof(), map(irs::doc_limits::eof()));
+}
+
+TEST(doc_id_map_test, rank) {
+  constexpr irs::doc_id_t COUNT = 10000;
+
+  std::vector<irs::doc_id_t> live;
+  for (irs::doc_id_t doc = irs::doc_limits::min(); doc <= COUNT; ++doc) {
+    // keep runs of live documents interleaved with deletes
+    if (doc % 7 && (doc < 3000 || doc > 3200)) {
+      live.push_back(doc);
+    }
+  }
+
+  irs::doc_id_map map;
+  vector_iterator it(live);
+  ASSERT_EQ(5 + live.size(), map.reset(it, COUNT, 5));
+  ASSERT_LT(map.memory(), COUNT*sizeof(irs::doc_id_t)/8);
+
+  irs::doc_id_t expected = 5;
+  auto live_it = live.begin();
+  for (irs::doc_id_t doc = 0; doc <= COUNT + 64; ++doc) {
+    if (live_it != live.end() && *live_it == doc) {
+      ASSERT_EQ(expected++, map(doc));
+      ++live_it;
+    } else {
+      ASSERT_EQ(irs::doc_limits::eof(), map(doc));
+    }
+  }
+}
+
+TEST(doc_id_map_test, packed) {
+  constexpr irs::doc_id_t COUNT = 5000;
+  constexpr irs::doc_id_t MAX = 100000;
+
+  std::vector<irs::doc_id_t> expected(COUNT + irs::doc_limits::min(), irs::doc_limits::eof());
+
+  std::mt19937 engine;
+  std::uniform_int_distribution<irs::doc_id_t> distribution(irs::doc_limits::min(), MAX);
+
+  irs::doc_id_map map;
+  map.reset_packed(COUNT, MAX);
+  ASSERT_LT(map.memory(), COUNT*sizeof(irs::doc_id_t));
+
+  for (irs::doc_id_t doc = 0; doc < expected.size(); ++doc) {
+    ASSERT_EQ(irs::doc_limits::eof(), map(doc));
+  }
+
+  // set every mapping twice to ensure neighbours aren't affected
+  for (size_t i = 0; i < 2; ++i) {
+    for (irs::doc_id_t doc = irs::doc_limits::min(); doc < expected.size(); ++doc) {
+      if (doc % 5) {
+        expected[doc] = distribution(engine);
+        map.set(doc, expected[doc]);
+      }
+    }
+  }
+  map.set(COUNT, MAX);
+  expected[COUNT] = MAX;
+
+  for (irs::doc_id_t doc = 0; doc < expected.size(); ++doc) {
+    ASSERT_EQ(expected[doc], map(doc));
+  }
+  ASSERT_EQ(irs::doc_limits::eof(), map(COUNT + 1));
+}
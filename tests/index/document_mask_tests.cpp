@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "index/document_mask.hpp"
+#include "utils/type_limits.hpp"
+
+#include <set>
+
+TEST(document_mask_test, ctor) {
+  {
+    const irs::document_mask mask;
+    ASSERT_TRUE(mask.empty());
+    ASSERT_EQ(0, mask.size());
+    ASSERT_EQ(mask.end(), mask.begin());
+    ASSERT_FALSE(mask.contains(0));
+    ASSERT_FALSE(mask.contains(irs::doc_limits::eof()));
+    ASSERT_EQ(1, mask.next_unmasked(1));
+    ASSERT_EQ(irs::doc_limits::eof(), mask.next_unmasked(irs::doc_limits::eof()));
+  }
+
+  {
+    const irs::document_mask mask{ 5, 1, 64, 5 };
+    ASSERT_FALSE(mask.empty());
+    ASSERT_EQ(3, mask.size());
+    ASSERT_TRUE(mask.contains(1));
+    ASSERT_TRUE(mask.contains(5));
+    ASSERT_TRUE(mask.contains(64));
+    ASSERT_FALSE(mask.contains(2));
+    ASSERT_FALSE(mask.contains(63));
+    ASSERT_FALSE(mask.contains(65));
+    const std::vector<irs::doc_id_t> expected{ 1, 5, 64 };
+    ASSERT_EQ(expected, std::vector<irs::doc_id_t>(mask.begin(), mask.end()));
+  }
+}
+
+TEST(document_mask_test, insert_erase) {
+  irs::document_mask mask;
+  ASSERT_TRUE(mask.insert(42));
+  ASSERT_FALSE(mask.insert(42));
+  ASSERT_TRUE(mask.insert(1000));
+  ASSERT_EQ(2, mask.size());
+  ASSERT_EQ(0, mask.erase(43));
+  ASSERT_EQ(0, mask.erase(100000));
+  ASSERT_EQ(1, mask.erase(42));
+  ASSERT_EQ(0, mask.erase(42));
+  ASSERT_EQ(1, mask.size());
+  ASSERT_FALSE(mask.contains(42));
+  ASSERT_TRUE(mask.contains(1000));
+  mask.clear();
+  ASSERT_TRUE(mask.empty());
+  ASSERT_FALSE(mask.contains(1000));
+}
+
+TEST(document_mask_test, next_unmasked) {
+  irs::document_mask mask;
+  mask.reserve(1024);
+
+  // masked run crossing several words
+  for (irs::doc_id_t doc = 10; doc < 300; ++doc) {
+    mask.insert(doc);
+  }
+  mask.insert(301);
+
+  ASSERT_EQ(9, mask.next_unmasked(9));
+  ASSERT_EQ(300, mask.next_unmasked(10));
+  ASSERT_EQ(300, mask.next_unmasked(128));
+  ASSERT_EQ(300, mask.next_unmasked(300));
+  ASSERT_EQ(302, mask.next_unmasked(301));
+  ASSERT_EQ(1000, mask.next_unmasked(1000));
+
+  // masked tail
+  for (irs::doc_id_t doc = 1000; doc < 1024; ++doc) {
+    mask.insert(doc);
+  }
+
+  ASSERT_EQ(999, mask.next_unmasked(999));
+  ASSERT_LE(1024, mask.next_unmasked(1000));
+  ASSERT_FALSE(mask.contains(mask.next_unmasked(1000)));
+}
+
+TEST(document_mask_test, iterate) {
+  std::set<irs::doc_id_t> expected;
+  irs::document_mask mask;
+
+  for (irs::doc_id_t doc = 1; doc < 5000; doc += 1 + doc % 7) {
+    expected.emplace(doc);
+    ASSERT_TRUE(mask.insert(doc));
+  }
+
+  ASSERT_EQ(expected.size(), mask.size());
+  ASSERT_TRUE(std::equal(expected.begin(), expected.end(), mask.begin()));
+
+  // compare with doc-at-a-time lookup
+  for (irs::doc_id_t doc = 1; doc < 5100; ++doc) {
+    auto expected_doc = doc;
+    while (expected.count(expected_doc)) {
+      ++expected_doc;
+    }
+    ASSERT_EQ(expected_doc, mask.next_unmasked(doc));
+  }
+}
@@ -23,7 +23,12 @@
 
 #include "tests_shared.hpp"
 #include "iql/query_builder.hpp"
+#include "formats/formats_10.hpp"
 #include "utils/lz4compression.hpp"
+
+#ifdef USE_ZSTD
+#include "utils/zstd_compression.hpp"
+#endif
 #include "store/memory_directory.hpp"
 
 #include "index_tests.hpp"
@@ -8795,6 +8800,214 @@ TEST_P(index_column_test_case, read_empty_doc_attributes) {
   ASSERT_EQ(nullptr, column);
 }
 
+TEST_P(index_column_test_case, read_write_doc_attributes_block_size) {
+  static const irs::doc_id_t MAX_DOCS = 20000;
+  static const irs::string_ref column_name = "json";
+
+  auto make_value = [](irs::doc_id_t i) {
+    return "{\"id\":" + std::to_string(i)
+         + ",\"name\":\"name" + std::to_string(i % 7)
+         + "\",\"active\":" + (i % 2 ? "true" : "false") + "}";
+  };
+
+  // large blocks with a per-column dictionary
+  irs::index_writer::init_options options;
+  options.column_info = [](const irs::string_ref&) {
+#ifdef USE_ZSTD
+    return irs::column_info{ irs::type<irs::compression::zstd_dict>::get(), irs::compression::options{}, false, 65536 };
+#else
+    return irs::column_info{ irs::type<irs::compression::lz4>::get(), irs::compression::options{}, false, 65536 };
+#endif
+  };
+
+  // write documents
+  {
+    struct stored {
+      const irs::string_ref& name() { return column_name; }
+
+      const irs::flags& features() const {
+        return irs::flags::empty_instance();
+      }
+
+      bool write(irs::data_output& out) {
+        out.write_bytes(reinterpret_cast<const irs::byte_type*>(value.c_str()), value.size());
+        return true;
+      }
+
+      std::string value;
+    } field;
+
+    auto writer = irs::index_writer::make(this->dir(), this->codec(), irs::OM_CREATE, options);
+    auto ctx = writer->documents();
+
+    for (irs::doc_id_t i = 0; i < MAX_DOCS; ++i) {
+      auto doc = ctx.insert();
+      field.value = make_value(i);
+      doc.insert<irs::Action::STORE>(field);
+    }
+
+    { irs::index_writer::documents_context(std::move(ctx)); } // force flush of documents()
+    writer->commit();
+  }
+
+  auto reader = irs::directory_reader::open(this->dir(), this->codec());
+  ASSERT_EQ(1, reader.size());
+  auto& segment = *(reader.begin());
+
+  auto column = segment.column_reader(column_name);
+  ASSERT_NE(nullptr, column);
+  ASSERT_EQ(MAX_DOCS, column->size());
+
+  // random read
+  {
+    irs::bytes_ref actual_value;
+    auto values = column->values();
+
+    for (irs::doc_id_t i = MAX_DOCS; i; --i) {
+      const irs::doc_id_t doc = i - 1 + irs::doc_limits::min();
+      ASSERT_TRUE(values(doc, actual_value));
+      ASSERT_EQ(make_value(i - 1), irs::ref_cast<char>(actual_value));
+    }
+  }
+
+  // iterate
+  {
+    auto it = column->iterator();
+    ASSERT_NE(nullptr, it);
+    auto* payload = irs::get<irs::payload>(*it);
+    ASSERT_NE(nullptr, payload);
+
+    irs::doc_id_t i = 0;
+    for (; it->next(); ++i) {
+      ASSERT_EQ(i + irs::doc_limits::min(), it->value());
+      ASSERT_EQ(make_value(i), irs::ref_cast<char>(payload->value));
+    }
+    ASSERT_EQ(MAX_DOCS, i);
+  }
+}
+
+TEST_P(index_column_test_case, read_write_doc_attributes_shared_cache) {
+  static const irs::doc_id_t MAX_DOCS = 20000;
+  static const irs::string_ref column_name = "id";
+
+  // write documents
+  {
+    struct stored {
+      const irs::string_ref& name() { return column_name; }
+
+      const irs::flags& features() const {
+        return irs::flags::empty_instance();
+      }
+
+      bool write(irs::data_output& out) {
+        irs::write_string(out, value);
+        return true;
+      }
+
+      std::string value;
+    } field;
+
+    auto writer = irs::index_writer::make(this->dir(), this->codec(), irs::OM_CREATE);
+    auto ctx = writer->documents();
+
+    for (irs::doc_id_t i = 0; i < MAX_DOCS; ++i) {
+      auto doc = ctx.insert();
+      field.value = std::to_string(i);
+      doc.insert<irs::Action::STORE>(field);
+    }
+
+    { irs::index_writer::documents_context(std::move(ctx)); } // force flush of documents()
+    writer->commit();
+  }
+
+  // enable shared cache
+  const auto capacity = irs::version10::columnstore_cache_capacity();
+  irs::version10::columnstore_cache_capacity(1 << 20);
+  auto restore_capacity = irs::make_finally([capacity]() {
+    irs::version10::columnstore_cache_capacity(capacity);
+  });
+  ASSERT_EQ(1 << 20, irs::version10::columnstore_cache_capacity());
+
+  auto reader = irs::directory_reader::open(this->dir(), this->codec());
+  ASSERT_EQ(1, reader.size());
+  auto& segment = *(reader.begin());
+
+  auto column = segment.column_reader(column_name);
+  ASSERT_NE(nullptr, column);
+  ASSERT_EQ(MAX_DOCS, column->size());
+
+  auto check_value = [](irs::doc_id_t i, const irs::bytes_ref& value) {
+    const auto* in = value.c_str();
+    return std::to_string(i) == irs::vread_string<std::string>(in);
+  };
+
+  // random read
+  {
+    const auto before = irs::version10::get_columnstore_cache_stats();
+
+    irs::bytes_ref actual_value;
+    auto values = column->values();
+
+    for (irs::doc_id_t i = MAX_DOCS; i; --i) {
+      const irs::doc_id_t doc = i - 1 + irs::doc_limits::min();
+      ASSERT_TRUE(values(doc, actual_value));
+      ASSERT_TRUE(check_value(i - 1, actual_value));
+    }
+
+    // same block is served from the cache
+    ASSERT_TRUE(values(irs::doc_limits::min(), actual_value));
+    ASSERT_TRUE(check_value(0, actual_value));
+
+    const auto after = irs::version10::get_columnstore_cache_stats();
+    ASSERT_GT(after.misses, before.misses);
+    ASSERT_GT(after.hits, before.hits);
+    ASSERT_LE(after.size, after.capacity);
+    ASSERT_LT(after.misses - before.misses, MAX_DOCS);
+  }
+
+  // iterate
+  {
+    auto it = column->iterator();
+    ASSERT_NE(nullptr, it);
+    auto* payload = irs::get<irs::payload>(*it);
+    ASSERT_NE(nullptr, payload);
+
+    irs::doc_id_t i = 0;
+    for (; it->next(); ++i) {
+      ASSERT_EQ(i + irs::doc_limits::min(), it->value());
+      ASSERT_TRUE(check_value(i, payload->value));
+    }
+    ASSERT_EQ(MAX_DOCS, i);
+  }
+
+  // visit
+  {
+    irs::doc_id_t i = 0;
+    ASSERT_TRUE(column->visit([&i, &check_value](irs::doc_id_t doc, const irs::bytes_ref& value) {
+      EXPECT_EQ(i + irs::doc_limits::min(), doc);
+      EXPECT_TRUE(check_value(i, value));
+      ++i;
+      return true;
+    }));
+    ASSERT_EQ(MAX_DOCS, i);
+  }
+
+  // disabling cache evicts all blocks
+  irs::version10::columnstore_cache_capacity(0);
+  const auto stats = irs::version10::get_columnstore_cache_stats();
+  ASSERT_EQ(0, stats.capacity);
+  ASSERT_EQ(0, stats.size);
+  ASSERT_EQ(0, stats.blocks);
+
+  // blocks are still readable
+  {
+    irs::bytes_ref actual_value;
+    auto values = column->values();
+    ASSERT_TRUE(values(MAX_DOCS, actual_value));
+    ASSERT_TRUE(check_value(MAX_DOCS - 1, actual_value));
+  }
+}
+
 INSTANTIATE_TEST_CASE_P(
   index_column_test,
   index_column_test_case,
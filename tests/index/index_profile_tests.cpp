@@ -29,7 +29,10 @@
 #include "store/fs_directory.hpp"
 #include "store/memory_directory.hpp"
 #include "store/mmap_directory.hpp"
+#include "utils/automaton_utils.hpp"
 #include "utils/index_utils.hpp"
+#include "utils/levenshtein_utils.hpp"
+#include "utils/wildcard_utils.hpp"
 
 class index_profile_test_case : public tests::index_test_base {
  public:
@@ -526,6 +529,68 @@ TEST_P(index_profile_test_case, profile_bulk_index_multithread_update_batched_mt
   profile_bulk_index(16, 0, 5, 10000); // 5 does not divide evenly into 16
 }
 
+TEST_P(index_profile_test_case, profile_automaton_intersection) {
+  constexpr size_t ITERATIONS = 100;
+  constexpr irs::string_ref FIELD = "body_anl";
+
+  {
+    tests::templates::europarl_doc_template doc;
+    tests::delim_doc_generator gen(resource("europarl.subset.txt"), doc);
+    add_segment(gen);
+  }
+
+  const auto description = irs::make_parametric_description(2, true);
+
+  std::vector<std::pair<std::string, irs::automaton>> acceptors;
+  for (const irs::string_ref pattern : { "forb%", "c%n", "%ende%", "%ione", "%t_on%" }) {
+    acceptors.emplace_back(
+      "wildcard(" + std::string(pattern) + ")",
+      irs::from_wildcard(pattern));
+  }
+  for (const irs::string_ref target : { "europe", "commission", "parliament" }) {
+    acceptors.emplace_back(
+      "levenshtein(" + std::string(target) + ")",
+      irs::make_levenshtein_automaton(description, irs::ref_cast<irs::byte_type>(target)));
+  }
+
+  irs::timer_utils::init_stats(true);
+
+  auto reader = open_reader();
+  ASSERT_EQ(1, reader.size());
+  auto* terms = reader[0].field(FIELD);
+  ASSERT_NE(nullptr, terms);
+
+  for (auto& entry : acceptors) {
+    auto& acceptor = entry.second;
+    auto matcher = irs::make_automaton_matcher(acceptor);
+
+    // number of terms accepted by the automaton
+    size_t expected = 0;
+    for (auto it = terms->iterator(); it->next(); ) {
+      expected += bool(irs::accept<irs::byte_type>(acceptor, it->value()));
+    }
+
+    auto& stat = irs::timer_utils::get_stat(entry.first);
+
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+      irs::timer_utils::scoped_timer timer(stat);
+
+      size_t actual = 0;
+      for (auto it = terms->iterator(matcher); it->next(); ) {
+        ++actual;
+      }
+      ASSERT_EQ(expected, actual);
+    }
+  }
+
+  auto path = test_dir();
+  path /= "profile_automaton_intersection.log";
+  std::ofstream out(path.native());
+  irs::timer_utils::flush_stats(out);
+  out.close();
+  std::cout << "Path to timing log: " << path.utf8_absolute() << std::endl;
+}
+
 INSTANTIATE_TEST_CASE_P(
   index_profile_test,
   index_profile_test_case,
@@ -13421,6 +13421,85 @@ TEST_P(index_test_case, segment_options) {
   }
 }
 
+TEST_P(index_test_case, concurrent_segment_flush) {
+  tests::json_doc_generator gen(
+    resource("simple_sequential.json"),
+    [] (tests::document& doc, const std::string& name, const tests::json_doc_generator::json_value& data) {
+    if (data.is_string()) {
+      doc.insert(std::make_shared<tests::templates::string_field>(
+        irs::string_ref(name),
+        data.str
+      ));
+    }
+  });
+
+  irs::index_writer::init_options options;
+  options.flush_threads = 4;
+  auto writer = open_writer(irs::OM_CREATE, options);
+
+  // committed segment
+  {
+    auto* doc = gen.next();
+    ASSERT_NE(nullptr, doc);
+    ASSERT_TRUE(insert(*writer,
+      doc->indexed.begin(), doc->indexed.end(),
+      doc->stored.begin(), doc->stored.end()
+    ));
+    writer->commit();
+  }
+
+  auto query_doc1 = irs::iql::query_builder().build("name==A", std::locale::classic());
+
+  // fill multiple segments held simultaneously, i.e. flushed by a single commit
+  {
+    std::vector<irs::index_writer::documents_context> contexts;
+    contexts.reserve(5);
+
+    for (size_t i = 0; i < contexts.capacity(); ++i) {
+      contexts.emplace_back(writer->documents());
+    }
+
+    for (size_t i = 0; auto* doc = gen.next(); ++i) {
+      auto& ctx = contexts[i % contexts.size()];
+      auto inserted = ctx.insert();
+      ASSERT_TRUE(
+        inserted.insert<irs::Action::INDEX>(doc->indexed.begin(), doc->indexed.end())
+        && inserted.insert<irs::Action::STORE>(doc->stored.begin(), doc->stored.end())
+      );
+    }
+
+    contexts.front().remove(*(query_doc1.filter));
+  }
+
+  writer->commit();
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  ASSERT_EQ(5, reader.size()); // fully masked segment is removed
+
+  gen.reset();
+  gen.next(); // skip removed document
+  std::unordered_set<std::string> expected_names;
+  for (auto* doc = gen.next(); doc; doc = gen.next()) {
+    const auto name = doc->stored.get<tests::templates::string_field>("name")->value();
+    expected_names.emplace(name.c_str(), name.size());
+  }
+  ASSERT_EQ(expected_names.size(), reader.live_docs_count());
+
+  irs::bytes_ref actual_value;
+  for (auto& segment : reader) {
+    const auto* column = segment.column_reader("name");
+    ASSERT_NE(nullptr, column);
+    auto values = column->values();
+
+    for (auto docs = segment.docs_iterator(); docs->next();) {
+      ASSERT_TRUE(values(docs->value(), actual_value));
+      ASSERT_EQ(1, expected_names.erase(irs::to_string<std::string>(actual_value.c_str())));
+    }
+  }
+
+  ASSERT_TRUE(expected_names.empty());
+}
+
 TEST_P(index_test_case, writer_close) {
   tests::json_doc_generator gen(
     resource("simple_sequential.json"),
@@ -13533,6 +13612,30 @@ INSTANTIATE_TEST_CASE_P(
   tests::to_string
 );
 
+// Separate definition as MSVC parser fails to do conditional defines in macro expansion
+NS_LOCAL
+#if defined(IRESEARCH_SSE2)
+const auto index_test_case_14_values = ::testing::Values(tests::format_info{"1_4", "1_0"},
+                                                         tests::format_info{"1_4simd", "1_0"});
+#else
+const auto index_test_case_14_values = ::testing::Values(tests::format_info{"1_4", "1_0"});
+#endif
+NS_END
+
+INSTANTIATE_TEST_CASE_P(
+  index_test_14,
+  index_test_case,
+  ::testing::Combine(
+    ::testing::Values(
+      &tests::rot13_cipher_directory<&tests::memory_directory, 16>,
+      &tests::rot13_cipher_directory<&tests::fs_directory, 16>,
+      &tests::rot13_cipher_directory<&tests::mmap_directory, 16>
+    ),
+    index_test_case_14_values
+  ),
+  tests::to_string
+);
+
 class index_test_case_10 : public tests::index_test_base { };
 
 TEST_P(index_test_case_10, commit_payload) {
@@ -2248,6 +2248,175 @@ TEST_F(merge_writer_tests, test_merge_writer_add_segments) {
   }
 }
 
+TEST_F(merge_writer_tests, test_merge_writer_concurrent) {
+  auto codec_ptr = irs::formats::get("1_0");
+  ASSERT_NE(nullptr, codec_ptr);
+  irs::memory_directory data_dir;
+
+  // populate directory
+  {
+    tests::json_doc_generator gen(
+      test_base::resource("simple_sequential_33.json"),
+      &tests::generic_json_field_factory
+    );
+
+    auto query_doc = irs::iql::query_builder().build("name==B", std::locale::classic());
+    auto writer = irs::index_writer::make(data_dir, codec_ptr, irs::OM_CREATE);
+
+    for (size_t i = 0; auto* doc = gen.next(); ++i) {
+      ASSERT_TRUE(insert(
+        *writer,
+        doc->indexed.begin(), doc->indexed.end(),
+        doc->stored.begin(), doc->stored.end()
+      ));
+
+      if (0 == i % 10) {
+        writer->commit(); // create segmentN
+      }
+    }
+
+    writer->documents().remove(*query_doc.filter);
+    writer->commit();
+  }
+
+  auto reader = irs::directory_reader::open(data_dir, codec_ptr);
+  ASSERT_LT(1, reader.size());
+
+  irs::column_info_provider_t column_info = [](const irs::string_ref&) {
+    return irs::column_info(irs::type<irs::compression::lz4>::get(), irs::compression::options{}, true );
+  };
+
+  irs::memory_directory expected_dir;
+  irs::index_meta::index_segment_t expected_segment;
+  expected_segment.meta.codec = codec_ptr;
+  expected_segment.meta.name = "merged";
+
+  // sequential merge
+  {
+    irs::merge_writer writer(expected_dir, column_info);
+
+    for (auto& sub_reader: reader) {
+      writer.add(sub_reader);
+    }
+
+    ASSERT_TRUE(writer.flush(expected_segment));
+  }
+
+  irs::async_utils::thread_pool pool(2, 2);
+
+  // concurrent merge aborted by progress
+  {
+    irs::memory_directory dir;
+    irs::index_meta::index_segment_t index_segment;
+    index_segment.meta.codec = codec_ptr;
+    irs::merge_writer writer(dir, column_info, nullptr, &pool);
+
+    for (auto& sub_reader: reader) {
+      writer.add(sub_reader);
+    }
+
+    size_t call_count = 3;
+    ASSERT_FALSE(writer.flush(index_segment, [&call_count]()->bool {
+      return call_count && --call_count;
+    }));
+    ASSERT_TRUE(index_segment.meta.files.empty());
+    ASSERT_EQ(0, index_segment.meta.docs_count);
+  }
+
+  irs::memory_directory dir;
+  irs::index_meta::index_segment_t index_segment;
+  index_segment.meta.codec = codec_ptr;
+  index_segment.meta.name = "merged";
+
+  // concurrent merge
+  {
+    irs::merge_writer writer(dir, column_info, nullptr, &pool);
+
+    for (auto& sub_reader: reader) {
+      writer.add(sub_reader);
+    }
+
+    ASSERT_TRUE(writer.flush(index_segment));
+  }
+
+  ASSERT_EQ(expected_segment.meta.files, index_segment.meta.files);
+  ASSERT_EQ(expected_segment.meta.docs_count, index_segment.meta.docs_count);
+  ASSERT_EQ(expected_segment.meta.live_docs_count, index_segment.meta.live_docs_count);
+  ASSERT_EQ(reader.live_docs_count(), index_segment.meta.docs_count);
+
+  auto expected = irs::segment_reader::open(expected_dir, expected_segment.meta);
+  auto actual = irs::segment_reader::open(dir, index_segment.meta);
+
+  // compare field terms, postings and norms
+  {
+    auto expected_fields = expected.fields();
+    auto actual_fields = actual.fields();
+
+    while (expected_fields->next()) {
+      ASSERT_TRUE(actual_fields->next());
+      auto& expected_field = expected_fields->value();
+      auto& actual_field = actual_fields->value();
+      ASSERT_EQ(expected_field.meta().name, actual_field.meta().name);
+      ASSERT_EQ(expected_field.meta().features, actual_field.meta().features);
+      ASSERT_EQ(irs::field_limits::valid(expected_field.meta().norm),
+                irs::field_limits::valid(actual_field.meta().norm));
+      ASSERT_EQ(expected_field.docs_count(), actual_field.docs_count());
+      ASSERT_EQ(expected_field.size(), actual_field.size());
+
+      if (irs::field_limits::valid(expected_field.meta().norm)) {
+        auto expected_norms = expected.column_reader(expected_field.meta().norm)->values();
+        auto actual_norms = actual.column_reader(actual_field.meta().norm)->values();
+        irs::bytes_ref expected_value, actual_value;
+
+        for (irs::doc_id_t doc = irs::doc_limits::min(); doc <= expected.docs_count(); ++doc) {
+          ASSERT_EQ(expected_norms(doc, expected_value), actual_norms(doc, actual_value));
+          ASSERT_EQ(expected_value, actual_value);
+        }
+      }
+
+      auto expected_terms = expected_field.iterator();
+      auto actual_terms = actual_field.iterator();
+
+      while (expected_terms->next()) {
+        ASSERT_TRUE(actual_terms->next());
+        ASSERT_EQ(expected_terms->value(), actual_terms->value());
+
+        auto expected_docs = expected_terms->postings(irs::flags::empty_instance());
+        auto actual_docs = actual_terms->postings(irs::flags::empty_instance());
+
+        while (expected_docs->next()) {
+          ASSERT_TRUE(actual_docs->next());
+          ASSERT_EQ(expected_docs->value(), actual_docs->value());
+        }
+        ASSERT_FALSE(actual_docs->next());
+      }
+      ASSERT_FALSE(actual_terms->next());
+    }
+    ASSERT_FALSE(actual_fields->next());
+  }
+
+  // compare columns
+  {
+    auto expected_columns = expected.columns();
+    auto actual_columns = actual.columns();
+
+    while (expected_columns->next()) {
+      ASSERT_TRUE(actual_columns->next());
+      ASSERT_EQ(expected_columns->value().name, actual_columns->value().name);
+
+      auto expected_values = expected.column_reader(expected_columns->value().id)->values();
+      auto actual_values = actual.column_reader(actual_columns->value().id)->values();
+      irs::bytes_ref expected_value, actual_value;
+
+      for (irs::doc_id_t doc = irs::doc_limits::min(); doc <= expected.docs_count(); ++doc) {
+        ASSERT_EQ(expected_values(doc, expected_value), actual_values(doc, actual_value));
+        ASSERT_EQ(expected_value, actual_value);
+      }
+    }
+    ASSERT_FALSE(actual_columns->next());
+  }
+}
+
 TEST_F(merge_writer_tests, test_merge_writer_flush_progress) {
   auto codec_ptr = irs::formats::get("1_0");
   ASSERT_NE(nullptr, codec_ptr);
@@ -159,3 +159,28 @@ TEST(postings_tests, slice_alignment) {
     ASSERT_EQ(tests::detail::to_bytes_ref("string1"), bh.begin()->first);
   }
 }
+
+TEST(postings_tests, get_sorted_postings) {
+  const uint32_t block_size = 32768;
+  block_pool<byte_type, block_size> pool;
+  block_pool<byte_type, block_size>::inserter writer(pool.begin());
+  postings bh(writer, 16);
+
+  // terms sharing long prefixes and prefixes of each other
+  std::set<std::string> expected;
+  for (size_t i = 0; i < 1000; ++i) {
+    const auto term = std::string(i % 7, 'a') + std::to_string(i*31 % 997);
+    ASSERT_EQ(expected.insert(term).second, bh.emplace(tests::detail::to_bytes_ref(term)).second);
+  }
+  ASSERT_EQ(expected.size(), bh.size());
+
+  postings::sorted_postings_t sorted;
+  bh.get_sorted_postings(sorted);
+  ASSERT_EQ(expected.size(), sorted.size());
+
+  auto expected_term = expected.begin();
+  for (auto* entry : sorted) {
+    ASSERT_EQ(tests::detail::to_bytes_ref(*expected_term), entry->first);
+    ++expected_term;
+  }
+}
@@ -34,6 +34,7 @@
 #include "search/score.hpp"
 #include "search/bm25.hpp"
 #include "search/term_filter.hpp"
+#include "search/top_docs_collector.hpp"
 #include "utils/utf8_path.hpp"
 
 NS_LOCAL
@@ -1427,6 +1428,118 @@ TEST_P(bm25_test, test_order) {
   }
 }
 
+TEST_P(bm25_test, test_block_scorer) {
+  // term 'a' occurs 1..13 times, term 'b' 0..4 times, every 11th document
+  // doesn't contain 'a', documents span multiple posting blocks
+  {
+    static const irs::flags norm_features{ irs::type<irs::norm>::get() };
+    templates::string_field a("field", "a");
+    templates::string_field b("field", "b");
+    templates::string_field norm_a("norm_field", "a", norm_features);
+    templates::string_field norm_b("norm_field", "b", norm_features);
+
+    auto writer = open_writer(irs::OM_CREATE);
+
+    for (size_t i = 0; i < 300; ++i) {
+      auto ctx = writer->documents();
+      auto doc = ctx.insert();
+
+      for (size_t j = 0, count = i % 11 ? 1 + (i*7) % 13 : 0; j < count; ++j) {
+        ASSERT_TRUE(doc.insert<irs::Action::INDEX>(a));
+        ASSERT_TRUE(doc.insert<irs::Action::INDEX>(norm_a));
+      }
+
+      for (size_t j = 0, count = i % 5; j < count; ++j) {
+        ASSERT_TRUE(doc.insert<irs::Action::INDEX>(b));
+        ASSERT_TRUE(doc.insert<irs::Action::INDEX>(norm_b));
+      }
+    }
+
+    writer->commit();
+  }
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  ASSERT_EQ(1, reader.size());
+  auto& segment = reader[0];
+
+  // 2 buckets, BM25 and BM15
+  irs::order order;
+  order.add(true, irs::scorers::get("bm25", irs::type<irs::text_format::json>::get(), irs::string_ref::NIL));
+  order.add(true, irs::scorers::get("bm25", irs::type<irs::text_format::json>::get(), "{\"b\": 0}"));
+  auto prepared_order = order.prepare();
+  const size_t score_size = prepared_order.score_size();
+
+  for (auto field : { "field", "norm_field" }) {
+    irs::by_term filter;
+    *filter.mutable_field() = field;
+    filter.mutable_options()->term = irs::ref_cast<irs::byte_type>(irs::string_ref("a"));
+
+    auto prepared = filter.prepare(reader, prepared_order);
+    ASSERT_NE(nullptr, prepared);
+
+    // per-document scores
+    std::vector<std::pair<irs::doc_id_t, irs::bstring>> expected;
+    {
+      auto docs = prepared->execute(segment, prepared_order);
+      auto* score = irs::get<irs::score>(*docs);
+      ASSERT_NE(nullptr, score);
+
+      while (docs->next()) {
+        expected.emplace_back(docs->value(), irs::bstring(score->evaluate(), score_size));
+      }
+    }
+    ASSERT_EQ(272, expected.size());
+
+    // block scores
+    {
+      auto docs = prepared->execute(segment, prepared_order);
+      auto* block = irs::get<irs::score_block>(*docs);
+      ASSERT_NE(nullptr, block);
+      ASSERT_FALSE(block->empty());
+      auto* freq = irs::get<irs::frequency>(*docs);
+      ASSERT_NE(nullptr, freq);
+
+      std::vector<irs::doc_id_t> ids;
+      std::vector<uint32_t> freqs;
+
+      while (docs->next()) {
+        ids.push_back(docs->value());
+        freqs.push_back(freq->value);
+      }
+      ASSERT_EQ(expected.size(), ids.size());
+
+      irs::bstring scores(ids.size()*score_size, 0);
+      block->evaluate(ids.data(), freqs.data(), ids.size(), &scores[0]);
+
+      for (size_t i = 0; i < ids.size(); ++i) {
+        ASSERT_EQ(expected[i].first, ids[i]);
+        ASSERT_EQ(expected[i].second, scores.substr(i*score_size, score_size));
+      }
+    }
+
+    // batched collection ranks documents the same way
+    {
+      std::stable_sort(
+        expected.begin(), expected.end(),
+        [&prepared_order](const auto& lhs, const auto& rhs) {
+          return prepared_order.less(lhs.second.c_str(), rhs.second.c_str());
+      });
+
+      irs::top_docs_collector collector(10, prepared_order);
+      collector.collect(reader, *prepared);
+      ASSERT_EQ(272, collector.visited());
+
+      const auto hits = collector.top();
+      ASSERT_EQ(10, hits.size());
+
+      for (size_t i = 0; i < hits.size(); ++i) {
+        ASSERT_EQ(expected[i].first, hits[i].doc);
+        ASSERT_EQ(expected[i].second, irs::bstring(hits[i].key.c_str(), hits[i].key.size()));
+      }
+    }
+  }
+}
+
 INSTANTIATE_TEST_CASE_P(
   bm25_test,
   bm25_test,
@@ -0,0 +1,245 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "filter_test_case_base.hpp"
+#include "search/column_range_filter.hpp"
+
+NS_LOCAL
+
+constexpr size_t LONG_SIZE = 128;
+
+// big-endian encoding preserves order of unsigned numbers,
+// padding with zeros up to 'size' bytes preserves it as well
+irs::bstring encode(uint64_t value, size_t size = sizeof(uint64_t)) {
+  irs::bstring buf(size, 0);
+  for (size_t i = sizeof(uint64_t); i; --i) {
+    buf[i - 1] = irs::byte_type(value & 0xFF);
+    value >>= 8;
+  }
+  return buf;
+}
+
+irs::by_column_range make_filter(
+    const irs::string_ref& field,
+    irs::BoundType min_type, uint64_t min,
+    irs::BoundType max_type, uint64_t max) {
+  const auto size = field == "long" ? LONG_SIZE : sizeof(uint64_t);
+
+  irs::by_column_range filter;
+  *filter.mutable_field() = field;
+  auto& range = filter.mutable_options()->range;
+  range.min_type = min_type;
+  range.min = encode(min, size);
+  range.max_type = max_type;
+  range.max = encode(max, size);
+  return filter;
+}
+
+class column_range_filter_test_case : public tests::filter_test_case_base {
+ protected:
+  struct stored {
+    const irs::string_ref& name() const { return name_; }
+
+    const irs::flags& features() const {
+      return irs::flags::empty_instance();
+    }
+
+    bool write(irs::data_output& out) const {
+      out.write_bytes(value.c_str(), value.size());
+      return true;
+    }
+
+    irs::string_ref name_;
+    irs::bstring value;
+  };
+
+  // 'value' of a document is 'doc - 1', 'long' is 'value' padded with zeros
+  void add_segment(uint64_t count) {
+    stored value{ "value" };
+    stored long_value{ "long" };
+
+    auto writer = open_writer(irs::OM_CREATE);
+    auto ctx = writer->documents();
+
+    for (uint64_t i = 0; i < count; ++i) {
+      auto doc = ctx.insert();
+      value.value = encode(i);
+      doc.insert<irs::Action::STORE>(value);
+      long_value.value = encode(i, LONG_SIZE);
+      doc.insert<irs::Action::STORE>(long_value);
+    }
+
+    { irs::index_writer::documents_context(std::move(ctx)); } // force flush of documents()
+    writer->commit();
+  }
+
+  static docs_t expected(uint64_t min, uint64_t max) {
+    docs_t docs;
+    for (auto i = min; i <= max; ++i) {
+      docs.push_back(irs::doc_id_t(i + 1));
+    }
+    return docs;
+  }
+};
+
+NS_END
+
+TEST(by_column_range_test, ctor) {
+  irs::by_column_range q;
+  ASSERT_EQ(irs::type<irs::by_column_range>::id(), q.type());
+  ASSERT_EQ(irs::by_column_range_options{}, q.options());
+  ASSERT_EQ("", q.field());
+  ASSERT_EQ(irs::no_boost(), q.boost());
+}
+
+TEST(by_column_range_test, equal) {
+  using irs::BoundType;
+
+  ASSERT_EQ(make_filter("value", BoundType::INCLUSIVE, 1, BoundType::EXCLUSIVE, 5),
+            make_filter("value", BoundType::INCLUSIVE, 1, BoundType::EXCLUSIVE, 5));
+  ASSERT_NE(make_filter("value", BoundType::INCLUSIVE, 1, BoundType::EXCLUSIVE, 5),
+            make_filter("value", BoundType::INCLUSIVE, 1, BoundType::INCLUSIVE, 5));
+  ASSERT_NE(make_filter("value", BoundType::INCLUSIVE, 1, BoundType::EXCLUSIVE, 5),
+            make_filter("value1", BoundType::INCLUSIVE, 1, BoundType::EXCLUSIVE, 5));
+}
+
+TEST_P(column_range_filter_test_case, range) {
+  using irs::BoundType;
+
+  constexpr uint64_t COUNT = 20000;
+  add_segment(COUNT);
+  auto rdr = open_reader();
+  ASSERT_EQ(1, rdr.size());
+
+  for (irs::string_ref field : { "value", "long" }) {
+    check_query(make_filter(field, BoundType::INCLUSIVE, 100, BoundType::INCLUSIVE, 200),
+                expected(100, 200), rdr);
+    check_query(make_filter(field, BoundType::EXCLUSIVE, 100, BoundType::EXCLUSIVE, 200),
+                expected(101, 199), rdr);
+    check_query(make_filter(field, BoundType::INCLUSIVE, 12345, BoundType::INCLUSIVE, 12345),
+                expected(12345, 12345), rdr);
+    check_query(make_filter(field, BoundType::UNBOUNDED, 0, BoundType::EXCLUSIVE, 3),
+                expected(0, 2), rdr);
+    check_query(make_filter(field, BoundType::EXCLUSIVE, COUNT - 4, BoundType::UNBOUNDED, 0),
+                expected(COUNT - 3, COUNT - 1), rdr);
+    check_query(make_filter(field, BoundType::UNBOUNDED, 0, BoundType::UNBOUNDED, 0),
+                expected(0, COUNT - 1), rdr);
+
+    // empty ranges
+    check_query(make_filter(field, BoundType::INCLUSIVE, 200, BoundType::INCLUSIVE, 100),
+                docs_t{}, rdr);
+    check_query(make_filter(field, BoundType::INCLUSIVE, 200, BoundType::EXCLUSIVE, 200),
+                docs_t{}, rdr);
+    check_query(make_filter(field, BoundType::INCLUSIVE, COUNT, BoundType::UNBOUNDED, 0),
+                docs_t{}, rdr);
+  }
+
+  // missing column
+  check_query(make_filter("missing", BoundType::INCLUSIVE, 1, BoundType::INCLUSIVE, 5),
+              docs_t{}, rdr);
+}
+
+TEST_P(column_range_filter_test_case, skip_blocks) {
+  using irs::BoundType;
+
+  constexpr uint64_t COUNT = 20000;
+  add_segment(COUNT);
+  auto rdr = open_reader();
+  ASSERT_EQ(1, rdr.size());
+  auto& segment = rdr[0];
+
+  auto* column = segment.column_reader("value");
+  ASSERT_NE(nullptr, column);
+  ASSERT_EQ(COUNT, column->size());
+  const auto bounds = column->bounds();
+
+  // bounds aren't tracked for long values
+  auto* long_column = segment.column_reader("long");
+  ASSERT_NE(nullptr, long_column);
+  ASSERT_TRUE(long_column->bounds().first.null());
+  ASSERT_TRUE(long_column->bounds().second.null());
+
+  auto filter = make_filter("value", BoundType::INCLUSIVE, 100, BoundType::INCLUSIVE, 200);
+  auto prepared = filter.prepare(rdr);
+  auto it = prepared->execute(segment);
+  const auto cost = irs::cost::extract(*it);
+
+  if (bounds.first.null()) {
+    // format doesn't store value bounds, all blocks are read
+    ASSERT_TRUE(bounds.second.null());
+    ASSERT_EQ(COUNT, cost);
+  } else {
+    ASSERT_EQ(irs::bytes_ref(encode(0)), bounds.first);
+    ASSERT_EQ(irs::bytes_ref(encode(COUNT - 1)), bounds.second);
+    ASSERT_LT(cost, COUNT/10);
+  }
+
+  // column iterator restricted by bounds
+  {
+    const auto min = encode(COUNT/2);
+    auto docs = column->iterator(min, irs::bytes_ref::NIL);
+    ASSERT_NE(nullptr, docs);
+    auto* payload = irs::get<irs::payload>(*docs);
+    ASSERT_NE(nullptr, payload);
+
+    // seek lands on a document of a selected block
+    ASSERT_EQ(irs::doc_id_t(COUNT/2 + 1), docs->seek(irs::doc_id_t(COUNT/2 + 1)));
+    ASSERT_EQ(irs::bytes_ref(min), payload->value);
+    ASSERT_EQ(irs::doc_id_t(COUNT), docs->seek(irs::doc_id_t(COUNT)));
+    ASSERT_FALSE(docs->next());
+    ASSERT_TRUE(irs::doc_limits::eof(docs->value()));
+
+    if (!bounds.first.null()) {
+      // first block is skipped
+      auto docs = column->iterator(min, irs::bytes_ref::NIL);
+      auto* payload = irs::get<irs::payload>(*docs);
+      ASSERT_NE(nullptr, payload);
+      ASSERT_TRUE(docs->next());
+      ASSERT_LT(irs::doc_id_t(1), docs->value());
+      ASSERT_GE(irs::doc_id_t(COUNT/2 + 1), docs->value());
+      ASSERT_EQ(irs::doc_id_t(COUNT/2 + 1), docs->seek(irs::doc_id_t(COUNT/2 + 1)));
+      ASSERT_EQ(irs::bytes_ref(min), payload->value);
+    }
+  }
+
+  // no blocks match
+  if (!bounds.first.null()) {
+    const auto min = encode(COUNT);
+    ASSERT_FALSE(column->iterator(min, irs::bytes_ref::NIL)->next());
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(
+  column_range_filter_test,
+  column_range_filter_test_case,
+  ::testing::Combine(
+    ::testing::Values(
+      &tests::memory_directory,
+      &tests::fs_directory,
+      &tests::mmap_directory
+    ),
+    ::testing::Values(tests::format_info{"1_0"},
+                      tests::format_info{"1_4", "1_0"})
+  ),
+  tests::to_string
+);
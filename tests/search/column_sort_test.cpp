@@ -0,0 +1,208 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "filter_test_case_base.hpp"
+#include "search/all_filter.hpp"
+#include "search/boolean_filter.hpp"
+#include "search/column_sort.hpp"
+#include "search/scorers.hpp"
+#include "search/term_filter.hpp"
+#include "search/top_docs_collector.hpp"
+
+NS_LOCAL
+
+class column_sort_test_case : public tests::filter_test_case_base {
+ protected:
+  void add_sequential_segment() {
+    tests::json_doc_generator gen(
+      resource("simple_sequential.json"),
+      &tests::generic_json_field_factory);
+    add_segment(gen);
+  }
+
+  // numeric values are stored as 'zvdouble'
+  static irs::order make_order(const irs::string_ref& column, bool reverse) {
+    irs::order order;
+    order.add(reverse, irs::memory::make_unique<irs::column_sort>(
+      column, irs::column_sort::ValueType::DOUBLE));
+    return order;
+  }
+
+  static std::vector<irs::doc_id_t> top(
+      size_t limit,
+      const irs::index_reader& rdr,
+      const irs::filter& filter,
+      const irs::order::prepared& ord) {
+    auto prepared = filter.prepare(rdr, ord);
+    irs::top_docs_collector collector(limit, ord);
+    collector.collect(rdr, *prepared);
+
+    std::vector<irs::doc_id_t> docs;
+
+    for (auto& hit : collector.top()) {
+      docs.push_back(hit.doc);
+    }
+
+    return docs;
+  }
+};
+
+NS_END
+
+TEST(column_sort_test, make) {
+  {
+    auto sort = irs::scorers::get(
+      "columnsort", irs::type<irs::text_format::json>::get(),
+      "{\"column\": \"timestamp\", \"type\": \"float\"}");
+    ASSERT_NE(nullptr, sort);
+    auto& impl = dynamic_cast<irs::column_sort&>(*sort);
+    ASSERT_EQ("timestamp", impl.column());
+    ASSERT_EQ(irs::column_sort::ValueType::FLOAT, impl.value_type());
+  }
+
+  {
+    auto sort = irs::scorers::get(
+      "columnsort", irs::type<irs::text_format::json>::get(), "\"timestamp\"");
+    ASSERT_NE(nullptr, sort);
+    auto& impl = dynamic_cast<irs::column_sort&>(*sort);
+    ASSERT_EQ("timestamp", impl.column());
+    ASSERT_EQ(irs::column_sort::ValueType::LONG, impl.value_type());
+  }
+
+  // invalid arguments
+  ASSERT_EQ(nullptr, irs::scorers::get(
+    "columnsort", irs::type<irs::text_format::json>::get(), "{\"type\": \"long\"}"));
+  ASSERT_EQ(nullptr, irs::scorers::get(
+    "columnsort", irs::type<irs::text_format::json>::get(),
+    "{\"column\": \"timestamp\", \"type\": \"string\"}"));
+  ASSERT_EQ(nullptr, irs::scorers::get(
+    "columnsort", irs::type<irs::text_format::json>::get(), "[]"));
+}
+
+TEST_P(column_sort_test_case, order) {
+  add_sequential_segment();
+  auto rdr = open_reader();
+
+  // 'seq' of a document is 'doc - 1'
+  {
+    auto order = make_order("seq", true);
+    auto prepared_order = order.prepare();
+    ASSERT_EQ(sizeof(double_t), prepared_order.score_size());
+
+    const std::vector<irs::doc_id_t> expected{ 32, 31, 30, 29, 28 };
+    ASSERT_EQ(expected, top(5, rdr, irs::all(), prepared_order));
+  }
+
+  {
+    auto order = make_order("seq", false);
+    auto prepared_order = order.prepare();
+
+    const std::vector<irs::doc_id_t> expected{ 1, 2, 3 };
+    ASSERT_EQ(expected, top(3, rdr, irs::all(), prepared_order));
+  }
+
+  // values are taken as is
+  {
+    auto order = make_order("seq", true);
+    auto prepared_order = order.prepare();
+    auto prepared = irs::all().prepare(rdr, prepared_order);
+    auto docs = prepared->execute(rdr[0], prepared_order);
+    auto* score = irs::get<irs::score>(*docs);
+    ASSERT_NE(nullptr, score);
+
+    while (docs->next()) {
+      ASSERT_EQ(double_t(docs->value() - 1),
+                *reinterpret_cast<const double_t*>(score->evaluate()));
+    }
+  }
+}
+
+TEST_P(column_sort_test_case, disjunction) {
+  add_sequential_segment();
+  auto rdr = open_reader();
+
+  auto order = make_order("seq", true);
+  auto prepared_order = order.prepare();
+
+  // documents matched by multiple terms get their values, not a sum of them
+  irs::Or filter;
+  for (auto name : { "A", "C", "F" }) {
+    auto& name_filter = filter.add<irs::by_term>();
+    *name_filter.mutable_field() = "name";
+    name_filter.mutable_options()->term = irs::ref_cast<irs::byte_type>(irs::string_ref(name));
+  }
+  auto& same_filter = filter.add<irs::by_term>();
+  *same_filter.mutable_field() = "same";
+  same_filter.mutable_options()->term = irs::ref_cast<irs::byte_type>(irs::string_ref("xyz"));
+
+  auto prepared = filter.prepare(rdr, prepared_order);
+  auto docs = prepared->execute(rdr[0], prepared_order);
+  auto* score = irs::get<irs::score>(*docs);
+  ASSERT_NE(nullptr, score);
+
+  size_t count = 0;
+  while (docs->next()) {
+    ++count;
+    ASSERT_EQ(double_t(docs->value() - 1),
+              *reinterpret_cast<const double_t*>(score->evaluate()));
+  }
+  ASSERT_EQ(32, count);
+
+  const std::vector<irs::doc_id_t> expected{ 32, 31 };
+  ASSERT_EQ(expected, top(2, rdr, filter, prepared_order));
+}
+
+TEST_P(column_sort_test_case, missing_column) {
+  add_sequential_segment();
+  auto rdr = open_reader();
+
+  auto order = make_order("missing", true);
+  auto prepared_order = order.prepare();
+  auto prepared = irs::all().prepare(rdr, prepared_order);
+  auto docs = prepared->execute(rdr[0], prepared_order);
+  auto* score = irs::get<irs::score>(*docs);
+  ASSERT_NE(nullptr, score);
+
+  while (docs->next()) {
+    ASSERT_EQ(std::numeric_limits<double_t>::lowest(),
+              *reinterpret_cast<const double_t*>(score->evaluate()));
+  }
+
+  // ties are resolved by document id
+  const std::vector<irs::doc_id_t> expected{ 1, 2 };
+  ASSERT_EQ(expected, top(2, rdr, irs::all(), prepared_order));
+}
+
+INSTANTIATE_TEST_CASE_P(
+  column_sort_test,
+  column_sort_test_case,
+  ::testing::Combine(
+    ::testing::Values(
+      &tests::memory_directory,
+      &tests::fs_directory,
+      &tests::mmap_directory
+    ),
+    ::testing::Values("1_0")
+  ),
+  tests::to_string
+);
@@ -0,0 +1,255 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "filter_test_case_base.hpp"
+#include "search/boolean_filter.hpp"
+#include "search/filter_cache.hpp"
+#include "search/term_filter.hpp"
+
+#include <numeric>
+
+NS_LOCAL
+
+std::shared_ptr<irs::by_term> make_term_filter(
+    const irs::string_ref& field,
+    const irs::string_ref& term) {
+  auto filter = std::make_shared<irs::by_term>();
+  *filter->mutable_field() = field;
+  filter->mutable_options()->term = irs::ref_cast<irs::byte_type>(term);
+  return filter;
+}
+
+class filter_cache_test_case : public tests::filter_test_case_base {
+ protected:
+  void add_sequential_segment() {
+    tests::json_doc_generator gen(
+      resource("simple_sequential.json"),
+      &tests::generic_json_field_factory);
+    add_segment(gen);
+  }
+};
+
+NS_END
+
+TEST_P(filter_cache_test_case, cache_unscored) {
+  add_sequential_segment();
+  auto rdr = open_reader();
+  ASSERT_EQ(1, rdr.size());
+
+  auto cache = std::make_shared<irs::filter_cache>();
+
+  irs::cached_filter filter;
+  filter.cache(cache).filter(make_term_filter("name", "A"));
+
+  // not yet frequent
+  check_query(filter, docs_t{ 1 }, rdr);
+  auto stats = cache->metrics();
+  ASSERT_EQ(0, stats.entries);
+  ASSERT_EQ(0, stats.hits);
+  ASSERT_EQ(1, stats.misses);
+
+  // cached
+  check_query(filter, docs_t{ 1 }, rdr);
+  stats = cache->metrics();
+  ASSERT_EQ(1, stats.entries);
+  ASSERT_LT(0, stats.memory);
+  ASSERT_EQ(0, stats.hits);
+  ASSERT_EQ(2, stats.misses);
+
+  // served from cache
+  check_query(filter, docs_t{ 1 }, rdr);
+  stats = cache->metrics();
+  ASSERT_EQ(1, stats.entries);
+  ASSERT_EQ(1, stats.hits);
+  ASSERT_EQ(2, stats.misses);
+
+  // equal filter instance is served from cache
+  {
+    irs::cached_filter other;
+    other.cache(cache).filter(make_term_filter("name", "A"));
+    ASSERT_EQ(filter, other);
+    ASSERT_EQ(filter.hash(), other.hash());
+    check_query(other, docs_t{ 1 }, rdr);
+    stats = cache->metrics();
+    ASSERT_EQ(1, stats.entries);
+    ASSERT_EQ(2, stats.hits);
+  }
+
+  // different filter
+  {
+    irs::cached_filter other;
+    other.cache(cache).filter(make_term_filter("name", "B"));
+    ASSERT_NE(filter, other);
+    check_query(other, docs_t{ 2 }, rdr);
+    check_query(other, docs_t{ 2 }, rdr);
+    stats = cache->metrics();
+    ASSERT_EQ(2, stats.entries);
+    ASSERT_EQ(2, stats.hits);
+  }
+
+  // scored execution isn't cached
+  {
+    irs::order order;
+    order.add<tests::sort::custom_sort>(false);
+    check_query(filter, order, docs_t{ 1 }, rdr);
+    stats = cache->metrics();
+    ASSERT_EQ(2, stats.hits);
+  }
+
+  cache->clear();
+  stats = cache->metrics();
+  ASSERT_EQ(0, stats.entries);
+  ASSERT_EQ(0, stats.memory);
+  check_query(filter, docs_t{ 1 }, rdr);
+  ASSERT_EQ(1, cache->metrics().entries);
+}
+
+TEST_P(filter_cache_test_case, cache_boolean_subfilter) {
+  add_sequential_segment();
+  auto rdr = open_reader();
+
+  auto cache = std::make_shared<irs::filter_cache>();
+
+  irs::And root;
+  root.add<irs::cached_filter>().cache(cache).filter(make_term_filter("same", "xyz"));
+  root.add<irs::Or>().add<irs::by_term>() = *make_term_filter("name", "C");
+
+  for (size_t i = 0; i < 3; ++i) {
+    check_query(root, docs_t{ 3 }, rdr);
+  }
+
+  const auto stats = cache->metrics();
+  ASSERT_EQ(1, stats.entries);
+  ASSERT_EQ(1, stats.hits);
+}
+
+TEST_P(filter_cache_test_case, invalidate_on_reopen) {
+  add_sequential_segment();
+  auto rdr = open_reader();
+
+  irs::filter_cache::options opts;
+  opts.min_frequency = 1;
+  auto cache = std::make_shared<irs::filter_cache>(opts);
+
+  irs::cached_filter filter;
+  filter.cache(cache).filter(make_term_filter("same", "xyz"));
+
+  docs_t expected(rdr.docs_count());
+  std::iota(expected.begin(), expected.end(), irs::doc_limits::min());
+  check_query(filter, expected, rdr);
+  check_query(filter, expected, rdr);
+  ASSERT_EQ(1, cache->metrics().hits);
+
+  // remove a document, document mask of the segment changes
+  {
+    auto writer = open_writer(irs::OM_APPEND);
+    auto query = make_term_filter("name", "A");
+    writer->documents().remove(*query);
+    writer->commit();
+  }
+
+  rdr = rdr.reopen();
+  ASSERT_EQ(1, rdr.size());
+  check_query(filter, expected, rdr); // document mask is applied by the caller
+  auto stats = cache->metrics();
+  ASSERT_EQ(1, stats.hits); // reopened segment isn't served from cache
+  ASSERT_EQ(1, stats.entries); // entry of the released segment is evicted
+  ASSERT_EQ(1, stats.evictions);
+  check_query(filter, expected, rdr);
+  ASSERT_EQ(2, cache->metrics().hits);
+
+  // cached results are masked as any other iterator
+  auto prepared = filter.prepare(rdr, irs::order::prepared::unordered());
+  auto it = rdr[0].mask(prepared->execute(rdr[0]));
+  ASSERT_TRUE(it->next());
+  ASSERT_EQ(irs::doc_limits::min() + 1, it->value());
+  ASSERT_EQ(3, cache->metrics().hits);
+}
+
+TEST_P(filter_cache_test_case, memory_limit) {
+  add_sequential_segment();
+  auto rdr = open_reader();
+
+  irs::filter_cache::options opts;
+  opts.min_frequency = 1;
+  opts.max_memory = 1;
+  {
+    // no entry fits
+    auto cache = std::make_shared<irs::filter_cache>(opts);
+    irs::cached_filter filter;
+    filter.cache(cache).filter(make_term_filter("name", "A"));
+    check_query(filter, docs_t{ 1 }, rdr);
+    check_query(filter, docs_t{ 1 }, rdr);
+    const auto stats = cache->metrics();
+    ASSERT_EQ(0, stats.entries);
+    ASSERT_EQ(0, stats.memory);
+    ASSERT_EQ(0, stats.hits);
+  }
+
+  opts.max_memory = std::numeric_limits<size_t>::max();
+  size_t entry_size;
+  {
+    auto cache = std::make_shared<irs::filter_cache>(opts);
+    irs::cached_filter filter;
+    filter.cache(cache).filter(make_term_filter("name", "A"));
+    check_query(filter, docs_t{ 1 }, rdr);
+    entry_size = cache->metrics().memory;
+    ASSERT_LT(0, entry_size);
+  }
+
+  // a single entry fits
+  opts.max_memory = entry_size;
+  auto cache = std::make_shared<irs::filter_cache>(opts);
+  irs::cached_filter lhs;
+  lhs.cache(cache).filter(make_term_filter("name", "A"));
+  irs::cached_filter rhs;
+  rhs.cache(cache).filter(make_term_filter("name", "B"));
+
+  check_query(lhs, docs_t{ 1 }, rdr);
+  check_query(rhs, docs_t{ 2 }, rdr); // evicts 'lhs'
+  auto stats = cache->metrics();
+  ASSERT_EQ(1, stats.entries);
+  ASSERT_EQ(entry_size, stats.memory);
+  ASSERT_EQ(1, stats.evictions);
+
+  check_query(rhs, docs_t{ 2 }, rdr);
+  ASSERT_EQ(1, cache->metrics().hits);
+  check_query(lhs, docs_t{ 1 }, rdr); // evicts 'rhs'
+  stats = cache->metrics();
+  ASSERT_EQ(1, stats.hits);
+  ASSERT_EQ(2, stats.evictions);
+}
+
+INSTANTIATE_TEST_CASE_P(
+  filter_cache_test,
+  filter_cache_test_case,
+  ::testing::Combine(
+    ::testing::Values(
+      &tests::memory_directory,
+      &tests::fs_directory,
+      &tests::mmap_directory
+    ),
+    ::testing::Values("1_0")
+  ),
+  tests::to_string
+);
@@ -25,9 +25,12 @@
 #include "index/index_reader.hpp"
 #include "formats/formats_10.hpp"
 #include "index/index_writer.hpp"
+#include "index/segment_reader.hpp"
+#include "search/term_filter.hpp"
 #include "store/memory_directory.hpp"
 #include "index/doc_generator.hpp"
 #include "index/index_tests.hpp"
+#include "utils/async_utils.hpp"
 #include "utils/version_utils.hpp"
 #include "utils/utf8_path.hpp"
 
@@ -322,6 +325,230 @@ TEST(directory_reader_test, open) {
   ASSERT_EQ(rdr.end(), sub);
 }
 
+TEST(directory_reader_test, warmup) {
+  tests::json_doc_generator gen(
+    test_base::resource("simple_sequential.json"),
+    [] (tests::document& doc, const std::string& name, const tests::json_doc_generator::json_value& data) {
+    if (tests::json_doc_generator::ValueType::STRING == data.vt) {
+      doc.insert(std::make_shared<tests::templates::string_field>(
+        irs::string_ref(name),
+        data.str
+      ));
+    }
+  });
+
+  irs::memory_directory dir;
+  auto codec_ptr = irs::formats::get("1_0");
+  ASSERT_NE(nullptr, codec_ptr);
+
+  auto writer = irs::index_writer::make(dir, codec_ptr, irs::OM_CREATE);
+
+  // create 3 segments with 3 documents each
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      auto* doc = gen.next();
+      ASSERT_NE(nullptr, doc);
+      ASSERT_TRUE(insert(*writer,
+        doc->indexed.begin(), doc->indexed.end(),
+        doc->stored.begin(), doc->stored.end()
+      ));
+    }
+    writer->commit();
+  }
+
+  size_t calls = 0;
+  irs::warmup_stats last;
+
+  irs::warmup_options options;
+  options.files = irs::WarmupFiles::ALL;
+  options.fields = { "name", "missing" };
+  options.columns = { "name", "missing" };
+  options.done = [&calls, &last](const irs::warmup_stats& stats) {
+    ++calls;
+    last = stats;
+  };
+
+  // warmup on open
+  auto rdr = irs::directory_reader::open(dir, codec_ptr, options);
+  ASSERT_FALSE(!rdr);
+  ASSERT_EQ(3, rdr.size());
+  ASSERT_EQ(1, calls);
+  ASSERT_EQ(3, last.segments);
+  ASSERT_LT(0, last.files);
+  ASSERT_LT(0, last.bytes);
+  ASSERT_EQ(9, last.terms); // unique 'name' values
+  ASSERT_EQ(9, last.values);
+
+  // explicit warmup of term index only, no options are applied on open
+  {
+    auto plain = irs::directory_reader::open(dir, codec_ptr);
+    ASSERT_EQ(1, calls);
+
+    irs::warmup_options term_index;
+    term_index.percentage = 50;
+    auto stats = plain.warmup(term_index);
+    ASSERT_EQ(3, stats.segments);
+    ASSERT_EQ(6, stats.files); // term dictionary + term index per segment
+    ASSERT_LT(0, stats.bytes);
+    ASSERT_LT(stats.bytes, last.bytes);
+    ASSERT_EQ(0, stats.terms);
+    ASSERT_EQ(0, stats.values);
+
+    // nothing to read ahead
+    term_index.percentage = 0;
+    stats = plain.warmup(term_index);
+    ASSERT_EQ(3, stats.segments);
+    ASSERT_EQ(0, stats.files);
+    ASSERT_EQ(0, stats.bytes);
+  }
+
+  // warmup on a pool
+  {
+    irs::async_utils::thread_pool pool(2, 2);
+    std::mutex mutex;
+    std::condition_variable cond;
+    bool finished = false;
+    irs::warmup_stats async_stats;
+
+    irs::warmup_options async_options = options;
+    async_options.pool = &pool;
+    async_options.done = [&](const irs::warmup_stats& stats) {
+      std::lock_guard<std::mutex> lock(mutex);
+      async_stats = stats;
+      finished = true;
+      cond.notify_all();
+    };
+
+    auto stats = rdr.warmup(async_options);
+    ASSERT_EQ(0, stats.segments); // scheduled
+
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      ASSERT_TRUE(cond.wait_for(lock, std::chrono::seconds(30), [&finished]() { return finished; }));
+    }
+
+    ASSERT_EQ(3, async_stats.segments);
+    ASSERT_EQ(last.files, async_stats.files);
+    ASSERT_EQ(last.bytes, async_stats.bytes);
+    ASSERT_EQ(9, async_stats.terms);
+    ASSERT_EQ(9, async_stats.values);
+
+    pool.stop();
+  }
+
+  // no changes, nothing to warmup
+  rdr = rdr.reopen(codec_ptr);
+  ASSERT_EQ(1, calls);
+
+  // add segment
+  {
+    auto* doc = gen.next();
+    ASSERT_NE(nullptr, doc);
+    ASSERT_TRUE(insert(*writer,
+      doc->indexed.begin(), doc->indexed.end(),
+      doc->stored.begin(), doc->stored.end()
+    ));
+    writer->commit();
+  }
+
+  // only new segment is warmed up on reopen
+  rdr = rdr.reopen(codec_ptr);
+  ASSERT_EQ(4, rdr.size());
+  ASSERT_EQ(2, calls);
+  ASSERT_EQ(1, last.segments);
+  ASSERT_EQ(1, last.terms);
+  ASSERT_EQ(1, last.values);
+}
+
+TEST(directory_reader_test, reopen_after_removals) {
+  tests::json_doc_generator gen(
+    test_base::resource("simple_sequential.json"),
+    [] (tests::document& doc, const std::string& name, const tests::json_doc_generator::json_value& data) {
+    if (tests::json_doc_generator::ValueType::STRING == data.vt) {
+      doc.insert(std::make_shared<tests::templates::string_field>(
+        irs::string_ref(name),
+        data.str
+      ));
+    }
+  });
+
+  irs::memory_directory dir;
+  auto codec_ptr = irs::formats::get("1_0");
+  ASSERT_NE(nullptr, codec_ptr);
+
+  auto writer = irs::index_writer::make(dir, codec_ptr, irs::OM_CREATE);
+
+  // create 2 segments with 3 documents each
+  for (size_t i = 0; i < 2; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      auto* doc = gen.next();
+      ASSERT_NE(nullptr, doc);
+      ASSERT_TRUE(insert(*writer,
+        doc->indexed.begin(), doc->indexed.end(),
+        doc->stored.begin(), doc->stored.end()
+      ));
+    }
+    writer->commit();
+  }
+
+  auto rdr = irs::directory_reader::open(dir, codec_ptr);
+  ASSERT_EQ(2, rdr.size());
+  ASSERT_EQ(6, rdr.live_docs_count());
+
+  // remove document from the first segment
+  {
+    irs::by_term filter;
+    *filter.mutable_field() = "name";
+    filter.mutable_options()->term = irs::ref_cast<irs::byte_type>(irs::string_ref("B"));
+    writer->documents().remove(filter);
+    writer->commit();
+  }
+
+  auto new_rdr = rdr.reopen(codec_ptr);
+  ASSERT_NE(rdr, new_rdr);
+  ASSERT_EQ(2, new_rdr.size());
+  ASSERT_EQ(6, new_rdr.docs_count());
+  ASSERT_EQ(5, new_rdr.live_docs_count());
+
+  // segment data is shared, only document mask is reloaded
+  {
+    auto& segment = rdr[0];
+    auto& new_segment = new_rdr[0];
+    ASSERT_EQ(3, segment.live_docs_count());
+    ASSERT_EQ(2, new_segment.live_docs_count());
+    ASSERT_NE(nullptr, segment.field("name"));
+    ASSERT_EQ(segment.field("name"), new_segment.field("name"));
+    ASSERT_NE(nullptr, segment.column_reader("name"));
+    ASSERT_EQ(segment.column_reader("name"), new_segment.column_reader("name"));
+    ASSERT_EQ(segment.column("name"), new_segment.column("name"));
+
+    // old reader isn't affected by removals
+    auto docs = segment.docs_iterator();
+    size_t count = 0;
+    while (docs->next()) {
+      ++count;
+    }
+    ASSERT_EQ(3, count);
+
+    docs = new_segment.docs_iterator();
+    ASSERT_TRUE(docs->next());
+    ASSERT_EQ(irs::doc_limits::min(), docs->value());
+    ASSERT_TRUE(docs->next());
+    ASSERT_EQ(irs::doc_limits::min() + 2, docs->value());
+    ASSERT_FALSE(docs->next());
+  }
+
+  // unchanged segment is reused as is
+  ASSERT_TRUE(
+    dynamic_cast<const irs::segment_reader&>(rdr[1])
+      == dynamic_cast<const irs::segment_reader&>(new_rdr[1]));
+
+  // old reader is still usable once the new one is gone
+  new_rdr.reset();
+  ASSERT_EQ(6, rdr.live_docs_count());
+  ASSERT_NE(nullptr, rdr[0].field("name"));
+}
+
 // ----------------------------------------------------------------------------
 // --SECTION--                                                   Segment reader 
 // ----------------------------------------------------------------------------
@@ -25,7 +25,9 @@
 #include "search/levenshtein_filter.hpp"
 #include "search/prefix_filter.hpp"
 #include "search/term_filter.hpp"
+#include "utils/automaton_utils.hpp"
 #include "utils/levenshtein_default_pdp.hpp"
+#include "utils/misc.hpp"
 
 NS_LOCAL
 
@@ -388,6 +390,46 @@ TEST_P(by_edit_distance_test_case, test_filter) {
   check_query(make_filter("title", "", 5, 0, true), docs_t{}, costs_t{0}, rdr);
 }
 
+TEST_P(by_edit_distance_test_case, test_filter_automaton_cache) {
+  // add data
+  {
+    tests::json_doc_generator gen(
+      resource("levenshtein_sequential.json"),
+      &tests::generic_json_field_factory
+    );
+    add_segment(gen);
+  }
+
+  auto rdr = open_reader();
+
+  irs::automaton_cache_capacity(1 << 26);
+  auto reset_cache = irs::make_finally([]() {
+    irs::automaton_cache_capacity(0);
+  });
+
+  const auto initial = irs::get_automaton_cache_stats();
+  ASSERT_EQ(0, initial.automata);
+  ASSERT_EQ(0, initial.size);
+
+  // cached automata produce the same results
+  for (size_t i = 0; i < 3; ++i) {
+    check_query(make_filter("title", "aa", 2, 1024), docs_t{27, 28, 29, 30, 32}, costs_t{5}, rdr);
+    check_query(make_filter("title", "ababab", 1, 1024), docs_t{17}, costs_t{1}, rdr);
+    check_query(make_filter("title", "ababab", 1, 0), docs_t{17}, costs_t{1}, rdr);
+  }
+
+  const auto stats = irs::get_automaton_cache_stats();
+  ASSERT_EQ(2, stats.automata);
+  ASSERT_LT(0, stats.size);
+  ASSERT_LE(stats.size, stats.capacity);
+  ASSERT_EQ(initial.misses + 2, stats.misses);
+  ASSERT_LT(initial.hits, stats.hits);
+
+  // transpositions produce a different automaton
+  check_query(make_filter("title", "aa", 2, 1024, true), docs_t{27, 28, 29, 30, 32}, costs_t{5}, rdr);
+  ASSERT_EQ(3, irs::get_automaton_cache_stats().automata);
+}
+
 TEST_P(by_edit_distance_test_case, visit) {
   // add segment
   {
@@ -23,7 +23,9 @@
 
 #include "tests_shared.hpp"
 #include "filter_test_case_base.hpp"
+#include "analysis/delimited_token_stream.hpp"
 #include "analysis/token_attributes.hpp"
+#include "analysis/token_streams.hpp"
 #include "search/phrase_filter.hpp"
 #ifndef IRESEARCH_DLL
 #include "search/multiterm_query.hpp"
@@ -65,10 +67,120 @@ void analyzed_json_field_factory(
   }
 }
 
+void shingled_json_field_factory(
+    tests::document& doc,
+    const std::string& name,
+    const tests::json_doc_generator::json_value& data) {
+  // field tokenized by spaces, optionally indexed as bigram shingles
+  class delimited_field : public tests::field_base {
+   public:
+    delimited_field(const std::string& name, const irs::string_ref& value, bool shingles)
+      : stream_(" "), value_(value), shingles_(shingles) {
+      this->name(name);
+      features().add<irs::frequency>();
+      features().add<irs::position>();
+    }
+
+    virtual irs::token_stream& get_tokens() const override {
+      stream_.reset(value_);
+
+      if (!shingles_) {
+        return stream_;
+      }
+
+      shingle_stream_.reset(stream_);
+      return shingle_stream_;
+    }
+
+    virtual bool write(irs::data_output&) const override { return false; }
+
+   private:
+    mutable irs::analysis::delimited_token_stream stream_;
+    mutable irs::shingle_token_stream shingle_stream_;
+    std::string value_;
+    bool shingles_;
+  }; // delimited_field
+
+  if (data.is_string()) {
+    doc.indexed.push_back(std::make_shared<delimited_field>(
+      name + "_dlm", data.str, false));
+
+    doc.indexed.push_back(std::make_shared<delimited_field>(
+      name + "_dlm_shingle", data.str, true));
+  }
+}
+
 NS_END
 
 class phrase_filter_test_case : public tests::filter_test_case_base { };
 
+TEST_P(phrase_filter_test_case, sequential_shingles) {
+  // add segment
+  {
+    tests::json_doc_generator gen(
+      resource("phrase_sequential.json"),
+      &tests::shingled_json_field_factory);
+    add_segment(gen);
+  }
+
+  auto rdr = open_reader();
+
+  auto make_phrase = [](const std::string& phrase, const std::string& shingle_field) {
+    irs::by_phrase q;
+    *q.mutable_field() = "phrase_dlm";
+    q.mutable_options()->shingle_field(shingle_field);
+
+    for (size_t begin = 0, end = 0; end != std::string::npos; begin = end + 1) {
+      end = phrase.find(' ', begin);
+      const auto word = phrase.substr(begin, end == std::string::npos ? end : end - begin);
+      q.mutable_options()->push_back<irs::by_term_options>().term = irs::ref_cast<irs::byte_type>(irs::string_ref(word));
+    }
+
+    return q;
+  };
+
+  auto execute = [&rdr](const irs::filter& q) {
+    std::vector<irs::doc_id_t> docs;
+    auto prepared = q.prepare(rdr);
+
+    for (auto& segment : rdr) {
+      for (auto it = prepared->execute(segment); it->next(); ) {
+        docs.emplace_back(it->value());
+      }
+    }
+
+    return docs;
+  };
+
+  // phrases evaluated via shingles match exactly the same documents
+  for (const std::string phrase : {
+         "quick brown fox", "brown fox", "as in the past", "we do not see",
+         "jumps high jumps", "jumps left jumps right jumps down",
+         "quick brown fox moved forward", "eye to eye", "fox fox quick",
+         "quick quick", "fox", "quick brown cat", "the end" }) {
+    const auto expected = execute(make_phrase(phrase, ""));
+    const auto actual = execute(make_phrase(phrase, "phrase_dlm_shingle"));
+    ASSERT_EQ(expected, actual) << phrase;
+  }
+
+  // "quick brown fox" matches 3 documents
+  ASSERT_EQ(3, execute(make_phrase("quick brown fox", "phrase_dlm_shingle")).size());
+
+#ifndef IRESEARCH_DLL
+  // bigram is rarer than its terms, hence evaluated as a single term
+  {
+    auto prepared = make_phrase("brown fox", "phrase_dlm_shingle").prepare(rdr);
+    ASSERT_NE(nullptr, dynamic_cast<const irs::term_query*>(prepared.get()));
+  }
+
+  // no shingle field
+  {
+    auto prepared = make_phrase("brown fox", "").prepare(rdr);
+    ASSERT_EQ(nullptr, dynamic_cast<const irs::term_query*>(prepared.get()));
+  }
+#endif
+}
+
 TEST_P(phrase_filter_test_case, sequential_one_term) {
   // add segment
   {
@@ -7388,6 +7500,23 @@ TEST(by_phrase_test, options) {
   ASSERT_EQ(opts.begin(), opts.end());
 }
 
+TEST(by_phrase_test, options_shingle_field) {
+  irs::by_phrase_options opts;
+  ASSERT_TRUE(opts.shingle_field().empty());
+
+  irs::by_phrase_options shingled_opts;
+  shingled_opts.shingle_field("field_shingle");
+  ASSERT_EQ("field_shingle", shingled_opts.shingle_field());
+  ASSERT_FALSE(opts == shingled_opts);
+  ASSERT_NE(opts.hash(), shingled_opts.hash());
+
+  // phrase is cleared, shingle field is kept
+  shingled_opts.push_back<irs::by_term_options>();
+  shingled_opts.clear();
+  ASSERT_TRUE(shingled_opts.empty());
+  ASSERT_EQ("field_shingle", shingled_opts.shingle_field());
+}
+
 TEST(by_phrase_test, options_clear) {
   irs::by_phrase_options opts;
   ASSERT_TRUE(opts.simple());
@@ -0,0 +1,313 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "filter_test_case_base.hpp"
+#include "analysis/delimited_token_stream.hpp"
+#include "analysis/token_attributes.hpp"
+#include "search/proximity_filter.hpp"
+
+NS_LOCAL
+
+using words_t = std::vector<std::string>;
+
+// field tokenized by spaces
+class delimited_field : public tests::field_base {
+ public:
+  delimited_field(const std::string& name, const irs::string_ref& value)
+    : stream_(" "), value_(value) {
+    this->name(name);
+    features().add<irs::frequency>();
+    features().add<irs::position>();
+  }
+
+  virtual irs::token_stream& get_tokens() const override {
+    stream_.reset(value_);
+    return stream_;
+  }
+
+  virtual bool write(irs::data_output&) const override { return false; }
+
+ private:
+  mutable irs::analysis::delimited_token_stream stream_;
+  std::string value_;
+}; // delimited_field
+
+words_t split(const std::string& str) {
+  words_t words;
+
+  for (size_t begin = 0, end = 0; end != std::string::npos; begin = end + 1) {
+    end = str.find(' ', begin);
+    words.emplace_back(str.substr(begin, end == std::string::npos ? end : end - begin));
+  }
+
+  return words;
+}
+
+// returns number of windows of at most 'max_distance' positions containing
+// all 'terms', each window is counted along with its leftmost position
+uint32_t count_windows(const words_t& doc, words_t terms, size_t max_distance) {
+  std::sort(terms.begin(), terms.end());
+  uint32_t count = 0;
+
+  for (size_t begin = 0; begin < doc.size(); ++begin) {
+    if (terms.end() == std::find(terms.begin(), terms.end(), doc[begin])) {
+      continue;
+    }
+
+    // the nearest distinct occurrences of every term
+    size_t last = begin;
+    bool match = true;
+
+    for (size_t i = 0, pos = begin; match && i < terms.size(); ++i) {
+      pos = (i && terms[i - 1] == terms[i]) ? pos + 1 : begin;
+      while (pos < doc.size() && doc[pos] != terms[i]) {
+        ++pos;
+      }
+      match = pos < doc.size();
+      last = std::max(last, pos);
+    }
+
+    if (match && last - begin <= max_distance) {
+      ++count;
+    }
+  }
+
+  return count;
+}
+
+NS_END
+
+class proximity_filter_test_case : public tests::filter_test_case_base {
+ protected:
+  void add_docs() {
+    tests::json_doc_generator gen(
+      resource("phrase_sequential.json"),
+      [this](tests::document& doc,
+             const std::string& name,
+             const tests::json_doc_generator::json_value& data) {
+        if (data.is_string() && name == "phrase") {
+          docs_.emplace_back(split(data.str));
+          doc.indexed.push_back(std::make_shared<delimited_field>(name, data.str));
+        }
+    });
+    add_segment(gen);
+  }
+
+  static irs::by_proximity make_filter(const words_t& terms, uint32_t max_distance) {
+    irs::by_proximity q;
+    *q.mutable_field() = "phrase";
+    q.mutable_options()->max_distance = max_distance;
+
+    for (auto& term : terms) {
+      q.mutable_options()->terms.emplace_back(
+        irs::ref_cast<irs::byte_type>(irs::string_ref(term)));
+    }
+
+    return q;
+  }
+
+  std::vector<words_t> docs_;
+};
+
+TEST_P(proximity_filter_test_case, windows) {
+  add_docs();
+
+  auto rdr = open_reader();
+  ASSERT_EQ(1, rdr.size());
+  auto& segment = rdr[0];
+  ASSERT_EQ(docs_.size(), segment.docs_count());
+
+  irs::order ord;
+  ord.add<tests::sort::frequency_sort>(false);
+  auto pord = ord.prepare();
+
+  for (const auto& terms : std::vector<words_t>{
+         { "quick", "fox" }, { "fox", "quick" }, { "brown", "fox", "quick" },
+         { "jumps", "high" }, { "jumps", "jumps" }, { "jumps", "jumps", "high" },
+         { "fox", "fox" }, { "fox", "fox", "quick", "quick" }, { "quick", "quick", "quick" },
+         { "we", "are", "forward" }, { "eye", "eye", "see" }, { "the", "end" },
+         { "quick", "missing" }, { "walks", "jumps", "down" } }) {
+    for (uint32_t max_distance : { 0, 1, 2, 3, 5, 100 }) {
+      auto q = make_filter(terms, max_distance);
+      auto prepared = q.prepare(rdr, pord);
+      auto prepared_unordered = q.prepare(rdr);
+
+      std::vector<std::pair<irs::doc_id_t, uint32_t>> expected;
+      for (size_t i = 0; i < docs_.size(); ++i) {
+        const auto count = count_windows(docs_[i], terms, max_distance);
+        if (count) {
+          expected.emplace_back(irs::doc_id_t(irs::doc_limits::min() + i), count);
+        }
+      }
+
+      // next
+      {
+        std::vector<std::pair<irs::doc_id_t, uint32_t>> actual;
+        auto docs = prepared->execute(segment, pord);
+        auto* freq = irs::get<irs::frequency>(*docs);
+
+        while (docs->next()) {
+          ASSERT_TRUE(freq);
+          actual.emplace_back(docs->value(), freq->value);
+        }
+        ASSERT_TRUE(irs::doc_limits::eof(docs->value()));
+        ASSERT_EQ(expected, actual) << max_distance;
+      }
+
+      // next, no order
+      {
+        std::vector<std::pair<irs::doc_id_t, uint32_t>> actual;
+        auto docs = prepared_unordered->execute(segment);
+        ASSERT_FALSE(irs::get<irs::frequency>(*docs));
+
+        while (docs->next()) {
+          actual.emplace_back(docs->value(), expected.size() > actual.size()
+                                               ? expected[actual.size()].second
+                                               : 0);
+        }
+        ASSERT_EQ(expected, actual) << max_distance;
+      }
+
+      // seek
+      for (auto& doc : expected) {
+        auto docs = prepared->execute(segment, pord);
+        auto* freq = irs::get<irs::frequency>(*docs);
+        ASSERT_TRUE(freq);
+        ASSERT_EQ(doc.first, docs->seek(doc.first));
+        ASSERT_EQ(doc.second, freq->value);
+      }
+    }
+  }
+
+  // terms in any order
+  {
+    auto prepared = make_filter({ "fox", "brown", "quick" }, 2).prepare(rdr);
+    auto docs = prepared->execute(segment);
+    std::vector<irs::doc_id_t> actual;
+    while (docs->next()) {
+      actual.emplace_back(docs->value());
+    }
+
+    // A, G, I, L
+    std::vector<irs::doc_id_t> expected{ 1, 7, 9, 11 };
+    ASSERT_EQ(expected, actual);
+  }
+
+  // repeated term occurs at distinct positions only
+  {
+    auto prepared = make_filter({ "fox", "fox" }, 5).prepare(rdr);
+    auto docs = prepared->execute(segment);
+    ASSERT_TRUE(docs->next());
+    ASSERT_EQ(13, docs->value()); // N
+    ASSERT_FALSE(docs->next());
+  }
+
+  // single term
+  {
+    auto prepared = make_filter({ "fox" }, 0).prepare(rdr);
+    auto docs = prepared->execute(segment);
+    size_t count = 0;
+    while (docs->next()) {
+      ++count;
+    }
+    ASSERT_EQ(9, count);
+  }
+}
+
+TEST(by_proximity_test, options) {
+  irs::by_proximity_options opts;
+  ASSERT_TRUE(opts.terms.empty());
+  ASSERT_EQ(0, opts.max_distance);
+}
+
+TEST(by_proximity_test, ctor) {
+  irs::by_proximity q;
+  ASSERT_EQ(irs::type<irs::by_proximity>::id(), q.type());
+  ASSERT_EQ("", q.field());
+  ASSERT_EQ(irs::by_proximity_options{}, q.options());
+  ASSERT_EQ(irs::no_boost(), q.boost());
+
+  auto& features = irs::by_proximity::required();
+  ASSERT_EQ(2, features.size());
+  ASSERT_TRUE(features.check<irs::frequency>());
+  ASSERT_TRUE(features.check<irs::position>());
+}
+
+TEST(by_proximity_test, equal) {
+  irs::by_proximity q0;
+  *q0.mutable_field() = "field";
+  q0.mutable_options()->terms.emplace_back(irs::ref_cast<irs::byte_type>(irs::string_ref("quick")));
+  q0.mutable_options()->terms.emplace_back(irs::ref_cast<irs::byte_type>(irs::string_ref("fox")));
+  q0.mutable_options()->max_distance = 3;
+
+  irs::by_proximity q1 = q0;
+  ASSERT_EQ(q0, q1);
+  ASSERT_EQ(q0.hash(), q1.hash());
+
+  q1.mutable_options()->max_distance = 2;
+  ASSERT_NE(q0, q1);
+
+  irs::by_proximity q2 = q0;
+  q2.mutable_options()->terms.pop_back();
+  ASSERT_NE(q0, q2);
+}
+
+TEST(by_proximity_test, boost) {
+  // no terms
+  {
+    irs::by_proximity q;
+    *q.mutable_field() = "field";
+
+    auto prepared = q.prepare(irs::sub_reader::empty());
+    ASSERT_EQ(irs::no_boost(), prepared->boost());
+  }
+
+  // with boost
+  {
+    irs::boost_t boost = 1.5f;
+
+    irs::by_proximity q;
+    *q.mutable_field() = "field";
+    q.mutable_options()->terms.emplace_back(irs::ref_cast<irs::byte_type>(irs::string_ref("quick")));
+    q.mutable_options()->terms.emplace_back(irs::ref_cast<irs::byte_type>(irs::string_ref("fox")));
+    q.boost(boost);
+
+    auto prepared = q.prepare(irs::sub_reader::empty());
+    ASSERT_EQ(boost, prepared->boost());
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(
+  proximity_filter_test,
+  proximity_filter_test_case,
+  ::testing::Combine(
+    ::testing::Values(
+      &tests::memory_directory,
+      &tests::fs_directory,
+      &tests::mmap_directory
+    ),
+    ::testing::Values(tests::format_info{"1_0"},
+                      tests::format_info{"1_3", "1_0"})
+  ),
+  tests::to_string
+);
@@ -0,0 +1,260 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "filter_test_case_base.hpp"
+#include "search/all_filter.hpp"
+#include "search/search_executor.hpp"
+#include "search/term_filter.hpp"
+
+NS_LOCAL
+
+class search_executor_test_case : public tests::filter_test_case_base {
+ protected:
+  static constexpr size_t SEGMENTS = 4;
+  static constexpr size_t SEGMENT_DOCS = 32;
+
+  void add_sequential_segments() {
+    for (size_t i = 0; i < SEGMENTS; ++i) {
+      tests::json_doc_generator gen(
+        resource("simple_sequential.json"),
+        &tests::generic_json_field_factory);
+      add_segment(gen, i ? irs::OM_APPEND : irs::OM_CREATE);
+    }
+  }
+
+  // score of a document is 'doc % 7', higher is better
+  static irs::order make_order() {
+    irs::order order;
+    auto& sort = order.add<tests::sort::custom_sort>(false);
+    sort.scorer_score = [](irs::doc_id_t& score) { score %= 7; };
+    sort.scorer_less = [](const irs::doc_id_t& lhs, const irs::doc_id_t& rhs) {
+      return lhs > rhs;
+    };
+    return order;
+  }
+
+  // @returns expected top 'limit' hits as (segment, doc) pairs
+  static std::vector<std::pair<size_t, irs::doc_id_t>> expected_hits(
+      size_t limit,
+      irs::doc_id_t removed = irs::doc_limits::invalid()) {
+    std::vector<std::tuple<irs::doc_id_t, size_t, irs::doc_id_t>> all;
+
+    for (size_t segment = 0; segment < SEGMENTS; ++segment) {
+      for (irs::doc_id_t doc = 1; doc <= SEGMENT_DOCS; ++doc) {
+        if (doc != removed) {
+          all.emplace_back(doc % 7, segment, doc);
+        }
+      }
+    }
+
+    std::sort(all.begin(), all.end(), [](const auto& lhs, const auto& rhs) {
+      if (std::get<0>(lhs) != std::get<0>(rhs)) {
+        return std::get<0>(lhs) > std::get<0>(rhs);
+      }
+
+      return std::make_pair(std::get<1>(lhs), std::get<2>(lhs))
+        < std::make_pair(std::get<1>(rhs), std::get<2>(rhs));
+    });
+
+    std::vector<std::pair<size_t, irs::doc_id_t>> expected;
+
+    for (size_t i = 0; i < std::min(limit, all.size()); ++i) {
+      expected.emplace_back(std::get<1>(all[i]), std::get<2>(all[i]));
+    }
+
+    return expected;
+  }
+
+  static std::vector<std::pair<size_t, irs::doc_id_t>> to_pairs(
+      const std::vector<irs::search_executor::hit>& hits) {
+    std::vector<std::pair<size_t, irs::doc_id_t>> result;
+
+    for (auto& hit : hits) {
+      result.emplace_back(hit.segment, hit.doc);
+    }
+
+    return result;
+  }
+};
+
+NS_END
+
+TEST_P(search_executor_test_case, unscored) {
+  add_sequential_segments();
+  auto rdr = open_reader();
+  ASSERT_EQ(SEGMENTS, rdr.size());
+
+  irs::async_utils::thread_pool pool(4, 4);
+  irs::search_executor executor(&pool);
+
+  auto prepared = irs::all().prepare(rdr);
+  ASSERT_NE(nullptr, prepared);
+
+  // empty limit
+  ASSERT_TRUE(executor.execute(rdr, *prepared, irs::order::prepared::unordered(), 0).empty());
+
+  // first documents in index order
+  {
+    auto hits = executor.execute(rdr, *prepared, irs::order::prepared::unordered(), 40);
+    ASSERT_EQ(40, hits.size());
+
+    for (size_t i = 0; i < hits.size(); ++i) {
+      ASSERT_TRUE(hits[i].score.empty());
+      ASSERT_EQ(i / SEGMENT_DOCS, hits[i].segment);
+      ASSERT_EQ(irs::doc_id_t(1 + i % SEGMENT_DOCS), hits[i].doc);
+    }
+  }
+
+  // all documents
+  {
+    auto hits = executor.execute(rdr, *prepared, irs::order::prepared::unordered(), 1000);
+    ASSERT_EQ(SEGMENTS*SEGMENT_DOCS, hits.size());
+  }
+}
+
+TEST_P(search_executor_test_case, scored) {
+  add_sequential_segments();
+  auto rdr = open_reader();
+
+  auto order = make_order();
+  auto prepared_order = order.prepare();
+  auto prepared = irs::all().prepare(rdr, prepared_order);
+  ASSERT_NE(nullptr, prepared);
+
+  irs::async_utils::thread_pool pool(4, 4);
+  const irs::search_executor concurrent(&pool);
+  const irs::search_executor sequential;
+
+  for (size_t limit : { 1, 5, 10, 37, 128, 1000 }) {
+    const auto expected = expected_hits(limit);
+    const auto concurrent_hits = concurrent.execute(rdr, *prepared, prepared_order, limit);
+    const auto sequential_hits = sequential.execute(rdr, *prepared, prepared_order, limit);
+
+    ASSERT_EQ(expected, to_pairs(concurrent_hits));
+    ASSERT_EQ(expected, to_pairs(sequential_hits));
+
+    for (auto& hit : concurrent_hits) {
+      ASSERT_EQ(prepared_order.score_size(), hit.score.size());
+      ASSERT_EQ(hit.doc % 7, *reinterpret_cast<const irs::doc_id_t*>(hit.score.c_str()));
+    }
+  }
+}
+
+TEST_P(search_executor_test_case, skip_removed) {
+  add_sequential_segments();
+
+  // remove document 'F' (id 6, i.e. one of the best scored) from all segments
+  {
+    auto writer = open_writer(irs::OM_APPEND);
+    auto query = std::make_shared<irs::by_term>();
+    *query->mutable_field() = "name";
+    query->mutable_options()->term = irs::ref_cast<irs::byte_type>(irs::string_ref("F"));
+    writer->documents().remove(std::move(query));
+    writer->commit();
+  }
+
+  auto rdr = open_reader();
+  ASSERT_EQ(SEGMENTS, rdr.size());
+
+  auto order = make_order();
+  auto prepared_order = order.prepare();
+  auto prepared = irs::all().prepare(rdr, prepared_order);
+
+  irs::async_utils::thread_pool pool(2, 2);
+  irs::search_executor executor(&pool);
+
+  ASSERT_EQ(expected_hits(10, 6),
+            to_pairs(executor.execute(rdr, *prepared, prepared_order, 10)));
+}
+
+TEST_P(search_executor_test_case, execute_from_pool_task) {
+  add_sequential_segments();
+  auto rdr = open_reader();
+
+  auto order = make_order();
+  auto prepared_order = order.prepare();
+  auto prepared = irs::all().prepare(rdr, prepared_order);
+
+  // the only thread of the pool executes the query itself
+  irs::async_utils::thread_pool pool(1, 1);
+  irs::search_executor executor(&pool);
+
+  std::mutex mutex;
+  std::condition_variable cond;
+  std::vector<irs::search_executor::hit> hits;
+  bool done = false;
+
+  ASSERT_TRUE(pool.run([&]() {
+    auto result = executor.execute(rdr, *prepared, prepared_order, 10);
+    std::lock_guard<std::mutex> lock(mutex);
+    hits = std::move(result);
+    done = true;
+    cond.notify_all();
+  }));
+
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    ASSERT_TRUE(cond.wait_for(lock, std::chrono::seconds(30), [&done]() { return done; }));
+  }
+
+  ASSERT_EQ(expected_hits(10), to_pairs(hits));
+  pool.stop();
+}
+
+TEST_P(search_executor_test_case, error) {
+  add_sequential_segments();
+  auto rdr = open_reader();
+
+  irs::order order;
+  auto& sort = order.add<tests::sort::custom_sort>(false);
+  sort.scorer_score = [](irs::doc_id_t& score) {
+    if (score == 17) {
+      throw std::runtime_error("scorer failure");
+    }
+  };
+  sort.scorer_less = [](const irs::doc_id_t& lhs, const irs::doc_id_t& rhs) {
+    return lhs < rhs;
+  };
+
+  auto prepared_order = order.prepare();
+  auto prepared = irs::all().prepare(rdr, prepared_order);
+
+  irs::async_utils::thread_pool pool(4, 4);
+  irs::search_executor executor(&pool);
+
+  ASSERT_THROW(executor.execute(rdr, *prepared, prepared_order, 10), std::runtime_error);
+}
+
+INSTANTIATE_TEST_CASE_P(
+  search_executor_test,
+  search_executor_test_case,
+  ::testing::Combine(
+    ::testing::Values(
+      &tests::memory_directory,
+      &tests::fs_directory,
+      &tests::mmap_directory
+    ),
+    ::testing::Values("1_0")
+  ),
+  tests::to_string
+);
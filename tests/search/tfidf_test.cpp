@@ -1281,6 +1281,95 @@ TEST_P(tfidf_test, test_order) {
   }
 }
 
+TEST_P(tfidf_test, test_block_scorer) {
+  // term 'a' occurs 1..13 times, term 'b' 0..4 times, every 11th document
+  // doesn't contain 'a', documents span multiple posting blocks
+  {
+    static const irs::flags norm_features{ irs::type<irs::norm>::get() };
+    templates::string_field a("field", "a", norm_features);
+    templates::string_field b("field", "b", norm_features);
+
+    auto writer = open_writer(irs::OM_CREATE);
+
+    for (size_t i = 0; i < 300; ++i) {
+      auto ctx = writer->documents();
+      auto doc = ctx.insert();
+
+      for (size_t j = 0, count = i % 11 ? 1 + (i*7) % 13 : 0; j < count; ++j) {
+        ASSERT_TRUE(doc.insert<irs::Action::INDEX>(a));
+      }
+
+      for (size_t j = 0, count = i % 5; j < count; ++j) {
+        ASSERT_TRUE(doc.insert<irs::Action::INDEX>(b));
+      }
+    }
+
+    writer->commit();
+  }
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  ASSERT_EQ(1, reader.size());
+  auto& segment = reader[0];
+
+  // 2 buckets, with and without norms
+  irs::order order;
+  order.add(true, irs::scorers::get("tfidf", irs::type<irs::text_format::json>::get(), "{\"withNorms\": false}"));
+  order.add(true, irs::scorers::get("tfidf", irs::type<irs::text_format::json>::get(), "{\"withNorms\": true}"));
+  auto prepared_order = order.prepare();
+  const size_t score_size = prepared_order.score_size();
+
+  irs::by_term filter;
+  *filter.mutable_field() = "field";
+  filter.mutable_options()->term = irs::ref_cast<irs::byte_type>(irs::string_ref("a"));
+
+  auto prepared = filter.prepare(reader, prepared_order, 2.f);
+  ASSERT_NE(nullptr, prepared);
+
+  // per-document scores
+  std::vector<std::pair<irs::doc_id_t, irs::bstring>> expected;
+  {
+    auto docs = prepared->execute(segment, prepared_order);
+    auto* score = irs::get<irs::score>(*docs);
+    ASSERT_NE(nullptr, score);
+
+    while (docs->next()) {
+      expected.emplace_back(docs->value(), irs::bstring(score->evaluate(), score_size));
+    }
+  }
+  ASSERT_EQ(272, expected.size());
+
+  // block scores, scored in chunks of various sizes
+  for (size_t chunk : { 1, 3, 64, 129, 1000 }) {
+    auto docs = prepared->execute(segment, prepared_order);
+    auto* block = irs::get<irs::score_block>(*docs);
+    ASSERT_NE(nullptr, block);
+    ASSERT_FALSE(block->empty());
+    auto* freq = irs::get<irs::frequency>(*docs);
+    ASSERT_NE(nullptr, freq);
+
+    std::vector<irs::doc_id_t> ids;
+    std::vector<uint32_t> freqs;
+
+    while (docs->next()) {
+      ids.push_back(docs->value());
+      freqs.push_back(freq->value);
+    }
+    ASSERT_EQ(expected.size(), ids.size());
+
+    irs::bstring scores(ids.size()*score_size, 0);
+
+    for (size_t i = 0; i < ids.size(); i += chunk) {
+      block->evaluate(ids.data() + i, freqs.data() + i,
+                      std::min(chunk, ids.size() - i), &scores[i*score_size]);
+    }
+
+    for (size_t i = 0; i < ids.size(); ++i) {
+      ASSERT_EQ(expected[i].first, ids[i]);
+      ASSERT_EQ(expected[i].second, scores.substr(i*score_size, score_size));
+    }
+  }
+}
+
 INSTANTIATE_TEST_CASE_P(
   tfidf_test,
   tfidf_test,
@@ -0,0 +1,325 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "filter_test_case_base.hpp"
+#include "search/all_filter.hpp"
+#include "search/top_docs_collector.hpp"
+
+NS_LOCAL
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief produces all documents of a segment scored by their ids and records
+///        the threshold observed on each step
+////////////////////////////////////////////////////////////////////////////////
+class threshold_iterator final : public irs::doc_iterator {
+ public:
+  threshold_iterator(irs::doc_id_t max, std::vector<irs::doc_id_t>& thresholds)
+    : max_(max), thresholds_(&thresholds) {
+    score_.reset(
+      reinterpret_cast<irs::score_ctx*>(this),
+      [](irs::score_ctx* ctx) -> const irs::byte_type* {
+        auto& self = *reinterpret_cast<threshold_iterator*>(ctx);
+        self.value_ = self.doc_.value;
+        return reinterpret_cast<const irs::byte_type*>(&self.value_);
+    });
+  }
+
+  virtual irs::attribute* get_mutable(irs::type_info::type_id type) noexcept override {
+    if (irs::type<irs::document>::id() == type) {
+      return &doc_;
+    }
+
+    if (irs::type<irs::score>::id() == type) {
+      return &score_;
+    }
+
+    return irs::type<irs::score_threshold>::id() == type ? &threshold_ : nullptr;
+  }
+
+  virtual bool next() override {
+    thresholds_->push_back(threshold_.empty()
+      ? irs::doc_limits::invalid()
+      : *reinterpret_cast<const irs::doc_id_t*>(threshold_.value.c_str()));
+
+    if (doc_.value >= max_) {
+      doc_.value = irs::doc_limits::eof();
+      return false;
+    }
+
+    ++doc_.value;
+    return true;
+  }
+
+  virtual irs::doc_id_t seek(irs::doc_id_t target) override {
+    irs::seek(*this, target);
+    return value();
+  }
+
+  virtual irs::doc_id_t value() const override {
+    return doc_.value;
+  }
+
+ private:
+  irs::document doc_;
+  irs::score score_;
+  irs::score_threshold threshold_;
+  irs::doc_id_t max_;
+  irs::doc_id_t value_;
+  std::vector<irs::doc_id_t>* thresholds_;
+}; // threshold_iterator
+
+class threshold_query final : public irs::filter::prepared {
+ public:
+  explicit threshold_query(std::vector<irs::doc_id_t>& thresholds)
+    : thresholds_(&thresholds) {
+  }
+
+  using irs::filter::prepared::execute;
+
+  virtual irs::doc_iterator::ptr execute(
+      const irs::sub_reader& rdr,
+      const irs::order::prepared&,
+      const irs::attribute_provider*) const override {
+    return irs::memory::make_managed<threshold_iterator>(
+      irs::doc_id_t(rdr.docs_count()), *thresholds_);
+  }
+
+ private:
+  std::vector<irs::doc_id_t>* thresholds_;
+}; // threshold_query
+
+class top_docs_collector_test_case : public tests::filter_test_case_base {
+ protected:
+  void add_sequential_segments(size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+      tests::json_doc_generator gen(
+        resource("simple_sequential.json"),
+        &tests::generic_json_field_factory);
+      add_segment(gen, i ? irs::OM_APPEND : irs::OM_CREATE);
+    }
+  }
+
+  // score of a document is 'doc % 7', higher is better
+  static irs::order make_order() {
+    irs::order order;
+    auto& sort = order.add<tests::sort::custom_sort>(false);
+    sort.scorer_score = [](irs::doc_id_t& score) { score %= 7; };
+    sort.scorer_less = [](const irs::doc_id_t& lhs, const irs::doc_id_t& rhs) {
+      return lhs > rhs;
+    };
+    return order;
+  }
+
+  static std::vector<std::pair<size_t, irs::doc_id_t>> to_pairs(
+      const std::vector<irs::top_docs_collector::hit>& hits) {
+    std::vector<std::pair<size_t, irs::doc_id_t>> result;
+
+    for (auto& hit : hits) {
+      result.emplace_back(hit.segment, hit.doc);
+    }
+
+    return result;
+  }
+};
+
+NS_END
+
+TEST_P(top_docs_collector_test_case, by_score) {
+  add_sequential_segments(3);
+  auto rdr = open_reader();
+  ASSERT_EQ(3, rdr.size());
+
+  auto order = make_order();
+  auto prepared_order = order.prepare();
+  auto prepared = irs::all().prepare(rdr, prepared_order);
+
+  irs::top_docs_collector collector(5, prepared_order);
+  ASSERT_EQ(5, collector.limit());
+  ASSERT_TRUE(collector.threshold().null());
+  collector.collect(rdr, *prepared);
+  ASSERT_EQ(96, collector.visited());
+  ASSERT_TRUE(collector.full());
+
+  // documents 6, 13, 20, 27 of each segment have the best score
+  const std::vector<std::pair<size_t, irs::doc_id_t>> expected{
+    { 0, 6 }, { 0, 13 }, { 0, 20 }, { 0, 27 }, { 1, 6 }
+  };
+
+  const auto hits = collector.top();
+  ASSERT_EQ(expected, to_pairs(hits));
+
+  for (auto& hit : hits) {
+    ASSERT_EQ(sizeof(irs::doc_id_t), hit.key.size());
+    ASSERT_EQ(6, *reinterpret_cast<const irs::doc_id_t*>(hit.key.c_str()));
+  }
+
+  ASSERT_EQ(hits.back().key, collector.threshold());
+
+  // collected once again, ties are resolved by segment and document
+  collector.collect(rdr[2], 2, *prepared);
+  ASSERT_EQ(expected, to_pairs(collector.top()));
+
+  collector.reset();
+  ASSERT_EQ(0, collector.size());
+  ASSERT_EQ(0, collector.visited());
+  collector.collect(rdr[2], 2, *prepared);
+  ASSERT_EQ(4, collector.top().front().key.size());
+  ASSERT_EQ((std::pair<size_t, irs::doc_id_t>(2, 6)), to_pairs(collector.top()).front());
+}
+
+TEST_P(top_docs_collector_test_case, unscored) {
+  add_sequential_segments(3);
+  auto rdr = open_reader();
+
+  auto prepared = irs::all().prepare(rdr);
+
+  irs::top_docs_collector collector(5, irs::order::prepared::unordered());
+  collector.collect(rdr, *prepared);
+
+  // collection of each segment stops as soon as a document can't be collected
+  ASSERT_EQ(5 + 1 + 1 + 1, collector.visited());
+
+  const std::vector<std::pair<size_t, irs::doc_id_t>> expected{
+    { 0, 1 }, { 0, 2 }, { 0, 3 }, { 0, 4 }, { 0, 5 }
+  };
+  const auto hits = collector.top();
+  ASSERT_EQ(expected, to_pairs(hits));
+
+  for (auto& hit : hits) {
+    ASSERT_TRUE(hit.key.empty());
+  }
+
+  // nothing is collected
+  irs::top_docs_collector empty(0, irs::order::prepared::unordered());
+  empty.collect(rdr, *prepared);
+  ASSERT_EQ(0, empty.visited());
+  ASSERT_TRUE(empty.top().empty());
+}
+
+TEST_P(top_docs_collector_test_case, threshold) {
+  add_sequential_segments(1);
+  auto rdr = open_reader();
+
+  irs::order order;
+  auto& sort = order.add<tests::sort::custom_sort>(false);
+  sort.scorer_less = [](const irs::doc_id_t& lhs, const irs::doc_id_t& rhs) {
+    return lhs > rhs;
+  };
+  auto prepared_order = order.prepare();
+
+  std::vector<irs::doc_id_t> thresholds;
+  threshold_query query(thresholds);
+
+  irs::top_docs_collector collector(3, prepared_order);
+  collector.collect(rdr, query);
+
+  // threshold is the 3rd best collected document once collector is full
+  ASSERT_EQ(33, thresholds.size());
+  for (irs::doc_id_t i = 0; i < 3; ++i) {
+    ASSERT_FALSE(irs::doc_limits::valid(thresholds[i]));
+  }
+  for (irs::doc_id_t i = 3; i < thresholds.size(); ++i) {
+    ASSERT_EQ(i - 2, thresholds[i]);
+  }
+
+  const std::vector<std::pair<size_t, irs::doc_id_t>> expected{
+    { 0, 32 }, { 0, 31 }, { 0, 30 }
+  };
+  ASSERT_EQ(expected, to_pairs(collector.top()));
+  ASSERT_EQ(30, *reinterpret_cast<const irs::doc_id_t*>(collector.threshold().c_str()));
+
+  // threshold is available to the iterator right away
+  thresholds.clear();
+  collector.collect(rdr[0], 1, query);
+  ASSERT_EQ(30, thresholds.front());
+
+  const std::vector<std::pair<size_t, irs::doc_id_t>> expected_merged{
+    { 0, 32 }, { 1, 32 }, { 0, 31 }
+  };
+  ASSERT_EQ(expected_merged, to_pairs(collector.top()));
+}
+
+TEST_P(top_docs_collector_test_case, by_column) {
+  add_sequential_segments(2);
+  auto rdr = open_reader();
+
+  auto prepared = irs::all().prepare(rdr);
+
+  // values are length-prefixed single characters
+  auto value = [](char c) {
+    return irs::bstring{ irs::byte_type(1), irs::byte_type(c) };
+  };
+
+  {
+    irs::top_docs_collector collector(3, "name");
+    collector.collect(rdr, *prepared);
+    ASSERT_EQ(64, collector.visited());
+
+    const std::vector<std::pair<size_t, irs::doc_id_t>> expected{
+      { 0, 28 }, { 1, 28 }, { 0, 30 } // '!', '!', '#'
+    };
+    const auto hits = collector.top();
+    ASSERT_EQ(expected, to_pairs(hits));
+    ASSERT_EQ(value('!'), hits[0].key);
+    ASSERT_EQ(value('!'), hits[1].key);
+    ASSERT_EQ(value('#'), hits[2].key);
+    ASSERT_EQ(value('#'), collector.threshold());
+  }
+
+  {
+    irs::top_docs_collector collector(3, "name", true);
+    collector.collect(rdr, *prepared);
+
+    const std::vector<std::pair<size_t, irs::doc_id_t>> expected{
+      { 0, 27 }, { 1, 27 }, { 0, 26 } // '~', '~', 'Z'
+    };
+    ASSERT_EQ(expected, to_pairs(collector.top()));
+  }
+
+  // missing column, all documents have an empty value
+  {
+    irs::top_docs_collector collector(2, "missing");
+    collector.collect(rdr, *prepared);
+
+    const std::vector<std::pair<size_t, irs::doc_id_t>> expected{
+      { 0, 1 }, { 0, 2 }
+    };
+    const auto hits = collector.top();
+    ASSERT_EQ(expected, to_pairs(hits));
+    ASSERT_TRUE(hits[0].key.empty());
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(
+  top_docs_collector_test,
+  top_docs_collector_test_case,
+  ::testing::Combine(
+    ::testing::Values(
+      &tests::memory_directory,
+      &tests::fs_directory,
+      &tests::mmap_directory
+    ),
+    ::testing::Values("1_0")
+  ),
+  tests::to_string
+);
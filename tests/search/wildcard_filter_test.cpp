@@ -43,12 +43,55 @@ Filter make_filter(
   return q;
 }
 
+irs::by_wildcard make_filter(
+    const irs::string_ref& field,
+    const irs::string_ref term,
+    const irs::string_ref& suffix_field) {
+  auto q = make_filter(field, term);
+  q.mutable_options()->suffix_field = suffix_field;
+  return q;
+}
+
+class suffix_field : public tests::field_base {
+ public:
+  suffix_field(const irs::string_ref& name, const std::string& value)
+    : value_(value) {
+    this->name(name);
+  }
+
+  irs::token_stream& get_tokens() const override {
+    stream_.reset(value_);
+    return stream_;
+  }
+
+  bool write(irs::data_output&) const override {
+    return false;
+  }
+
+ private:
+  mutable irs::suffix_token_stream stream_;
+  std::string value_;
+}; // suffix_field
+
+// indexes every string value along with its suffixes in '<name>_suffix'
+void suffix_json_field_factory(
+    tests::document& doc,
+    const std::string& name,
+    const tests::json_doc_generator::json_value& data) {
+  if (tests::json_doc_generator::ValueType::STRING == data.vt) {
+    doc.indexed.push_back(std::make_shared<suffix_field>(name + "_suffix", data.str));
+  }
+
+  tests::generic_json_field_factory(doc, name, data);
+}
+
 NS_END
 
 TEST(by_wildcard_test, options) {
   irs::by_wildcard_options opts;
   ASSERT_TRUE(opts.term.empty());
   ASSERT_EQ(1024, opts.scored_terms_limit);
+  ASSERT_TRUE(opts.suffix_field.empty());
 }
 
 TEST(by_wildcard_test, ctor) {
@@ -69,6 +112,8 @@ TEST(by_wildcard_test, equal) {
   irs::by_wildcard q1 = make_filter("field", "bar*");
   q1.mutable_options()->scored_terms_limit = 100;
   ASSERT_NE(q, q1);
+
+  ASSERT_NE(q, make_filter("field", "bar*", "field_suffix"));
 }
 
 TEST(by_wildcard_test, boost) {
@@ -157,6 +202,27 @@ TEST(by_wildcard_test, test_type_of_prepared_query) {
     auto rhs = make_filter("foo", "\\%").prepare(irs::sub_reader::empty());
     ASSERT_EQ(typeid(*lhs), typeid(*rhs));
   }
+
+  // term query over suffixes
+  {
+    auto lhs = make_filter<irs::by_term>("foo_suffix", ".log").prepare(irs::sub_reader::empty());
+    auto rhs = make_filter("foo", "%.log", "foo_suffix").prepare(irs::sub_reader::empty());
+    ASSERT_EQ(typeid(*lhs), typeid(*rhs));
+  }
+
+  // prefix query over suffixes
+  {
+    auto lhs = make_filter<irs::by_prefix>("foo_suffix", "bar").prepare(irs::sub_reader::empty());
+    auto rhs = make_filter("foo", "%%bar%", "foo_suffix").prepare(irs::sub_reader::empty());
+    ASSERT_EQ(typeid(*lhs), typeid(*rhs));
+  }
+
+  // all query, suffixes aren't used
+  {
+    auto lhs = make_filter<irs::by_prefix>("foo", "").prepare(irs::sub_reader::empty());
+    auto rhs = make_filter("foo", "%", "foo_suffix").prepare(irs::sub_reader::empty());
+    ASSERT_EQ(typeid(*lhs), typeid(*rhs));
+  }
 }
 
 #endif
@@ -417,6 +483,50 @@ TEST_P(wildcard_filter_test_case, simple_sequential) {
   check_query(make_filter("prefix", "bateradsfsfasdf"), docs_t{24}, costs_t{1}, rdr);
 }
 
+TEST_P(wildcard_filter_test_case, suffix_field) {
+  // add segment
+  {
+    tests::json_doc_generator gen(
+      resource("simple_sequential.json"),
+      &suffix_json_field_factory);
+    add_segment(gen);
+  }
+
+  auto rdr = open_reader();
+  ASSERT_EQ(1, rdr.size());
+  auto& segment = rdr[0];
+
+  auto execute = [&segment](const irs::filter& filter) {
+    std::vector<irs::doc_id_t> docs;
+    auto prepared = filter.prepare(segment);
+    auto it = prepared->execute(segment);
+    while (it->next()) {
+      docs.emplace_back(it->value());
+    }
+    return docs;
+  };
+
+  // patterns evaluated against suffixes match the same documents
+  for (auto& pattern : { "%c", "%de", "%bc%", "%%cd%", "%c%e", "%c_e",
+                         "%d\\%", "%rer", "%xyz%", "%", "%_c", "_bc%" }) {
+    SCOPED_TRACE(pattern);
+    const auto expected = execute(make_filter("prefix", pattern));
+    ASSERT_EQ(expected, execute(make_filter("prefix", pattern, "prefix_suffix")));
+  }
+
+  {
+    docs_t result{1, 4, 9, 21, 26, 31, 32};
+    costs_t costs{result.size()};
+    check_query(make_filter("prefix", "%bc%", "prefix_suffix"), result, costs, rdr);
+  }
+
+  {
+    docs_t result{4};
+    costs_t costs{result.size()};
+    check_query(make_filter("prefix", "%cde", "prefix_suffix"), result, costs, rdr);
+  }
+}
+
 TEST_P(wildcard_filter_test_case, visit) {
   // add segment
   {
@@ -1107,6 +1107,37 @@ TEST_P(directory_test_case, directory_size) {
   }
 }
 
+TEST_P(directory_test_case, prefetch) {
+  constexpr uint32_t COUNT = 100000;
+
+  {
+    auto out = dir_->create("test");
+    ASSERT_FALSE(!out);
+
+    for (uint32_t i = 0; i < COUNT; ++i) {
+      out->write_int(i);
+    }
+  }
+
+  auto in = dir_->open("test", irs::IOAdvice::NORMAL);
+  ASSERT_FALSE(!in);
+  const auto length = in->length();
+  ASSERT_EQ(COUNT*sizeof(uint32_t), length);
+
+  // prefetching is a hint and doesn't change a state of the input
+  in->seek(sizeof(uint32_t));
+  in->prefetch(0, length);
+  in->prefetch(length/2 + 1, length); // past the end
+  in->prefetch(length, 1);
+  in->prefetch(3, 0);
+  ASSERT_EQ(sizeof(uint32_t), in->file_pointer());
+
+  for (uint32_t i = 1; i < COUNT; ++i) {
+    ASSERT_EQ(i, in->read_int());
+  }
+  ASSERT_TRUE(in->eof());
+}
+
 INSTANTIATE_TEST_CASE_P(
   directory_test,
   directory_test_case,
@@ -1314,6 +1345,70 @@ TEST_F(fs_directory_test, orphaned_lock) {
   }
 }
 
+TEST_F(fs_directory_test, read_concurrently) {
+  constexpr uint32_t COUNT = 100000;
+
+  {
+    auto out = dir_->create("test");
+    ASSERT_FALSE(!out);
+
+    for (uint32_t i = 0; i < COUNT; ++i) {
+      out->write_int(i);
+    }
+  }
+
+  auto in = dir_->open("test", irs::IOAdvice::RANDOM);
+  ASSERT_FALSE(!in);
+  ASSERT_EQ(COUNT*sizeof(uint32_t), in->length());
+
+  // inputs reading at different positions don't affect each other
+  {
+    auto in0 = in->dup();
+    auto in1 = in->reopen();
+    ASSERT_FALSE(!in0);
+    ASSERT_FALSE(!in1);
+    in1->seek((COUNT - 1)*sizeof(uint32_t));
+    ASSERT_EQ(COUNT - 1, in1->read_int());
+    ASSERT_EQ(0, in0->read_int());
+    in1->seek(sizeof(uint32_t));
+    ASSERT_EQ(1, in1->read_int());
+    ASSERT_EQ(1, in0->read_int());
+    ASSERT_EQ(in0->checksum(in0->length()), in1->dup()->checksum(in0->length()));
+  }
+
+  // duplicates of a single input are read concurrently
+  std::vector<std::thread> pool;
+  std::vector<int> results(8, 0);
+
+  for (size_t i = 0; i < results.size(); ++i) {
+    pool.emplace_back([&in, &result = results[i], i]() {
+      auto input = in->dup();
+
+      // each thread reads the file starting at its own offset
+      for (uint32_t j = 0; j < COUNT; ++j) {
+        const uint32_t value = uint32_t(j + i*(COUNT/8)) % COUNT;
+
+        if (0 == j || 0 == value) {
+          input->seek(value*sizeof(uint32_t));
+        }
+
+        if (value != input->read_int()) {
+          return;
+        }
+      }
+
+      result = 1;
+    });
+  }
+
+  for (auto& thread : pool) {
+    thread.join();
+  }
+
+  ASSERT_TRUE(std::all_of(
+    results.begin(), results.end(), [](int res) { return 1 == res; }));
+}
+
 TEST_F(fs_directory_test, utf8_chars) {
   std::wstring path_ucs2 = L"\u0442\u0435\u0441\u0442\u043E\u0432\u0430\u044F_\u0434\u0438\u0440\u0435\u043A\u0442\u043E\u0440\u0438\u044F";
   irs::utf8_path path(path_ucs2);
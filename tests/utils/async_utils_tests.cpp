@@ -644,3 +644,55 @@ TEST_F(async_utils_tests, test_thread_pool_stop_mt) {
     ASSERT_EQ(0, pool.threads());
   }
 }
+
+TEST_F(async_utils_tests, test_rate_limiter) {
+  typedef std::chrono::steady_clock clock_t;
+
+  // unlimited
+  {
+    irs::async_utils::rate_limiter limiter;
+    ASSERT_EQ(0, limiter.bytes_per_sec());
+    limiter.acquire(1 << 30);
+    limiter.acquire(1 << 30);
+    ASSERT_EQ(uint64_t(2) << 30, limiter.bytes());
+    ASSERT_EQ(std::chrono::microseconds(0), limiter.throttled());
+  }
+
+  // limited
+  {
+    irs::async_utils::rate_limiter limiter(1000);
+    ASSERT_EQ(1000, limiter.bytes_per_sec());
+    auto start = clock_t::now();
+    limiter.acquire(100); // first chunk isn't delayed
+    limiter.acquire(100);
+    limiter.acquire(100);
+    ASSERT_LE(std::chrono::milliseconds(200), clock_t::now() - start);
+    ASSERT_LE(std::chrono::milliseconds(190), limiter.throttled());
+    ASSERT_EQ(300, limiter.bytes());
+
+    // turn off the limit
+    limiter.bytes_per_sec(0);
+    start = clock_t::now();
+    limiter.acquire(1 << 30);
+    ASSERT_GT(std::chrono::milliseconds(100), clock_t::now() - start);
+  }
+
+  // limited, concurrent callers
+  {
+    irs::async_utils::rate_limiter limiter(10000);
+    irs::async_utils::thread_pool pool(4, 4);
+    const auto start = clock_t::now();
+
+    for (size_t i = 0; i < 4; ++i) {
+      ASSERT_TRUE(pool.run([&limiter]()->void {
+        for (size_t j = 0; j < 5; ++j) {
+          limiter.acquire(100);
+        }
+      }));
+    }
+
+    pool.stop();
+    ASSERT_EQ(2000, limiter.bytes());
+    ASSERT_LE(std::chrono::milliseconds(190), clock_t::now() - start);
+  }
+}
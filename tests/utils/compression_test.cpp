@@ -24,6 +24,11 @@
 #include "store/store_utils.hpp"
 #include "utils/lz4compression.hpp"
 #include "utils/delta_compression.hpp"
+#include "utils/misc.hpp"
+
+#ifdef USE_ZSTD
+#include "utils/zstd_compression.hpp"
+#endif
 
 #include <numeric>
 #include <random>
@@ -48,6 +53,29 @@ struct dummy_decompressor final : irs::compression::decompressor {
   virtual bool prepare(data_input&) { return true; }
 };
 
+#ifdef USE_ZSTD
+
+// generates JSON-like documents sharing the same structure
+irs::bstring make_documents(std::mt19937& engine, size_t size) {
+  static const char* NAMES[] { "alpha", "beta", "gamma", "delta", "epsilon" };
+  std::uniform_int_distribution<size_t> dist { 0, 1000000 };
+
+  std::string docs;
+  while (docs.size() < size) {
+    const auto value = dist(engine);
+    docs += "{\"id\":" + std::to_string(value)
+         +  ",\"name\":\"" + NAMES[value % IRESEARCH_COUNTOF(NAMES)]
+         +  "\",\"active\":" + (value % 2 ? "true" : "false")
+         +  ",\"tags\":[\"search\",\"index\"],\"score\":" + std::to_string(value % 100)
+         +  "}";
+  }
+  docs.resize(size);
+
+  return irs::bstring(reinterpret_cast<const irs::byte_type*>(docs.c_str()), docs.size());
+}
+
+#endif
+
 NS_END
 
 TEST(compression_test, registration) {
@@ -198,3 +226,124 @@ TEST(compression_test, delta) {
     );
   }
 }
+
+#ifdef USE_ZSTD
+
+TEST(compression_test, zstd) {
+  using namespace iresearch;
+
+  ASSERT_TRUE(compression::exists(type<compression::zstd>::get().name()));
+  ASSERT_TRUE(compression::exists(type<compression::zstd_dict>::get().name()));
+
+  std::mt19937 engine;
+  compression::zstd::zstd_compressor compressor(3);
+  ASSERT_EQ(3, compressor.level());
+
+  // no dictionary is written
+  bstring header;
+  {
+    bytes_output out(header);
+    compressor.flush(out);
+  }
+  ASSERT_TRUE(compressor.dictionary().empty());
+
+  auto decompressor = compression::get_decompressor(type<compression::zstd>::get());
+  ASSERT_NE(nullptr, decompressor);
+  {
+    bytes_ref_input in(header);
+    ASSERT_TRUE(decompressor->prepare(in));
+  }
+
+  for (size_t i = 0; i < 10; ++i) {
+    const auto data = make_documents(engine, 8192);
+    bstring data_buf = data;
+
+    bstring compression_buf;
+    const auto compressed = compressor.compress(&data_buf[0], data_buf.size(), compression_buf);
+    ASSERT_EQ(compressed, bytes_ref(compression_buf.c_str(), compressed.size()));
+    ASSERT_LT(compressed.size(), data.size());
+
+    bstring decompression_buf(data.size(), 0); // ensure we have enough space in buffer
+    const auto decompressed = decompressor->decompress(&compression_buf[0], compressed.size(),
+                                                       &decompression_buf[0], decompression_buf.size());
+    ASSERT_EQ(data, decompressed);
+  }
+
+  // corrupted data
+  {
+    const bstring garbage(64, 0xFF);
+    bstring decompression_buf(1024, 0);
+    ASSERT_TRUE(decompressor->decompress(garbage.c_str(), garbage.size(),
+                                         &decompression_buf[0], decompression_buf.size()).null());
+  }
+}
+
+TEST(compression_test, zstd_dict) {
+  using namespace iresearch;
+
+  constexpr size_t BLOCK_SIZE = 4096;
+
+  std::mt19937 engine;
+  auto compressor = compression::get_compressor(type<compression::zstd_dict>::get(), {});
+  ASSERT_NE(nullptr, compressor);
+  compression::zstd::zstd_compressor plain(3);
+
+  // first block is used for training
+  std::vector<bstring> blocks;
+  blocks.emplace_back(make_documents(engine, 4*BLOCK_SIZE));
+  for (size_t i = 0; i < 10; ++i) {
+    blocks.emplace_back(make_documents(engine, BLOCK_SIZE));
+  }
+
+  size_t dict_size = 0;
+  size_t plain_size = 0;
+  std::vector<bstring> compressed;
+  for (auto& block : blocks) {
+    bstring data = block;
+    bstring buf;
+    compressed.emplace_back(compressor->compress(&data[0], data.size(), buf));
+
+    if (&block != &blocks.front()) {
+      data = block;
+      dict_size += compressed.back().size();
+      plain_size += plain.compress(&data[0], data.size(), buf).size();
+    }
+  }
+
+  // dictionary pays off for small blocks
+  ASSERT_LT(dict_size, plain_size);
+
+  bstring header;
+  {
+    bytes_output out(header);
+    compressor->flush(out);
+  }
+  ASSERT_LT(1, header.size());
+
+  // blocks can't be decompressed without a dictionary
+  auto decompressor = compression::get_decompressor(type<compression::zstd_dict>::get());
+  ASSERT_NE(nullptr, decompressor);
+  {
+    bstring buf(blocks.back().size(), 0);
+    ASSERT_TRUE(decompressor->decompress(compressed.back().c_str(), compressed.back().size(),
+                                         &buf[0], buf.size()).null());
+  }
+
+  // decompressors of different columns don't share dictionaries
+  auto another_decompressor = compression::get_decompressor(type<compression::zstd_dict>::get());
+  ASSERT_NE(decompressor, another_decompressor);
+
+  {
+    bytes_ref_input in(header);
+    ASSERT_TRUE(decompressor->prepare(in));
+  }
+
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    bstring buf(blocks[i].size(), 0);
+    const auto decompressed = decompressor->decompress(compressed[i].c_str(), compressed[i].size(),
+                                                       &buf[0], buf.size());
+    ASSERT_EQ(blocks[i], decompressed);
+  }
+}
+
+#endif // USE_ZSTD
@@ -105,6 +105,10 @@ TEST(fst_table_matcher_test, test_matcher) {
     ASSERT_EQ(fst::fsa::BooleanWeight(false), matcher.Final(1));
     ASSERT_EQ(0, matcher.Priority(0));
     ASSERT_EQ(1, matcher.Priority(1));
+    ASSERT_EQ(fst::kNoStateId, matcher.Transition(0, 42));
+    ASSERT_EQ(0, matcher.Transition(1, 42));
+    ASSERT_EQ(fst::kNoStateId, matcher.Transition(1, 43));
+    ASSERT_EQ(fst::kNoStateId, matcher.Transition(1, 1024)); // non-cached label
     ASSERT_EQ(&a, &matcher.GetFst());
     ASSERT_EQ(fst::MATCH_INPUT, matcher.Type(false));
     ASSERT_EQ(fst::MATCH_INPUT, matcher.Type(true));
@@ -168,6 +172,10 @@ TEST(fst_table_matcher_test, test_matcher) {
     ASSERT_EQ(fst::fsa::BooleanWeight(false), matcher.Final(1));
     ASSERT_EQ(0, matcher.Priority(0));
     ASSERT_EQ(2, matcher.Priority(1));
+    ASSERT_EQ(fst::kNoStateId, matcher.Transition(0, 42));
+    ASSERT_EQ(0, matcher.Transition(1, 42));
+    ASSERT_EQ(0, matcher.Transition(1, 43)); // rho transition
+    ASSERT_EQ(0, matcher.Transition(1, 1024)); // rho transition, non-cached label
     ASSERT_EQ(&a, &matcher.GetFst());
     ASSERT_EQ(fst::MATCH_INPUT, matcher.Type(false));
     ASSERT_EQ(fst::MATCH_INPUT, matcher.Type(true));
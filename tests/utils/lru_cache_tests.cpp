@@ -0,0 +1,168 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "utils/lru_cache.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(sharded_lru_cache_test, disabled) {
+  irs::sharded_lru_cache<int, std::string> cache;
+  ASSERT_EQ(0, cache.capacity());
+
+  ASSERT_FALSE(cache.put(1, "1", 1));
+
+  std::string value;
+  ASSERT_FALSE(cache.get(1, value));
+
+  const auto stats = cache.get_stats();
+  ASSERT_EQ(0, stats.capacity);
+  ASSERT_EQ(0, stats.charge);
+  ASSERT_EQ(0, stats.count);
+  ASSERT_EQ(0, stats.hits);
+  ASSERT_EQ(1, stats.misses);
+}
+
+TEST(sharded_lru_cache_test, put_get) {
+  irs::sharded_lru_cache<int, std::string> cache(10, 1);
+  ASSERT_EQ(10, cache.capacity());
+
+  ASSERT_TRUE(cache.put(1, "1", 3));
+  ASSERT_TRUE(cache.put(2, "2", 3));
+  ASSERT_FALSE(cache.put(3, "3", 11)); // exceeds capacity
+
+  std::string value;
+  ASSERT_TRUE(cache.get(1, value));
+  ASSERT_EQ("1", value);
+  ASSERT_TRUE(cache.get(2, value));
+  ASSERT_EQ("2", value);
+  ASSERT_FALSE(cache.get(3, value));
+
+  // replace existing entry
+  ASSERT_TRUE(cache.put(1, "11", 4));
+  ASSERT_TRUE(cache.get(1, value));
+  ASSERT_EQ("11", value);
+
+  const auto stats = cache.get_stats();
+  ASSERT_EQ(10, stats.capacity);
+  ASSERT_EQ(7, stats.charge);
+  ASSERT_EQ(2, stats.count);
+  ASSERT_EQ(3, stats.hits);
+  ASSERT_EQ(1, stats.misses);
+}
+
+TEST(sharded_lru_cache_test, evict) {
+  irs::sharded_lru_cache<int, std::string> cache(10, 1);
+
+  ASSERT_TRUE(cache.put(1, "1", 4));
+  ASSERT_TRUE(cache.put(2, "2", 4));
+
+  std::string value;
+  ASSERT_TRUE(cache.get(1, value)); // 1 is the most recently used now
+
+  ASSERT_TRUE(cache.put(3, "3", 4)); // evicts 2
+  ASSERT_TRUE(cache.get(1, value));
+  ASSERT_EQ("1", value);
+  ASSERT_FALSE(cache.get(2, value));
+  ASSERT_TRUE(cache.get(3, value));
+  ASSERT_EQ("3", value);
+
+  {
+    const auto stats = cache.get_stats();
+    ASSERT_EQ(8, stats.charge);
+    ASSERT_EQ(2, stats.count);
+  }
+
+  // shrink cache, evicts 1
+  cache.capacity(5);
+  ASSERT_EQ(5, cache.capacity());
+  ASSERT_FALSE(cache.get(1, value));
+  ASSERT_TRUE(cache.get(3, value));
+
+  {
+    const auto stats = cache.get_stats();
+    ASSERT_EQ(4, stats.charge);
+    ASSERT_EQ(1, stats.count);
+  }
+
+  // disable cache
+  cache.capacity(0);
+  ASSERT_FALSE(cache.get(3, value));
+
+  {
+    const auto stats = cache.get_stats();
+    ASSERT_EQ(0, stats.charge);
+    ASSERT_EQ(0, stats.count);
+  }
+}
+
+TEST(sharded_lru_cache_test, clear) {
+  irs::sharded_lru_cache<int, int> cache(100, 4);
+
+  for (int i = 0; i < 20; ++i) {
+    ASSERT_TRUE(cache.put(i, i, 1));
+  }
+
+  ASSERT_EQ(20, cache.get_stats().count);
+  ASSERT_EQ(20, cache.get_stats().charge);
+
+  cache.clear();
+
+  const auto stats = cache.get_stats();
+  ASSERT_EQ(0, stats.count);
+  ASSERT_EQ(0, stats.charge);
+  ASSERT_EQ(100, stats.capacity);
+
+  int value;
+  ASSERT_FALSE(cache.get(0, value));
+}
+
+TEST(sharded_lru_cache_test, concurrent_access) {
+  constexpr size_t THREADS = 8;
+  constexpr int KEYS = 1000;
+  irs::sharded_lru_cache<int, int> cache(KEYS/2);
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < THREADS; ++i) {
+    threads.emplace_back([&cache]() {
+      for (int key = 0; key < KEYS; ++key) {
+        int value;
+        if (cache.get(key, value)) {
+          EXPECT_EQ(key, value);
+        } else {
+          cache.put(key, key, 1);
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const auto stats = cache.get_stats();
+  ASSERT_LE(stats.charge, stats.capacity);
+  ASSERT_EQ(stats.charge, stats.count);
+  ASSERT_EQ(THREADS*KEYS, stats.hits + stats.misses);
+}
@@ -58,6 +58,7 @@
 #include "search/prefix_filter.hpp"
 #include "search/score.hpp"
 #include "search/term_filter.hpp"
+#include "search/top_docs_collector.hpp"
 #include "search/wildcard_filter.hpp"
 #include "search/ngram_similarity_filter.hpp"
 #include "store/fs_directory.hpp"
@@ -582,8 +583,7 @@ int search(
       const timers_t building_timers("building");
       const timers_t execution_timers("execution");
 
-      std::vector<std::pair<float_t, irs::doc_id_t>> sorted;
-      sorted.reserve(limit);
+      irs::top_docs_collector sorted(limit, order);
 
       // process a single task
       for (const task_t* task; (task = task_provider.pop()) != nullptr;) {
@@ -592,10 +592,9 @@ int search(
         std::this_thread::sleep_for(
             std::chrono::milliseconds(
                 static_cast<unsigned>(100. * (static_cast<double>(rand()) / static_cast<double>(RAND_MAX)))));
-        size_t doc_count = 0;
         const auto start = std::chrono::system_clock::now();
 
-        sorted.clear();
+        sorted.reset();
 
         // parse task
         {
@@ -611,59 +610,11 @@ int search(
         {
           irs::timer_utils::scoped_timer timer(*(execution_timers.stat[size_t(task->category)]));
 
-          for (auto& segment: reader) {
-            auto docs = filter->execute(segment, order); // query segment
-            const irs::score* score = irs::get<irs::score>(*docs);
-            assert(score);
-            const irs::document* doc = irs::get<irs::document>(*docs);
-            assert(doc);
-
-            while (docs->next()) {
-              ++doc_count;
-              const float_t score_value = *reinterpret_cast<const float_t*>(score->evaluate());
-
-              if (sorted.size() < limit) {
-                sorted.emplace_back(score_value, doc->value);
-
-                std::push_heap(
-                  sorted.begin(), sorted.end(),
-                  [](const std::pair<float_t, irs::doc_id_t>& lhs,
-                     const std::pair<float_t, irs::doc_id_t>& rhs) noexcept {
-                    return lhs.first < rhs.first;
-                });
-              } else if (sorted.front().first < score_value) {
-                std::pop_heap(
-                  sorted.begin(), sorted.end(),
-                  [](const std::pair<float_t, irs::doc_id_t>& lhs,
-                     const std::pair<float_t, irs::doc_id_t>& rhs) noexcept {
-                    return lhs.first < rhs.first;
-                });
-
-                auto& back = sorted.back();
-                back.first = score_value;
-                back.second = doc->value;
-
-                std::push_heap(
-                  sorted.begin(), sorted.end(),
-                  [](const std::pair<float_t, irs::doc_id_t>& lhs,
-                     const std::pair<float_t, irs::doc_id_t>& rhs) noexcept {
-                    return lhs.first < rhs.first;
-                });
-              }
-            }
-          }
-
-          auto end = sorted.end();
-          for (auto begin = sorted.begin(); begin != end; --end) {
-            std::pop_heap(
-              begin, end,
-              [](const std::pair<float_t, irs::doc_id_t>& lhs,
-                 const std::pair<float_t, irs::doc_id_t>& rhs) noexcept {
-                return lhs.first < rhs.first;
-            });
-          }
+          sorted.collect(reader, *filter);
         }
 
+        const size_t doc_count = sorted.visited();
+
         const auto tdiff = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - start);
 
         // output task results
@@ -676,8 +627,9 @@ int search(
                 << "  " << tdiff.count() / 1000. << " msec\n"
                 << "  thread " << std::this_thread::get_id() << '\n';
 
-            for (auto& entry : sorted) {
-              ss << "  doc=" << entry.second << " score=" << entry.first << '\n';
+            for (auto& entry : sorted.top()) {
+              ss << "  doc=" << entry.doc
+                 << " score=" << *reinterpret_cast<const float_t*>(entry.key.c_str()) << '\n';
             }
 
             ss << '\n';